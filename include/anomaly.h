@@ -0,0 +1,44 @@
+#ifndef __ANOMALY__
+#define __ANOMALY__
+#include <Arduino.h>
+
+#define ANOMALY_WINDOW          32      // so mau dua vao model
+#define ANOMALY_CHANNELS        2       // nhiet do, do am
+#define ANOMALY_KERNEL          5
+#define ANOMALY_FEATURES        8
+#define ANOMALY_POOL_TAIL       4       // chi xet 4 buoc moi nhat -> score phan anh mau vua do
+#define ANOMALY_MIN_SAMPLES     (ANOMALY_KERNEL + ANOMALY_POOL_TAIL - 1)
+#define ANOMALY_THRESHOLD       64      // score 0..127
+#define ANOMALY_TEMP_LSB_CENTI  5       // input int8: 0.05 °C / LSB
+#define ANOMALY_HUMI_LSB_CENTI  25      // 0.25 %RH / LSB
+#define ANOMALY_ARENA_BYTES     512     // input + activation, cap phat tinh
+
+// Lich su dang centi, de duoc trong RTC_DATA_ATTR cho duty cycle
+typedef struct {
+    int16_t  temp[ANOMALY_WINDOW];
+    int16_t  humi[ANOMALY_WINDOW];
+    uint8_t  head;
+    uint8_t  count;
+    uint8_t  lastScore;
+    uint8_t  maxScore;      // tu lan anomaly_format_json thanh cong gan nhat
+    uint16_t runs;
+    uint16_t flagged;
+} anomaly_state_t;
+
+void anomaly_init(anomaly_state_t *s);
+// Them mau (centi, nhu sensor_sample_t) va chay model. Tra ve score 0..127,
+// 0 khi chua du ANOMALY_MIN_SAMPLES.
+uint8_t anomaly_feed(anomaly_state_t *s, int16_t temp_centi, int16_t humi_centi);
+
+// Phan tinh toan thuan tuy (nguyen, bit-exact):
+// lich su centi -> input int8 [ANOMALY_WINDOW][ANOMALY_CHANNELS] quanh trung binh cua so
+void anomaly_quantize(const anomaly_state_t *s, int8_t *input);
+// input int8 -> score (conv1d + relu -> maxpool -> dense)
+int8_t anomaly_infer(const int8_t *input);
+
+// {"anomaly_score":..,"anomaly_max":..,"anomaly_count":..}, reset max/dem khi thanh cong
+size_t anomaly_format_json(anomaly_state_t *s, char *out, size_t cap);
+// Dang ky lenh "ai" (score + benchmark)
+void anomaly_begin();
+
+#endif
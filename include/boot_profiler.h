@@ -0,0 +1,19 @@
+#ifndef __BOOT_PROFILER__
+#define __BOOT_PROFILER__
+#include <Arduino.h>
+
+#define BOOT_MAX_PHASES 12
+
+// Ket thuc phase `name` tai thoi diem hien tai (thoi luong = tu mark truoc).
+// `name` phai la chuoi hang (chi luu con tro).
+void boot_profiler_mark(const char *name);
+
+// Thuc day bang timer (deep sleep) -> bo qua init mang tinh trang tri
+bool boot_is_fast_wake();
+
+uint32_t boot_profiler_total_us();
+void boot_profiler_print();
+// {"boot_us":..,"boot_fast":0|1,"boot_<phase>":<us>,...}
+size_t boot_profiler_format_json(char *out, size_t cap);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef __CONFIG_STORE__
+#define __CONFIG_STORE__
+#include <Arduino.h>
+
+#define CONFIG_MAGIC            0x31474643UL    // "CFG1"
+#define CONFIG_VERSION          1
+#define CONFIG_SSID_LEN         33
+#define CONFIG_PASS_LEN         65
+#define CONFIG_TOKEN_LEN        65
+#define CONFIG_SERVER_LEN       65
+#define CONFIG_DEFAULT_SERVER   "app.coreiot.io"
+#define CONFIG_DEFAULT_PORT     1883
+
+// Layout co dinh tren flash. Doi layout -> tang CONFIG_VERSION.
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t length;            // sizeof(config_record_t)
+    uint32_t generation;        // slot co generation lon nhat (va CRC dung) thang
+    char     wifi_ssid[CONFIG_SSID_LEN];
+    char     wifi_pass[CONFIG_PASS_LEN];
+    char     iot_token[CONFIG_TOKEN_LEN];
+    char     iot_server[CONFIG_SERVER_LEN];
+    uint16_t iot_port;
+    uint32_t crc;               // CRC32 cua moi byte phia truoc
+} config_record_t;
+
+// Backend luu 2 slot. Mac dinh la 2 file tren LittleFS; host test co the
+// thay bang file thuong de gia lap mat dien giua luc ghi.
+typedef struct {
+    bool (*read)(uint8_t slot, void *buf, size_t len);
+    bool (*write)(uint8_t slot, const void *buf, size_t len);
+} config_backend_t;
+
+// Mount storage va nap slot hop le moi nhat (hoac mac dinh)
+bool config_store_begin(const config_backend_t *backend = NULL);
+
+// Getter khong cap phat heap. Con tro tro vao ban RAM dang active: con dung qua 1 lan
+// config_store_update, lan update thu 2 ghi de chinh ban do. Can giu lau hon (vd MQTT
+// setServer chi luu con tro) thi copy ra buffer rieng.
+const char *config_wifi_ssid();
+const char *config_wifi_pass();
+const char *config_iot_token();
+const char *config_iot_server();
+uint16_t    config_iot_port();
+uint32_t    config_generation();
+
+// Ghi vao slot cu hon roi moi doi ban trong RAM -> ap dung ngay, khong reboot
+bool config_store_update(const config_record_t *rec);
+
+// Xu ly message tu trang web: {"page":"setting","value":{ssid,password,token,server,port}}
+// Truong rong/thieu giu nguyen gia tri cu. Tra ve true neu da luu.
+// Console: `cfg set <key> <value>` va `cfg json <msg>` di qua day.
+bool config_apply_json(const char *json, size_t len);
+
+uint32_t config_crc32(const void *data, size_t len);
+
+#endif
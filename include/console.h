@@ -0,0 +1,38 @@
+#ifndef __CONSOLE_H__
+#define __CONSOLE_H__
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define CONSOLE_LINE_MAX        192     // du cho message JSON cua trang web (relay json), < 256
+#define CONSOLE_MAX_ARGS        6
+#define CONSOLE_MAX_COMMANDS    24
+#define CONSOLE_PROMPT          ">>> "
+#define CONSOLE_NOTIFY_BIT      (1UL << 31)     // bit notification khi co byte RX
+
+// argv[0] la ten lenh; cac token tro thang vao line buffer (khong copy)
+typedef void (*console_handler_t)(int argc, char *argv[]);
+
+typedef struct {
+    const char        *name;    // so sanh khong phan biet hoa/thuong
+    const char        *usage;   // vd "L <sec>"
+    const char        *help;
+    console_handler_t  handler;
+} console_cmd_t;
+
+// cmd phai ton tai suot chuong trinh (static const), registry chi giu con tro
+bool console_register(const console_cmd_t *cmd);
+
+// Gan callback RX cua Serial: set CONSOLE_NOTIFY_BIT trong notification cua `owner`
+void console_begin(TaskHandle_t owner);
+
+// Doc het byte dang cho, chay lenh khi gap het dong. Khong block.
+void console_process();
+
+void console_print_help();
+void console_prompt();
+
+// Tien ich parse so nguyen khong am tu argv, tra ve false neu sai
+bool console_arg_u32(const char *arg, uint32_t *out);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef __COREIOT_H__
+#define __COREIOT_H__
+#include <Arduino.h>
+#include "global.h"
+#include "rule_engine.h"
+
+#define COREIOT_CONNECT_TIMEOUT_MS  15000
+#define COREIOT_NTP_TIMEOUT_MS      5000
+#define COREIOT_TELEMETRY_MAX       4096    // du cho mot batch telemetry tu RTC buffer
+// Buffer MQTT chi con cho tin den: telemetry gui thang tu buffer JSON (publishSegments).
+// Lon nhat la phan hoi attribute rules: RULES_SOURCE_MAX dang chuoi, moi ky tu escape
+// toi da 2 byte (\" \\ \n), cong header MQTT, topic response va {"shared":{"rules":""}}
+#define COREIOT_BUFFER_SIZE         (2 * RULES_SOURCE_MAX + 128)
+#define COREIOT_VALID_EPOCH         1600000000UL
+#define COREIOT_ATTR_TIMEOUT_MS     2000
+#define COREIOT_ATTR_SAMPLE_PERIOD  "sampleIntervalSec"    // shared attribute, 0/xoa = tu dong
+#define COREIOT_ATTR_RULES          "rules"                // shared attribute, mang rule JSON
+
+// Bat WiFi + ket noi ThingsBoard, block toi da timeout_ms
+bool coreiot_connect(uint32_t timeout_ms = COREIOT_CONNECT_TIMEOUT_MS);
+// Dong bo gio SNTP, tra ve true neu time() da hop le
+bool coreiot_sync_time(uint32_t timeout_ms = COREIOT_NTP_TIMEOUT_MS);
+bool coreiot_send_telemetry(const char *json);
+// Doc mot shared attribute so nguyen, block toi da timeout_ms de cho phan hoi.
+// true neu server da tra loi; *value giu nguyen neu attribute khong ton tai.
+bool coreiot_request_shared_u32(const char *key, uint32_t *value,
+                                uint32_t timeout_ms = COREIOT_ATTR_TIMEOUT_MS);
+// Nhu tren nhung ghi gia tri (object/mang/chuoi) thanh JSON vao out.
+// false neu khong tra loi, khong co attribute hoac khong du cho.
+bool coreiot_request_shared_json(const char *key, char *out, size_t cap,
+                                 uint32_t timeout_ms = COREIOT_ATTR_TIMEOUT_MS);
+// Ngat MQTT va tat radio
+void coreiot_disconnect();
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef __DEFERRED_LOG__
+#define __DEFERRED_LOG__
+#include <Arduino.h>
+#include <initializer_list>
+
+#define DLOG_CAPACITY       32      // so record trong ring, phai la luy thua cua 2
+#define DLOG_MAX_ARGS       4
+#define DLOG_TEXT_MAX       48      // ban sao cac tham so %s (ca log tu ThingsBoard)
+#define DLOG_FMT_MAX        64      // so format string khac nhau
+#define DLOG_FMT_NONE       0xFFFF  // bang format day
+#define DLOG_WIRE_MAX       (2 + 4 + 1 + DLOG_MAX_ARGS * 5 + 1 + DLOG_TEXT_MAX)
+#define DLOG_TASK_STACK     3072
+#define DLOG_TASK_PRIORITY  1
+
+enum {
+    DLOG_ARG_INT = 0,
+    DLOG_ARG_UINT,
+    DLOG_ARG_FLOAT,
+    DLOG_ARG_STR,       // con tro cua producer, chi hop le trong dlog_write()
+    DLOG_ARG_TEXT       // chuoi da copy vao record.text, word la offset
+};
+
+typedef union {
+    int32_t     i;
+    uint32_t    u;
+    float       f;
+    const char *s;
+} dlog_word_t;
+
+// Record nhi phan: ID format (index trong bang format dang ky luc ghi lan dau)
+// cong voi tham so tho, khong con con tro nao. Drain dinh dang ngay tren thiet bi;
+// ngoai thiet bi giai ma duoc tu dlog_encode() + bang dlog_fmt_text().
+typedef struct {
+    uint16_t     fmt_id;
+    uint32_t     ts_ms;
+    uint8_t      nargs;
+    uint8_t      types[DLOG_MAX_ARGS];
+    dlog_word_t  args[DLOG_MAX_ARGS];
+    char         text[DLOG_TEXT_MAX];
+} dlog_record_t;
+
+// Tao task drain uu tien thap
+bool dlog_begin();
+
+// Ghi record, khong khoa, goi duoc tu ISR. Ring day -> bo record, tra ve false.
+// Tham so DLOG_ARG_STR duoc copy vao record.text (cat bot neu qua DLOG_TEXT_MAX).
+bool dlog_write(const char *fmt, uint8_t nargs, const uint8_t *types, const dlog_word_t *args);
+// Lay record cu nhat (dung boi task drain / benchmark)
+bool dlog_pop(dlog_record_t *out);
+uint32_t dlog_dropped();
+// Drain dong bo trong task goi (truoc khi ngu, record trong RAM se mat)
+void dlog_flush();
+
+// Bang format: ID -> chuoi (NULL neu chua dang ky). ID giu nguyen toi khi reset.
+const char *dlog_fmt_text(uint16_t id);
+uint16_t dlog_fmt_count();
+
+// Dung lai record thanh text. Thuan tuy, khong dung phan cung.
+size_t dlog_format(const dlog_record_t *rec, char *out, size_t cap);
+// Nhu tren voi format cho san (giai ma ngoai thiet bi tu bang format da dump)
+size_t dlog_format(const dlog_record_t *rec, const char *fmt, char *out, size_t cap);
+
+// Dump record: little-endian, do dai thay doi, toi da DLOG_WIRE_MAX byte.
+// Tra ve so byte ghi / doc, 0 neu thieu cho / du lieu hong.
+size_t dlog_encode(const dlog_record_t *rec, uint8_t *out, size_t cap);
+size_t dlog_decode(const uint8_t *in, size_t len, dlog_record_t *rec);
+
+inline void dlog_pack(uint8_t &t, dlog_word_t &w, int v)           { t = DLOG_ARG_INT;   w.i = v; }
+inline void dlog_pack(uint8_t &t, dlog_word_t &w, long v)          { t = DLOG_ARG_INT;   w.i = v; }
+inline void dlog_pack(uint8_t &t, dlog_word_t &w, unsigned v)      { t = DLOG_ARG_UINT;  w.u = v; }
+inline void dlog_pack(uint8_t &t, dlog_word_t &w, unsigned long v) { t = DLOG_ARG_UINT;  w.u = v; }
+inline void dlog_pack(uint8_t &t, dlog_word_t &w, float v)         { t = DLOG_ARG_FLOAT; w.f = v; }
+inline void dlog_pack(uint8_t &t, dlog_word_t &w, double v)        { t = DLOG_ARG_FLOAT; w.f = (float)v; }
+inline void dlog_pack(uint8_t &t, dlog_word_t &w, const char *v)   { t = DLOG_ARG_STR;   w.s = v; }
+
+// Dong goi tham so thanh kieu + word, dung chung cho dlog() va logbench
+template<typename... Args>
+inline uint8_t dlog_pack_args(uint8_t *types, dlog_word_t *words, Args... args) {
+    static_assert(sizeof...(Args) <= DLOG_MAX_ARGS, "too many dlog arguments");
+    uint8_t i = 0;
+    (void)std::initializer_list<int>{ 0, (dlog_pack(types[i], words[i], args), i++, 0)... };
+    return i;
+}
+
+// dlog("T=%.2f H=%.2f", t, h): chi copy vai word vao ring, khong vsnprintf.
+// Chuoi %s duoc copy, tong cong toi da DLOG_TEXT_MAX - 1 ky tu moi record.
+template<typename... Args>
+inline bool dlog(const char *fmt, Args... args) {
+    uint8_t types[DLOG_MAX_ARGS];
+    dlog_word_t words[DLOG_MAX_ARGS];
+    uint8_t n = dlog_pack_args(types, words, args...);
+    return dlog_write(fmt, n, types, words);
+}
+
+/// @brief Logger for ThingsBoardSized that defers Serial output to the dlog drain task.
+/// ThingsBoard hands over an already formatted (often stack allocated) message, so it is copied
+/// into the record, truncated to DLOG_TEXT_MAX.
+class DeferredLogger {
+  public:
+    static void log(const char *msg);
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef __EVENT_BUS__
+#define __EVENT_BUS__
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/event_groups.h"
+
+#define EVENT_MAX_SUBSCRIBERS   8
+#define EVENT_PAYLOAD_MAX       12
+
+typedef enum {
+    EVT_NETWORK_UP = 0,
+    EVT_NETWORK_DOWN,
+    EVT_NEW_SAMPLE,         // payload: uint32_t sensor_snapshot sequence
+    EVT_CONFIG_CHANGED,     // payload: uint32_t config generation
+    EVT_OTA_STARTED,
+    EVT_RELAY_CHANGED,      // payload: relay_event_t
+    EVT_TOPIC_COUNT
+} event_topic_t;
+
+#define EVT_BIT(topic)      (1UL << (topic))
+#define EVT_ALL_TOPICS      (EVT_BIT(EVT_TOPIC_COUNT) - 1)
+
+// Bit trang thai (level) trong event group, de cho "mang da len" v.v.
+#define EVT_STATE_NETWORK   (1UL << 0)
+#define EVT_STATE_OTA       (1UL << 1)
+
+// Message nho, payload nam ngay trong message (khong cap phat, khong con tro)
+typedef struct {
+    uint8_t  topic;
+    uint8_t  len;
+    uint32_t stamp_ms;
+    uint8_t  data[EVENT_PAYLOAD_MAX];
+} event_msg_t;
+
+bool event_bus_init();
+
+// Subscriber kieu queue: nhan ca payload, queue tao boi subscriber
+// (item size = sizeof(event_msg_t)).
+bool event_bus_subscribe_queue(uint32_t topic_mask, QueueHandle_t queue);
+// Subscriber kieu task notification: chi nhan bit EVT_BIT(topic) qua
+// xTaskNotifyWait(), re nhat. Cac bit tu 16 tro len de cho module khac dung.
+bool event_bus_subscribe_task(uint32_t topic_mask, TaskHandle_t task);
+
+// Khong bao gio block. Queue day -> message bi bo va duoc dem.
+void event_bus_publish(event_topic_t topic, const void *data = NULL, uint8_t len = 0);
+void event_bus_publish_from_isr(event_topic_t topic, const void *data, uint8_t len,
+                                BaseType_t *woken);
+
+// Trang thai level: EVT_STATE_*
+EventBits_t event_bus_state();
+// false ngay neu chua event_bus_init()
+bool event_bus_wait_state(EventBits_t bits, TickType_t timeout);
+
+void event_bus_print_stats();
+
+#endif
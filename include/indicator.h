@@ -0,0 +1,79 @@
+#ifndef __INDICATOR__
+#define __INDICATOR__
+#include <Arduino.h>
+
+#define INDICATOR_NEO_PIN       45
+#define INDICATOR_D13_PIN       48
+#define INDICATOR_BRIGHTNESS    50
+#define INDICATOR_FRAME_MS      20      // buoc ve cua breathe
+#define INDICATOR_CODE_GAP_MS   1200    // khoang lang giua 2 lan lap ma loi
+#define INDICATOR_QUEUE_LEN     8
+
+typedef enum {
+    IND_CH_PIXEL = 0,   // NeoPixel (mau)
+    IND_CH_D13,         // LED don tren GPIO48, sang khi level >= 128
+    IND_CH_COUNT
+} indicator_channel_t;
+
+typedef enum {
+    IND_OFF = 0,
+    IND_SOLID,
+    IND_BLINK,          // on_ms sang / off_ms tat, `repeat` lan (0 = mai mai)
+    IND_BREATHE,        // sang dan trong on_ms roi toi dan trong on_ms, `repeat` chu ky (0 = mai mai)
+    IND_CODE            // ma loi: `repeat` nhay roi nghi INDICATOR_CODE_GAP_MS, lap mai mai
+} indicator_mode_t;
+
+typedef struct {
+    uint8_t  mode;      // indicator_mode_t
+    uint8_t  r, g, b;   // bo qua voi IND_CH_D13
+    uint16_t on_ms;
+    uint16_t off_ms;
+    uint8_t  repeat;
+} indicator_pattern_t;
+
+// Trang thai mot kenh: pattern nen + pattern tam thoi dang chay
+typedef struct {
+    indicator_pattern_t base;
+    indicator_pattern_t overlay;
+    bool                overlayActive;
+    uint32_t            startMs;
+    int16_t             lastLevel;  // -1 = phai ve lai
+} indicator_state_t;
+
+// Tao timer ve khung hinh, khoi tao NeoPixel + D13 (tat ca dang tat)
+bool indicator_init();
+
+// Pattern nen cua kenh, chay khi khong co pattern tam thoi. Goi duoc tu moi task, khong block.
+bool indicator_set(indicator_channel_t ch, const indicator_pattern_t *p);
+// Pattern tam thoi (huu han, vd blink 3 lan); xong thi tu quay ve pattern nen
+bool indicator_play(indicator_channel_t ch, const indicator_pattern_t *p);
+
+// Truoc khi ngu: dung ve, tat NeoPixel va nha chan, bat + giu D13. Goi duoc ca khi chua init.
+void indicator_sleep();
+// Sau light sleep: nha giu D13, khoi tao lai NeoPixel va ve tiep pattern hien tai
+void indicator_wake();
+
+// Phan tinh toan thuan tuy: do sang 0..255 cua `p` tai `t` ms ke tu luc bat dau.
+// *next_ms = so ms toi lan doi tiep theo (UINT32_MAX neu dung yen).
+// Tra ve false khi pattern huu han da chay xong.
+bool indicator_frame(const indicator_pattern_t *p, uint32_t t, uint8_t *level, uint32_t *next_ms);
+
+// Phan thuan tuy: nhan pattern moi cho kenh. Nen moi doi overlay dang chay xong moi hien.
+void indicator_state_apply(indicator_state_t *s, const indicator_pattern_t *p, bool overlay, uint32_t now);
+// Phan thuan tuy: mot khung cua kenh tai `now`. Overlay het thi quay ve nen tu dau.
+// *pattern = pattern dang hien, *next_ms nhu indicator_frame. Tra ve true khi level doi (can ghi LED).
+bool indicator_step(indicator_state_t *s, uint32_t now, const indicator_pattern_t **pattern,
+                    uint8_t *level, uint32_t *next_ms);
+
+static inline indicator_pattern_t indicator_solid(uint8_t r, uint8_t g, uint8_t b) {
+    indicator_pattern_t p = { IND_SOLID, r, g, b, 0, 0, 0 };
+    return p;
+}
+
+static inline indicator_pattern_t indicator_blink(uint8_t r, uint8_t g, uint8_t b,
+                                                  uint16_t on_ms, uint16_t off_ms, uint8_t times) {
+    indicator_pattern_t p = { IND_BLINK, r, g, b, on_ms, off_ms, times };
+    return p;
+}
+
+#endif
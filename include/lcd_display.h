@@ -0,0 +1,46 @@
+#ifndef __LCD_DISPLAY__
+#define __LCD_DISPLAY__
+#include <Arduino.h>
+
+#define LCD_I2C_ADDR        33
+#define LCD_COLS            16
+#define LCD_ROWS            2
+#define LCD_QUEUE_LEN       8
+#define LCD_TASK_STACK      3072
+#define LCD_TASK_PRIORITY   1       // thap nhat tren idle: khong chen sensor / mang
+#define LCD_SYSTEM_PERIOD_MS 1000   // man hinh he thong ve lai moi giay (uptime)
+#define LCD_NOTIFY_REQUEST  (1UL << 16)
+
+typedef enum {
+    LCD_SCREEN_SENSOR = 0,  // nhiet do / do am moi nhat
+    LCD_SCREEN_SYSTEM,      // uptime, heap, relay
+    LCD_SCREEN_TEXT,        // dong chu do producer ghi bang lcd_display_text()
+    LCD_SCREEN_COUNT
+} lcd_screen_t;
+
+typedef struct {
+    uint32_t requests;          // so request da nhan
+    uint32_t dropped;           // queue day -> bo
+    uint8_t  queue_depth;       // dang cho
+    uint8_t  queue_peak;
+    uint32_t renders;           // so lan flush (nhieu request gop thanh mot)
+    uint32_t last_latency_us;   // tu request cu nhat chua ve toi luc flush xong
+    uint32_t max_latency_us;
+    uint32_t last_transactions; // I2C cua lan flush cuoi
+    uint32_t total_transactions;
+    uint32_t glyph_hits;        // glyph CGRAM da co san
+    uint32_t glyph_loads;       // phai nap lai (createChar)
+} lcd_stats_t;
+
+// Tao task LCD; lcd.begin() (>1s) chay trong task nen khong chan setup().
+// Goi sau temp_humi_monitor_init() (Wire da begin dung chan).
+bool lcd_display_begin();
+
+// Khong bao gio block: queue day -> false va dem dropped
+bool lcd_display_text(uint8_t col, uint8_t row, const char *text);
+bool lcd_display_screen(lcd_screen_t screen);
+bool lcd_display_backlight(bool on);
+
+void lcd_display_get_stats(lcd_stats_t *out);
+
+#endif
@@ -1,9 +0,0 @@
-#ifndef __LED_BLINKY__
-#define __LED_BLINKY__
-#include <Arduino.h>
-#include "global.h"
-#define LED_GPIO 48
-void led_blinky(void *pvParameters);
-
-
-#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef __POWER_GOVERNOR__
+#define __POWER_GOVERNOR__
+#include <Arduino.h>
+
+#define GOVERNOR_MAX_JOBS       8
+#define GOVERNOR_LIGHT_MIN_MS   100     // khoang trong ngan hon -> chi idle
+#define GOVERNOR_DEEP_MIN_MS    60000   // khoang trong dai hon -> deep sleep (neu moi job cho phep)
+#define GOVERNOR_WAKE_MARGIN_MS 20      // thuc day som hon deadline
+
+typedef enum {
+    PWR_STATE_ACTIVE = 0,
+    PWR_STATE_IDLE,
+    PWR_STATE_LIGHT_SLEEP,
+    PWR_STATE_DEEP_SLEEP,
+    PWR_STATE_COUNT
+} power_state_t;
+
+// Hook goi sau khi thuc day tu light sleep de job dong bo lai timer cua no
+typedef void (*governor_wake_hook_t)(uint32_t slept_ms);
+// Tra ve true khi trong RAM co trang thai khong duoc mat (relay dang bat, rule dang chay...)
+typedef bool (*governor_veto_t)();
+
+typedef struct {
+    const char          *name;
+    uint32_t             period_ms;
+    uint32_t             last_run_ms;
+    bool                 deep_ok;
+    bool                 used;
+    governor_wake_hook_t on_wake;
+} governor_job_t;
+
+// Dang ky job dinh ky. deep_ok = job chiu duoc mat RAM (deep sleep reset).
+// Tra ve id >= 0, hoac -1 neu het cho.
+int  power_governor_register(const char *name, uint32_t period_ms, bool deep_ok,
+                             governor_wake_hook_t on_wake = NULL);
+void power_governor_unregister(int id);
+// Job doi chu ky (vd sample rate thich nghi), deadline van tinh tu lan chay truoc
+void power_governor_set_period(int id, uint32_t period_ms);
+// Job bao vua chay xong -> deadline tiep theo = now + period
+void power_governor_job_ran(int id, uint32_t now_ms);
+
+// Logic quyet dinh thuan tuy tren ban sao bang job (khong khoa, khong dung phan cung),
+// gap_ms = thoi gian toi deadline gan nhat. deep_allowed = false -> toi da light sleep.
+power_state_t power_governor_decide(const governor_job_t *jobs, uint8_t count, uint32_t now_ms,
+                                    bool deep_allowed, uint32_t *gap_ms);
+
+// Deep sleep reset RAM va boot lai nhu bat nguon (governor tat). Veto tra ve true -> khong deep.
+void power_governor_set_deep_veto(governor_veto_t veto);
+// Goi luc boot: neu lan truoc governor vao deep sleep thi ghi residency theo thoi gian ngu that
+void power_governor_boot();
+
+void power_governor_enable(bool on);
+bool power_governor_enabled();
+// Goi dinh ky tu task power: quyet dinh va vao trang thai tuong ung
+void power_governor_step();
+
+void power_governor_account(power_state_t state, uint32_t ms);
+void power_governor_print_report();
+
+#endif
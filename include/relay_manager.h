@@ -0,0 +1,55 @@
+#ifndef __RELAY_MANAGER__
+#define __RELAY_MANAGER__
+#include <Arduino.h>
+
+#define RELAY_MAX           8
+#define RELAY_MAX_SCENES    4
+#define RELAY_NAME_LEN      16
+#define RELAY_JSON_DOC      512     // du cho mot scene RELAY_MAX relay
+
+// Cap chan GPIO cho relay. Mac dinh ghi thang thanh ghi W1TS/W1TC cua ESP32-S3;
+// host test co the thay bang ban ghi lai mask + thoi diem de do do tre.
+typedef struct {
+    void (*output)(uint8_t gpio);
+    // lo = GPIO0..31, hi = GPIO32..48 (bit 0 = GPIO32)
+    void (*write)(uint32_t set_lo, uint32_t clr_lo, uint32_t set_hi, uint32_t clr_hi);
+} relay_hal_t;
+
+// Payload EVT_RELAY_CHANGED
+typedef struct {
+    uint32_t state;         // bit i = relay thu i dang ON
+    uint32_t latency_us;    // tu luc nhan lenh toi luc ghi thanh ghi
+} relay_event_t;
+
+bool relay_manager_begin(const relay_hal_t *hal = NULL);
+
+// Dang ky (hoac doi chan) relay, tat san. Tra ve index, -1 neu het cho / chan bi cam.
+int  relay_register(const char *name, uint8_t gpio);
+int  relay_find(const char *name);
+bool relay_gpio_allowed(uint8_t gpio);
+uint32_t relay_state();
+uint8_t  relay_count();
+
+// Bat `on_mask` va tat `off_mask` (bit = index relay) trong cung mot lan ghi thanh ghi.
+bool relay_apply(uint32_t on_mask, uint32_t off_mask);
+bool relay_set(const char *name, bool on);
+
+// Scene luu trong RAM: mask relay can bat/tat
+bool relay_scene_save(const char *name, uint32_t on_mask, uint32_t off_mask);
+bool relay_scene_apply(const char *name);
+
+// Message tu trang Device (console: relay json <msg>), parse tai cho (chuoi tro thang
+// vao `json`, nen json bi sua). status nhan "ON"/"OFF"/"1"/"0", bool hoac so:
+//   {"page":"device","value":{"name":..,"status":"ON"|"OFF","gpio":..}}
+//   {"page":"device","value":[{..},{..}]}              -> ap dung nguyen khoi
+//   {"page":"scene","value":{"name":..,"relays":[..]}}  -> luu scene
+//   {"page":"scene","value":{"name":..}}                -> ap dung scene
+// Relay chua biet nhung co gpio hop le se tu dang ky. Tat ca hoac khong: moi entry
+// (ke ca doi chan) duoc kiem tra truoc, mot entry sai thi khong relay/chan nao bi dong.
+// Do tre (event, "Last apply") tinh tu luc nhan message toi luc ghi thanh ghi.
+bool relay_apply_json(char *json, size_t len);
+
+// Bao cao gop mot message: {"page":"device","value":[{"name":..,"status":..,"gpio":..},..]}
+size_t relay_format_json(char *out, size_t cap);
+
+#endif
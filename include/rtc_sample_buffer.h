@@ -0,0 +1,37 @@
+#ifndef __RTC_SAMPLE_BUFFER__
+#define __RTC_SAMPLE_BUFFER__
+#include <Arduino.h>
+
+#define RTC_SAMPLE_CAPACITY     48      // 8 byte/mau -> 384 byte RTC slow memory
+#define RTC_FLUSH_EVERY_N       6       // bat mang moi N lan thuc day
+
+// Mau nen gon luu trong RTC memory qua deep sleep
+typedef struct {
+    uint32_t ts;            // epoch seconds (hoac RTC seconds neu chua sync NTP)
+    int16_t  temp_centi;    // 0.01 °C
+    uint16_t humi_centi;    // 0.01 %RH
+} rtc_sample_t;
+
+// Khoi tao lai neu RTC memory khong hop le (power-on, doi layout)
+void rtc_buffer_begin();
+void rtc_buffer_clear();
+void rtc_buffer_append(uint32_t ts, int16_t temp_centi, uint16_t humi_centi);
+uint16_t rtc_buffer_count();
+uint16_t rtc_buffer_dropped();
+
+// Flush policy: du N lan thuc day hoac buffer day (chi khi chua co lan flush that bai)
+void rtc_buffer_note_wake();
+bool rtc_buffer_should_flush(uint16_t flush_every);
+// Flush that bai: giu mau, dem lai tu dau; buffer day khong con ep flush som
+// cho toi lan clear() tiep theo, mau cu nhat bi drop thay vi bat radio moi lan thuc day
+void rtc_buffer_defer_flush();
+
+// Cong delta vao ts cua cac mau chup truoc khi co gio NTP
+void rtc_buffer_rebase(uint32_t valid_epoch, int32_t delta);
+
+// Ghi toan bo buffer thanh mang telemetry ThingsBoard:
+// [{"ts":<ms>,"values":{"temperature":..,"humidity":..}},...]
+// Tra ve so byte da ghi (khong tinh '\0'), 0 neu khong du cho.
+size_t rtc_buffer_format_json(char *out, size_t cap);
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef __RULE_ENGINE__
+#define __RULE_ENGINE__
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "relay_manager.h"
+
+#define RULES_MAX           8
+#define RULES_CODE_MAX      192     // byte bytecode
+#define RULES_CONST_MAX     24
+#define RULES_SLOTS_MAX     16      // so phep so sanh co hysteresis
+#define RULES_ACTIONS_MAX   16
+#define RULES_STACK_MAX     8
+#define RULES_SOURCE_MAX    1536    // JSON goc luu tren flash
+#define RULES_JSON_DOC      2048
+#define RULES_PATH          "/rules.json"
+
+// Dau vao cua mot lan danh gia
+typedef enum {
+    RULE_IN_TEMPERATURE = 0,
+    RULE_IN_HUMIDITY,
+    RULE_IN_ANOMALY,
+    RULE_IN_COUNT
+} rule_input_t;
+
+typedef enum {
+    RULE_ACT_NONE = 0,
+    RULE_ACT_RELAY,         // bat/tat relay theo ten (tim luc chay, relay co the dang ky sau)
+    RULE_ACT_LED            // pattern nen cua NeoPixel
+} rule_action_type_t;
+
+typedef enum {
+    RULE_LED_NORMAL = 0,    // xanh dung yen
+    RULE_LED_WARN,          // cam "tho"
+    RULE_LED_ALARM,         // do nhay nhanh
+    RULE_LED_OFF
+} rule_led_t;
+
+typedef struct {
+    uint8_t type;           // rule_action_type_t
+    uint8_t arg;            // relay: 1 = ON; led: rule_led_t
+    char    relay[RELAY_NAME_LEN];
+} rule_action_t;
+
+// Chuong trinh da bien dich, kich thuoc co dinh
+typedef struct {
+    uint8_t       code[RULES_CODE_MAX];
+    uint16_t      codeLen;
+    float         consts[RULES_CONST_MAX];
+    uint8_t       constCount;
+    rule_action_t actions[RULES_ACTIONS_MAX];
+    uint8_t       actionCount;
+    uint8_t       ruleCount;
+    uint8_t       slotCount;
+    float         watchLo;  // nguong nhiet do de sample_rate lay mau nhanh (NAN = khong)
+    float         watchHi;
+} rule_program_t;
+
+// Ket qua mot lan chay: gop lai de ap dung mot lan
+typedef struct {
+    uint32_t relayOn;
+    uint32_t relayOff;
+    int8_t   led;           // -1 = khong doi
+    uint8_t  fired;         // so rule doi trang thai
+} rule_effects_t;
+
+// Nap /rules.json (neu co) va dang ky lenh "rules"
+bool rules_begin();
+
+// Bien dich {"page":"rules","value":[{"when":..,"then":..,"else":..},..]} (hoac chi mang).
+//   when: {"input":"temperature|humidity|anomaly","op":">"|"<","value":x,"hyst":h}
+//         hoac {"all":[..]} / {"any":[..]} / {"not":{..}}
+//   then/else: {"relay":"Fan","status":"ON","gpio":5} hoac {"led":"alarm|warn|normal|off"}
+// Thanh cong -> doi chuong trinh dang chay, reset trang thai hysteresis, luu flash neu persist.
+// Nguon: shared attribute luc duty cycle flush, hoac console `rules json <msg>` o che do active.
+// Nguong nhiet do lay mau nhanh: chi nguong thap nhat va cao nhat (sample_rate co 2 diem theo doi).
+// Chi goi tu task power (cung task voi rules_evaluate).
+bool rules_apply_json(const char *json, size_t len, bool persist = true);
+// err (co the NULL) nhan chuoi hang mo ta loi
+bool rules_compile(JsonVariantConst rules, rule_program_t *out, const char **err);
+
+// Phan thuan tuy: chay bytecode, cap nhat latch/state, gom hieu ung vao *fx
+bool rules_run(const rule_program_t *prog, uint8_t *latch, uint8_t *state,
+               const float *inputs, rule_effects_t *fx);
+// Danh gia chuong trinh dang chay voi mau moi va ap dung relay/LED
+void rules_evaluate(float temperature, float humidity, uint8_t anomaly_score);
+// So rule cua chuong trinh dang chay (0 = chua nap / da clear)
+uint8_t rules_count();
+
+#endif
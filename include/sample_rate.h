@@ -0,0 +1,44 @@
+#ifndef __SAMPLE_RATE__
+#define __SAMPLE_RATE__
+#include <Arduino.h>
+
+#define RATE_MIN_PERIOD_MS      1000    // DHT20 tu choi doc nhanh hon 1s (DHT20_ERROR_LASTREAD)
+#define RATE_MAX_PERIOD_MS      300000  // tin hieu phang -> 5 phut/mau
+#define RATE_TEMP_RESOLUTION    0.1f    // °C cho phep troi giua 2 mau
+#define RATE_HUMI_RESOLUTION    0.5f    // %RH
+#define RATE_SLOPE_ALPHA        0.3f    // EWMA cua |do doc|
+#define RATE_BACKOFF_PERCENT    150     // moi buoc chi gian chu ky toi da x1.5, rut ngan thi ngay lap tuc
+#define RATE_WATCH_MARGIN       1.0f    // °C: gan nguong canh bao -> lay mau nhanh nhat
+
+typedef struct {
+    uint32_t minMs;
+    uint32_t maxMs;
+    uint32_t periodMs;          // quyet dinh hien tai
+    uint32_t overrideMs;        // 0 = tu dong
+    uint32_t lastMs;
+    float    lastTemp;
+    float    lastHumi;
+    float    tempSlope;         // EWMA |dT/dt| theo giay
+    float    humiSlope;
+    float    watchLo;           // nguong nhiet do dang theo doi (NAN = khong co)
+    float    watchHi;
+    bool     hasSample;
+} rate_ctrl_t;
+
+// Giay -> ms, bao hoa thay vi tran 32 bit (gia tri tu console / shared attribute)
+static inline uint32_t rate_sec_to_ms(uint32_t sec) {
+    uint64_t ms = (uint64_t)sec * 1000;
+    return ms > UINT32_MAX ? UINT32_MAX : (uint32_t)ms;
+}
+
+// Trang thai co dinh, de duoc trong RTC_DATA_ATTR cho duty cycle
+void rate_ctrl_init(rate_ctrl_t *c, uint32_t min_ms, uint32_t max_ms, uint32_t initial_ms);
+// 0 = tra ve che do tu dong. Gia tri duoc kep vao [minMs, maxMs].
+void rate_ctrl_set_override(rate_ctrl_t *c, uint32_t period_ms);
+// Lay mau nhanh khi nhiet do cach lo/hi it hon RATE_WATCH_MARGIN (NAN de bo);
+// ngoai vung thi chu ky khong dai hon thoi gian troi toi mep vung theo do doc hien tai
+void rate_ctrl_set_watch(rate_ctrl_t *c, float lo, float hi);
+// Phan tinh toan thuan tuy: cap nhat do doc tu mau moi, tra ve chu ky tiep theo (ms)
+uint32_t rate_ctrl_update(rate_ctrl_t *c, float temperature, float humidity, uint32_t now_ms);
+
+#endif
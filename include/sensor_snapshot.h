@@ -0,0 +1,24 @@
+#ifndef __SENSOR_SNAPSHOT__
+#define __SENSOR_SNAPSHOT__
+#include <Arduino.h>
+
+// Mot mau cam bien hoan chinh, duoc publish nguyen khoi (khong bi "xe")
+typedef struct {
+    float    temperature;
+    float    humidity;
+    uint32_t timestamp_ms;
+    uint32_t sequence;      // tang 1 moi lan publish, 0 = chua co mau nao
+    int      status;        // DHT20_OK or DHT20_ERROR_*
+} sensor_snapshot_t;
+
+// Single writer (sensor timer). Khong duoc goi dong thoi tu nhieu task.
+void sensor_snapshot_publish(float temperature, float humidity, uint32_t timestamp_ms, int status);
+
+// Doc ban sao nhat quan. An toan tu moi core va ISR, khong khoa.
+// Tra ve false neu chua co mau nao.
+bool sensor_snapshot_read(sensor_snapshot_t *out);
+
+// Sequence cua mau moi nhat, dung de bo qua mau khong doi
+uint32_t sensor_snapshot_sequence();
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef __SENSOR_STATS__
+#define __SENSOR_STATS__
+#include <Arduino.h>
+#include "temp_humi_monitor.h"
+
+#define STATS_TEMP_DEADBAND     20      // 0.01 °C
+#define STATS_HUMI_DEADBAND     100     // 0.01 %RH
+#define STATS_MAX_SILENCE_S     900     // gui it nhat 1 mau moi 15 phut du khong doi
+#define STATS_WINDOW_SAMPLES    12      // 1 aggregate moi 12 mau (1 phut o 5s/mau)
+#define STATS_EWMA_ALPHA        0.2f
+
+// Ket qua cua stats_channel_update / sensor_stats_feed
+#define STATS_REPORT    0x01    // deadband hoac max-silence kich hoat -> gui mau nay
+#define STATS_WINDOW    0x02    // vua dong mot cua so -> aggregate san sang
+
+// Mau vao la so nguyen 0.01 don vi (sensor_sample_t); aggregate ra la float don vi thuong
+typedef struct {
+    int32_t  deadband;          // 0.01 don vi
+    uint32_t max_silence_s;
+    uint16_t window;            // so mau moi cua so (tumbling)
+    float    ewma_alpha;
+} stats_channel_cfg_t;
+
+typedef struct {
+    uint16_t count;
+    float    min;
+    float    max;
+    float    mean;
+    float    stddev;
+    float    ewma;
+} stats_aggregate_t;
+
+// Trang thai co dinh, khong cap phat; de duoc trong RTC_DATA_ATTR
+typedef struct {
+    stats_channel_cfg_t cfg;
+    uint16_t n;
+    int32_t  min;
+    int32_t  max;
+    float    mean;              // mean/m2/ewma tinh theo 0.01 don vi
+    float    m2;                // tong binh phuong do lech (Welford)
+    float    ewma;
+    int32_t  lastReported;
+    uint32_t lastReportS;
+    bool     hasEwma;
+    bool     hasReport;
+} stats_channel_t;
+
+typedef struct {
+    stats_channel_t   temperature;
+    stats_channel_t   humidity;
+    stats_aggregate_t tempAgg;  // aggregate cua cua so vua dong
+    stats_aggregate_t humiAgg;
+} sensor_stats_t;
+
+void stats_channel_init(stats_channel_t *c, const stats_channel_cfg_t *cfg);
+// O(1) moi mau. Khi cua so dong thi ghi aggregate vao *agg (co the NULL).
+uint8_t stats_channel_update(stats_channel_t *c, int32_t x, uint32_t now_s, stats_aggregate_t *agg);
+// Thong ke cua cua so dang mo (chua dong)
+void stats_channel_snapshot(const stats_channel_t *c, stats_aggregate_t *out);
+
+// Hai kenh nhiet do/do am voi cau hinh mac dinh o tren
+void sensor_stats_init(sensor_stats_t *s);
+// Bo qua mau loi. Mot kenh vuot deadband thi bao ca cap de uplink giu nguyen dang {temperature, humidity}.
+uint8_t sensor_stats_feed(sensor_stats_t *s, const sensor_sample_t *sample, uint32_t now_s);
+// {"temperature_min":..,"temperature_max":..,"temperature_mean":..,"temperature_std":..,"humidity_...":..,"window":N}
+// Tra ve so byte da ghi, 0 neu khong du cho hoac chua co aggregate.
+size_t sensor_stats_format_json(const sensor_stats_t *s, char *out, size_t cap);
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef __SYS_MONITOR__
+#define __SYS_MONITOR__
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define SYSMON_PERIOD_MS    10000
+#define SYSMON_MAX_TASKS    20
+#define SYSMON_NAME_LEN     16
+
+typedef struct {
+    char     name[SYSMON_NAME_LEN];
+    uint32_t number;            // xTaskNumber, de khop voi lan lay mau truoc
+    uint32_t runtime;           // ulRunTimeCounter tuyet doi
+    uint16_t cpu_permille;      // % CPU trong chu ky vua roi (x10), tren tong moi core
+    uint32_t stack_free;        // high-water mark (byte tren ESP32)
+    uint8_t  priority;
+    uint8_t  state;             // eTaskState
+    int8_t   core;              // -1 = khong pin
+} sysmon_task_t;
+
+typedef struct {
+    uint32_t      uptime_ms;
+    uint32_t      heap_free;
+    uint32_t      heap_min_free;
+    uint32_t      heap_largest;
+    uint16_t      idle_permille;
+    uint8_t       task_count;
+    uint8_t       tasks_truncated;  // so task khong vua bang
+    sysmon_task_t tasks[SYSMON_MAX_TASKS];
+} sysmon_report_t;
+
+// Tao timer lay mau dinh ky va dang ky lenh "stats"
+bool sys_monitor_init();
+// Lay mau ngay trong task goi. Chi dung khi timer chua chay (vd duty cycle).
+void sys_monitor_sample_now();
+// Ban sao report moi nhat, false neu chua lay mau lan nao. Khong chan writer.
+bool sys_monitor_get(sysmon_report_t *out);
+
+// Phan tinh toan thuan tuy: dien cpu_permille/idle_permille cua `cur`
+// tu delta runtime so voi `prev` (co the NULL lan dau)
+void sys_monitor_aggregate(sysmon_report_t *cur, const sysmon_report_t *prev,
+                           uint32_t total_runtime_delta, uint8_t cores);
+// In bang cho console
+void sys_monitor_print(const sysmon_report_t *r);
+// JSON gon cho ThingsBoard telemetry, tra ve so byte (0 neu khong du cho)
+size_t sys_monitor_format_json(const sysmon_report_t *r, char *out, size_t cap);
+
+#endif
@@ -5,8 +5,16 @@
 
 void task_power_demo_init();
 void task_power_management(void *pvParameters);
-void enter_light_sleep(uint32_t time_ms);
+void enter_light_sleep(uint32_t time_sec);
+// Light sleep khong in log (dung cho governor), tra ve so ms da ngu thuc te
+uint32_t light_sleep_for(uint32_t time_ms);
 void enter_deep_sleep(uint32_t time_sec);
 void print_power_comparison();
 
+// Deep-sleep duty cycle: moi lan thuc day do 1 mau vao RTC buffer,
+// chi bat mang moi RTC_FLUSH_EVERY_N lan de gui ca batch.
+void enter_duty_cycle(uint32_t time_sec);
+// Goi dau setup(): neu dang trong duty cycle thi do/gui roi ngu lai (khong return)
+bool duty_cycle_resume();
+
 #endif
\ No newline at end of file
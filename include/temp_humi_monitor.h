@@ -1,11 +1,42 @@
 #ifndef __TEMP_HUMI_MONITOR__
 #define __TEMP_HUMI_MONITOR__
 #include <Arduino.h>
-#include "LiquidCrystal_I2C.h"
 #include "DHT20.h"
 #include "global.h"
 
-void temp_humi_monitor(void *pvParameters);
+#define SENSOR_SDA_PIN          11
+#define SENSOR_SCL_PIN          12
+#define SENSOR_SAMPLE_PERIOD_MS 5000    // initial sampling period, adapted by sample_rate afterwards
+#define SENSOR_CONVERSION_MS    DHT20_CONVERSION_TIME   // DHT20 datasheet: measurement takes ~80ms
+#define SENSOR_BUSY_RETRY_MS    DHT20_POLL_INTERVAL     // re-check interval if still measuring
+#define SENSOR_RING_SIZE        16      // bounded sample ring buffer, oldest dropped
 
+// Gia tri nguyen tu DHT20 getTemperatureCenti()/getHumidityCenti(), khong qua FPU
+typedef struct {
+    int16_t  temp_centi;    // 0.01 °C
+    uint16_t humi_centi;    // 0.01 %RH, 0..10000
+    uint32_t timestamp_ms;
+    int      status;        // DHT20_OK or DHT20_ERROR_*
+} sensor_sample_t;
 
-#endif
\ No newline at end of file
+// Doi sang float chi o cho can (anomaly, rule engine, log)
+static inline float sample_temperature(const sensor_sample_t *s) { return s->temp_centi * 0.01f; }
+static inline float sample_humidity(const sensor_sample_t *s) { return s->humi_centi * 0.01f; }
+
+// Tao software timer lay mau DHT20 (khong can task rieng)
+bool temp_humi_monitor_init();
+// Do mot mau dong bo (dung cho duty cycle deep sleep, khi timer chua chay)
+bool temp_humi_sample_once(sensor_sample_t *out);
+// Lay mau cu nhat trong ring buffer, tra ve false neu rong
+bool temp_humi_pop_sample(sensor_sample_t *out);
+uint32_t temp_humi_pending();
+uint32_t temp_humi_dropped();
+
+// Chu ky lay mau hien tai do rate controller chon (ms)
+uint32_t temp_humi_interval();
+// Ep chu ky co dinh (0 = tu dong), ap dung ngay tren timer task
+bool temp_humi_set_interval(uint32_t period_ms);
+// Nguong nhiet do can theo sat (NAN de bo), vd tu rule engine
+void temp_humi_set_watch(float lo, float hi);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef __TINY_NN__
+#define __TINY_NN__
+#include <stdint.h>
+#include <stddef.h>
+
+// Kernel int8 toi gian thay cho TFLite Micro. Layout:
+//   tensor 1D: [time][channel], weight conv1d: [out][kernel][in], dense: [out][in]
+// => moi tich vo huong la hai day int8 lien tuc (kernel*in), de compiler / ESP-NN vector hoa.
+// Tat ca la so nguyen thuan tuy nen ket qua giong het nhau tren host va ESP32-S3.
+
+// Requantize int32 -> int8: out = round(acc * mult / 2^shift), bao hoa [-128, 127]
+typedef struct {
+    int32_t mult;
+    uint8_t shift;
+} nn_requant_t;
+
+int8_t  nn_requantize(int32_t acc, const nn_requant_t *rq);
+int32_t nn_dot_s8(const int8_t *a, const int8_t *b, size_t n);
+
+// Conv1d valid padding, stride 1: out co (len - kernel + 1) buoc thoi gian.
+// bias va rq theo tung kenh ra; relu = kep am ve 0.
+void nn_conv1d_s8(const int8_t *in, uint16_t len, uint8_t in_ch,
+                  const int8_t *w, const int32_t *bias, uint8_t out_ch, uint8_t kernel,
+                  const nn_requant_t *rq, bool relu, int8_t *out);
+void nn_dense_s8(const int8_t *in, uint16_t in_len,
+                 const int8_t *w, const int32_t *bias, uint16_t out_len,
+                 const nn_requant_t *rq, bool relu, int8_t *out);
+// Max theo thoi gian cua `tail` buoc cuoi, moi kenh mot gia tri
+void nn_maxpool_tail_s8(const int8_t *in, uint16_t len, uint8_t ch, uint16_t tail, int8_t *out);
+
+#endif
@@ -14,18 +14,49 @@
 
 const uint8_t DHT20_ADDRESS = 0x38;
 
+//  CRC8 polynomial 0x31 (x8 + x5 + x4 + 1), one lookup per byte
+static const uint8_t DHT20_CRC8_TABLE[256] =
+{
+  0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+  0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4, 0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
+  0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11, 0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
+  0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52, 0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
+  0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA, 0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
+  0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9, 0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
+  0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C, 0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
+  0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F, 0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
+  0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED, 0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
+  0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE, 0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
+  0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B, 0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
+  0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28, 0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
+  0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0, 0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
+  0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93, 0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
+  0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56, 0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+  0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15, 0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC,
+};
+
 
 DHT20::DHT20(TwoWire *wire)
 {
   _wire        = wire;
   //  reset() ?
-  _temperature = 0;
-  _humidity    = 0;
-  _humOffset   = 0;
-  _tempOffset  = 0;
+  _rawTemperature  = 0;
+  _rawHumidity     = 0;
+  _humOffset       = 0;
+  _tempOffset      = 0;
+  _humOffsetCenti  = 0;
+  _tempOffsetCenti = 0;
   _status      = DHT20_OK;
   _lastRequest = 0;
   _lastRead    = 0;
+
+  _calibrated   = false;
+  _measuring    = false;
+  _lastPoll     = 0;
+  _transactions = 0;
+  _waitMicros   = 0;
+  _callback     = NULL;
+  _callbackArg  = NULL;
 }
 
 
@@ -56,6 +87,9 @@ bool DHT20::isConnected()
 {
   _wire->beginTransmission(DHT20_ADDRESS);
   int rv = _wire->endTransmission();
+  _transactions++;
+  //  power-on or reconnect => check calibration again
+  if (rv != 0) _calibrated = false;
   return rv == 0;
 }
 
@@ -77,12 +111,19 @@ uint8_t DHT20::resetSensor()
     if (_resetRegister(0x1B)) count++;
     if (_resetRegister(0x1C)) count++;
     if (_resetRegister(0x1E)) count++;
-    delay(10);
+    _delay(10);
   }
+  _calibrated = (count == 255) || (count == 3);
   return count;
 }
 
 
+bool DHT20::isCalibratedCached()
+{
+  return _calibrated;
+}
+
+
 ////////////////////////////////////////////////
 //
 //  READ THE SENSOR
@@ -95,26 +136,24 @@ int DHT20::read()
     return DHT20_ERROR_LASTREAD;
   }
 
-  int status = requestData();
+  int status = startMeasurement();
   if (status < 0) return status;
-  //  wait for measurement ready
-  while (isMeasuring())
+  //  wait for measurement ready, poll() does not touch the bus
+  //  before the conversion time and then every DHT20_POLL_INTERVAL.
+  uint32_t start = micros();
+  while ((status = poll()) == DHT20_PENDING)
   {
     yield();
   }
-  //  read the measurement
-  status = readData();
-  if (status < 0) return status;
-
-  //  convert it to meaningful data
-  return convert();
+  _waitMicros += micros() - start;
+  return status;
 }
 
 
 int DHT20::requestData()
 {
-  //  reset sensor if needed.
-  resetSensor();
+  //  reset sensor only after power-on or an error.
+  if (!_calibrated) resetSensor();
 
   //  GET CONNECTION
   _wire->beginTransmission(DHT20_ADDRESS);
@@ -122,17 +161,75 @@ int DHT20::requestData()
   _wire->write(0x33);
   _wire->write(0x00);
   int rv = _wire->endTransmission();
+  _transactions++;
+  if (rv != 0) _calibrated = false;
 
   _lastRequest = millis();
   return rv;
 }
 
 
+////////////////////////////////////////////////
+//
+//  NON-BLOCKING
+//
+int DHT20::startMeasurement()
+{
+  if (requestData() != 0)
+  {
+    _measuring = false;
+    return DHT20_ERROR_CONNECT;
+  }
+  _measuring = true;
+  _lastPoll  = _lastRequest;
+  return DHT20_OK;
+}
+
+
+int DHT20::poll()
+{
+  if (!_measuring) return DHT20_ERROR_NOT_STARTED;
+
+  uint32_t now = millis();
+  if (now - _lastRequest < DHT20_CONVERSION_TIME) return DHT20_PENDING;
+  //  still measuring at last poll => do not hammer the bus
+  if ((_lastPoll != _lastRequest) && (now - _lastPoll < DHT20_POLL_INTERVAL))
+  {
+    return DHT20_PENDING;
+  }
+  _lastPoll = now;
+
+  //  status + data in one transaction, no separate readStatus()
+  int status = readData();
+  if (status < 0) return _finish(status);
+  if (_bits[0] & 0x80)
+  {
+    if (now - _lastRequest < DHT20_MEASURE_TIMEOUT) return DHT20_PENDING;
+    return _finish(DHT20_ERROR_READ_TIMEOUT);
+  }
+  return _finish(convert());
+}
+
+
+bool DHT20::isPending()
+{
+  return _measuring;
+}
+
+
+void DHT20::setCallback(DHT20_callback callback, void *arg)
+{
+  _callback    = callback;
+  _callbackArg = arg;
+}
+
+
 int DHT20::readData()
 {
   //  GET DATA
   const uint8_t length = 7;
   int bytes = _wire->requestFrom(DHT20_ADDRESS, length);
+  _transactions++;
 
   if (bytes == 0)     return DHT20_ERROR_CONNECT;
   if (bytes < length) return DHT20_MISSING_BYTES;
@@ -156,24 +253,24 @@ int DHT20::readData()
 
 int DHT20::convert()
 {
-  //  CONVERT AND STORE
+  //  STORE RAW, conversion is done by the getters
   _status      = _bits[0];
   uint32_t raw = _bits[1];
   raw <<= 8;
   raw += _bits[2];
   raw <<= 4;
   raw += (_bits[3] >> 4);
-  _humidity = raw * 9.5367431640625e-5;   // ==> / 1048576.0 * 100%;
+  _rawHumidity = raw;
 
   raw = (_bits[3] & 0x0F);
   raw <<= 8;
   raw += _bits[4];
   raw <<= 8;
   raw += _bits[5];
-  _temperature = raw * 1.9073486328125e-4 - 50;  //  ==> / 1048576.0 * 200 - 50;
+  _rawTemperature = raw;
 
   //  TEST CHECKSUM
-  uint8_t _crc = _crc8(_bits, 6);
+  uint8_t _crc = crc8(_bits, 6);
   //  Serial.print(_crc, HEX);
   //  Serial.print("\t");
   //  Serial.println(_bits[6], HEX);
@@ -189,25 +286,40 @@ int DHT20::convert()
 //
 float DHT20::getHumidity()
 {
-  return _humidity + _humOffset;
+  return _rawHumidity * 9.5367431640625e-5f + _humOffset;   // ==> / 1048576.0 * 100%;
 };
 
 
 float DHT20::getTemperature()
 {
-  return _temperature + _tempOffset;
+  //  ==> / 1048576.0 * 200 - 50;
+  return _rawTemperature * 1.9073486328125e-4f - 50 + _tempOffset;
 };
 
 
+int32_t DHT20::getHumidityCenti()
+{
+  return humidityCenti(_rawHumidity) + _humOffsetCenti;
+}
+
+
+int16_t DHT20::getTemperatureCenti()
+{
+  return temperatureCenti(_rawTemperature) + _tempOffsetCenti;
+}
+
+
 void DHT20::setHumOffset(float offset)
 {
   _humOffset = offset;
+  _humOffsetCenti = (int16_t)lroundf(offset * 100);
 };
 
 
 void DHT20::setTempOffset(float offset)
 {
   _tempOffset = offset;
+  _tempOffsetCenti = (int16_t)lroundf(offset * 100);
 };
 
 
@@ -223,6 +335,47 @@ float DHT20::getTempOffset()
 };
 
 
+////////////////////////////////////////////////
+//
+//  RAW & FIXED POINT
+//
+uint32_t DHT20::getRawHumidity()
+{
+  return _rawHumidity;
+}
+
+
+uint32_t DHT20::getRawTemperature()
+{
+  return _rawTemperature;
+}
+
+
+//  raw * 10000 / 2^20  ==  raw * 625 / 2^16, fits in 32 bit for raw < 2^20
+int32_t DHT20::humidityCenti(uint32_t raw)
+{
+  return (int32_t)((raw * 625UL + 0x8000UL) >> 16);
+}
+
+
+//  raw * 20000 / 2^20 - 5000  ==  raw * 625 / 2^15 - 5000
+int16_t DHT20::temperatureCenti(uint32_t raw)
+{
+  return (int16_t)((int32_t)((raw * 625UL + 0x4000UL) >> 15) - 5000);
+}
+
+
+uint8_t DHT20::crc8(const uint8_t *ptr, uint8_t len)
+{
+  uint8_t crc = 0xFF;
+  while(len--)
+  {
+    crc = DHT20_CRC8_TABLE[crc ^ *ptr++];
+  }
+  return crc;
+}
+
+
 ////////////////////////////////////////////////
 //
 //  STATUS
@@ -230,7 +383,8 @@ float DHT20::getTempOffset()
 uint8_t DHT20::readStatus()
 {
   _wire->requestFrom(DHT20_ADDRESS, (uint8_t)1);
-  delay(1);  //  needed to stabilize timing
+  _transactions++;
+  _delay(1);  //  needed to stabilize timing
   return (uint8_t) _wire->read();
 }
 
@@ -275,30 +429,47 @@ uint32_t DHT20::lastRequest()
 };
 
 
+////////////////////////////////////////////////
+//
+//  STATISTICS
+//
+uint32_t DHT20::getTransactions()
+{
+  return _transactions;
+}
+
+
+uint32_t DHT20::getWaitMicros()
+{
+  return _waitMicros;
+}
+
+
+void DHT20::resetStatistics()
+{
+  _transactions = 0;
+  _waitMicros   = 0;
+}
+
+
 ////////////////////////////////////////////////
 //
 //  PRIVATE
 //
-uint8_t DHT20::_crc8(uint8_t *ptr, uint8_t len)
+int DHT20::_finish(int status)
 {
-  uint8_t crc = 0xFF;
-  while(len--)
-  {
-    crc ^= *ptr++;
-    for (uint8_t i = 0; i < 8; i++)
-    {
-      if (crc & 0x80)
-      {
-        crc <<= 1;
-        crc ^= 0x31;
-      }
-      else
-      {
-        crc <<= 1;
-      }
-    }
-  }
-  return crc;
+  _measuring = false;
+  //  any failure => run the reset sequence before the next request
+  if (status != DHT20_OK) _calibrated = false;
+  if (_callback != NULL) _callback(this, status, _callbackArg);
+  return status;
+}
+
+
+void DHT20::_delay(uint32_t ms)
+{
+  delay(ms);
+  _waitMicros += ms * 1000UL;
 }
 
 
@@ -316,23 +487,26 @@ bool DHT20::_resetRegister(uint8_t reg)
   _wire->write(reg);
   _wire->write(0x00);
   _wire->write(0x00);
+  _transactions++;
   if (_wire->endTransmission() != 0) return false;
-  delay(5);
+  _delay(5);
 
   int bytes = _wire->requestFrom(DHT20_ADDRESS, (uint8_t)3);
+  _transactions++;
   for (int i = 0; i < bytes; i++)
   {
     value[i] = _wire->read();
     //  Serial.println(value[i], HEX);
   }
-  delay(10);
+  _delay(10);
 
   _wire->beginTransmission(DHT20_ADDRESS);
   _wire->write(0xB0 | reg);
   _wire->write(value[1]);
   _wire->write(value[2]);
+  _transactions++;
   if (_wire->endTransmission() != 0) return false;
-  delay(5);
+  _delay(5);
   return true;
 }
 
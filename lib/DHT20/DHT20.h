@@ -29,6 +29,24 @@
 #define DHT20_ERROR_BYTES_ALL_ZERO          -13
 #define DHT20_ERROR_READ_TIMEOUT            -14
 #define DHT20_ERROR_LASTREAD                -15
+#define DHT20_ERROR_NOT_STARTED             -16
+
+//  poll() result while the conversion is still running
+#define DHT20_PENDING                        1
+
+//  datasheet: measurement takes ~80 ms
+#define DHT20_CONVERSION_TIME               80     //  milliseconds
+//  minimum time between two bus polls while still measuring
+#define DHT20_POLL_INTERVAL                 10     //  milliseconds
+//  poll() gives up after this
+#define DHT20_MEASURE_TIMEOUT               250    //  milliseconds
+
+
+class DHT20;
+
+//  called from poll() once the measurement is ready or failed
+//  status = DHT20_OK or DHT20_ERROR_*
+typedef void (*DHT20_callback)(DHT20 *sensor, int status, void *arg);
 
 
 class DHT20
@@ -56,12 +74,28 @@ public:
   int      convert();
 
 
+  //  NON-BLOCKING CALL  (new)
+  //  trigger acquisition, reset sequence only if not calibrated.
+  //  returns DHT20_OK or DHT20_ERROR_CONNECT.
+  int      startMeasurement();
+  //  no bus traffic before DHT20_CONVERSION_TIME has passed.
+  //  returns DHT20_PENDING, DHT20_OK (converted) or DHT20_ERROR_*
+  int      poll();
+  bool     isPending();
+  //  optional, NULL to disable.
+  void     setCallback(DHT20_callback callback, void *arg = NULL);
+
+
   //  SYNCHRONOUS CALL
   //  blocking read call to read + convert data
   int      read();
   //  access the converted temperature & humidity
+  //  float is computed on demand from the raw value.
   float    getHumidity();
   float    getTemperature();
+  //  integer only, no FPU: 0.01 %RH and 0.01 degC, offset included.
+  int32_t  getHumidityCenti();
+  int16_t  getTemperatureCenti();
 
 
   //  OFFSET  1st order adjustments
@@ -71,6 +105,16 @@ public:
   float    getTempOffset();
 
 
+  //  RAW 20 bit values of the last convert()
+  uint32_t getRawHumidity();
+  uint32_t getRawTemperature();
+  //  pure integer conversion, rounded half up
+  static int32_t humidityCenti(uint32_t raw);
+  static int16_t temperatureCenti(uint32_t raw);
+  //  CRC8 of the frame, polynomial 0x31, init 0xFF
+  static uint8_t crc8(const uint8_t *ptr, uint8_t len);
+
+
   //  READ STATUS
   uint8_t  readStatus();
   //  3 wrapper functions around readStatus()
@@ -86,6 +130,14 @@ public:
   uint32_t lastRequest();
 
 
+  //  STATISTICS  (new)
+  //  I2C transactions (write or read) since begin / resetStatistics()
+  uint32_t getTransactions();
+  //  time spent in delay() or blocking for the conversion
+  uint32_t getWaitMicros();
+  void     resetStatistics();
+
+
   //  RESET  (new since 0.1.4)
   //  use with care
   //  returns number of registers reset => must be 3
@@ -95,20 +147,35 @@ public:
   //  See datasheet 7.4 Sensor Reading Process, point 1
   //  use with care
   uint8_t  resetSensor();
+  //  cached status, cleared at power-on and after every error.
+  //  requestData() only resets the sensor when this is false.
+  bool     isCalibratedCached();
 
 
 private:
-  float    _humidity;
-  float    _temperature;
+  uint32_t _rawHumidity;
+  uint32_t _rawTemperature;
   float    _humOffset;
   float    _tempOffset;
+  int16_t  _humOffsetCenti;
+  int16_t  _tempOffsetCenti;
 
   uint8_t  _status;
   uint32_t _lastRequest;
   uint32_t _lastRead;
   uint8_t  _bits[7];
 
-  uint8_t  _crc8(uint8_t *ptr, uint8_t len);
+  bool     _calibrated;
+  bool     _measuring;
+  uint32_t _lastPoll;
+  uint32_t _transactions;
+  uint32_t _waitMicros;
+
+  DHT20_callback _callback;
+  void *   _callbackArg;
+
+  int      _finish(int status);
+  void     _delay(uint32_t ms);
 
   //  use with care
   bool     _resetRegister(uint8_t reg);
@@ -0,0 +1,115 @@
+#include "LCD_Framebuffer.h"
+#include <string.h>
+
+LCD_Framebuffer::LCD_Framebuffer(LiquidCrystal_I2C &lcd, uint8_t cols, uint8_t rows) : _lcd(lcd)
+{
+	_cols = cols > LCD_FB_MAX_COLS ? LCD_FB_MAX_COLS : cols;
+	_rows = rows > LCD_FB_MAX_ROWS ? LCD_FB_MAX_ROWS : rows;
+	_lastCells = 0;
+	_lastMoves = 0;
+	_lastTransactions = 0;
+	// lcd.begin() leaves the display cleared
+	memset(_front, ' ', sizeof(_front));
+	memset(_stale, 0, sizeof(_stale));
+	clear();
+}
+
+void LCD_Framebuffer::clear() {
+	memset(_shadow, ' ', sizeof(_shadow));
+	_col = 0;
+	_row = 0;
+}
+
+void LCD_Framebuffer::setCursor(uint8_t col, uint8_t row) {
+	_col = col;
+	_row = row;
+}
+
+size_t LCD_Framebuffer::write(uint8_t value) {
+	if (value == '\n') {
+		_col = 0;
+		_row++;
+		return 1;
+	}
+	if (value == '\r') {
+		return 1;
+	}
+	if (_col < _cols && _row < _rows) {
+		_shadow[_row * _cols + _col] = value;
+	}
+	_col++;
+	return 1;
+}
+
+uint8_t LCD_Framebuffer::charAt(uint8_t col, uint8_t row) {
+	if (col >= _cols || row >= _rows) {
+		return ' ';
+	}
+	return _shadow[row * _cols + col];
+}
+
+void LCD_Framebuffer::invalidate() {
+	memset(_stale, 0xFF, sizeof(_stale));
+}
+
+void LCD_Framebuffer::replaceChar(uint8_t from, uint8_t to) {
+	for (uint16_t i = 0; i < _cols * _rows; i++) {
+		if (_shadow[i] == from) {
+			_shadow[i] = to;
+		}
+	}
+}
+
+inline bool LCD_Framebuffer::dirty(uint16_t idx) {
+	return _shadow[idx] != _front[idx] || (_stale[idx >> 3] & (1 << (idx & 7)));
+}
+
+void LCD_Framebuffer::flush() {
+	uint32_t start = _lcd.getTransactions();
+	uint16_t cells = 0;
+	uint16_t moves = 0;
+
+	for (uint8_t row = 0; row < _rows; row++) {
+		uint16_t base = row * _cols;
+		uint8_t col = 0;
+		while (col < _cols) {
+			if (!dirty(base + col)) {
+				col++;
+				continue;
+			}
+			// extend the run over short unchanged gaps
+			uint8_t end = col;
+			for (uint8_t j = col + 1; j < _cols && j - end <= LCD_FB_MERGE_GAP + 1; j++) {
+				if (dirty(base + j)) {
+					end = j;
+				}
+			}
+			// gaps > LCD_FB_MERGE_GAP split runs, so every run needs its own setCursor;
+			// batched transport sends both in one transmission
+			_lcd.writeAt(col, row, &_shadow[base + col], end - col + 1);
+			moves++;
+			for (uint8_t j = col; j <= end; j++) {
+				_front[base + j] = _shadow[base + j];
+				_stale[(base + j) >> 3] &= ~(1 << ((base + j) & 7));
+			}
+			cells += end - col + 1;
+			col = end + 1;
+		}
+	}
+
+	_lastCells = cells;
+	_lastMoves = moves;
+	_lastTransactions = _lcd.getTransactions() - start;
+}
+
+uint16_t LCD_Framebuffer::lastFlushCells() {
+	return _lastCells;
+}
+
+uint16_t LCD_Framebuffer::lastFlushCursorMoves() {
+	return _lastMoves;
+}
+
+uint32_t LCD_Framebuffer::lastFlushTransactions() {
+	return _lastTransactions;
+}
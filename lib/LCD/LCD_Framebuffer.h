@@ -0,0 +1,85 @@
+#ifndef FDB_LCD_FRAMEBUFFER_H
+#define FDB_LCD_FRAMEBUFFER_H
+
+#include <inttypes.h>
+#include <Print.h>
+#include "LiquidCrystal_I2C.h"
+
+#define LCD_FB_MAX_COLS 20
+#define LCD_FB_MAX_ROWS 4
+// setCursor costs one command byte, so an unchanged gap up to this size is rewritten instead
+#define LCD_FB_MERGE_GAP 1
+
+/**
+ * Shadow framebuffer on top of LiquidCrystal_I2C.
+ *
+ * print/write only touch RAM. flush() compares the RAM copy with what the display
+ * currently shows and sends the minimal set of setCursor + data runs, so static labels
+ * cost nothing after the first frame.
+ */
+class LCD_Framebuffer : public Print {
+public:
+	/**
+	 * @param lcd	Display driver, begin() must already have been called (display cleared).
+	 * @param cols	Number of columns, at most LCD_FB_MAX_COLS.
+	 * @param rows	Number of rows, at most LCD_FB_MAX_ROWS.
+	 */
+	LCD_Framebuffer(LiquidCrystal_I2C &lcd, uint8_t cols, uint8_t rows);
+
+	/**
+	 * Fill the RAM copy with spaces and move the cursor home. Nothing is sent.
+	 */
+	void clear();
+
+	/**
+	 * Position for the next print/write into RAM. '\n' moves to the start of the next row,
+	 * characters past the last column are clipped.
+	 */
+	void setCursor(uint8_t col, uint8_t row);
+	virtual size_t write(uint8_t);
+	using Print::write;
+
+	uint8_t charAt(uint8_t col, uint8_t row);
+
+	/**
+	 * Forget what the display shows, e.g. after lcd.begin() or lcd.clear() was used directly.
+	 * The next flush() redraws every cell.
+	 */
+	void invalidate();
+
+	/**
+	 * Replace `from` with `to` in the RAM copy. For a redefined custom character: the display
+	 * shows CGRAM live, so rewriting the same code would not bring the old bitmap back;
+	 * cells still holding it are changed instead (e.g. to ' ') and sent by the next flush().
+	 */
+	void replaceChar(uint8_t from, uint8_t to);
+
+	/**
+	 * Send the changed cells to the display (Print::flush()).
+	 */
+	virtual void flush();
+
+	/**
+	 * Cost of the last flush(): cells written, setCursor commands and I2C transactions.
+	 */
+	uint16_t lastFlushCells();
+	uint16_t lastFlushCursorMoves();
+	uint32_t lastFlushTransactions();
+
+private:
+	bool dirty(uint16_t idx);
+
+	LiquidCrystal_I2C &_lcd;
+	uint8_t _cols;
+	uint8_t _rows;
+	uint8_t _col;
+	uint8_t _row;
+	uint8_t _shadow[LCD_FB_MAX_COLS * LCD_FB_MAX_ROWS];
+	uint8_t _front[LCD_FB_MAX_COLS * LCD_FB_MAX_ROWS];
+	uint8_t _stale[(LCD_FB_MAX_COLS * LCD_FB_MAX_ROWS + 7) / 8];
+	uint16_t _lastCells;
+	uint16_t _lastMoves;
+	uint32_t _lastTransactions;
+};
+
+#endif // FDB_LCD_FRAMEBUFFER_H
@@ -0,0 +1,84 @@
+#include "LCD_GlyphCache.h"
+#include <string.h>
+
+LCD_GlyphCache::LCD_GlyphCache(LiquidCrystal_I2C &lcd, LCD_Framebuffer *fb) : _lcd(lcd), _fb(fb)
+{
+	_hits = 0;
+	_loads = 0;
+	_evictions = 0;
+	reset();
+}
+
+void LCD_GlyphCache::reset() {
+	memset(_slots, 0, sizeof(_slots));
+	_tick = 0;
+	_frameStart = 1;
+}
+
+void LCD_GlyphCache::beginFrame() {
+	_frameStart = ++_tick;
+}
+
+// FNV-1a over the 5 used bits of each row
+uint32_t LCD_GlyphCache::hash(const uint8_t glyph[LCD_GLYPH_ROWS]) {
+	uint32_t h = 2166136261UL;
+	for (uint8_t i = 0; i < LCD_GLYPH_ROWS; i++) {
+		h ^= glyph[i] & 0x1F;
+		h *= 16777619UL;
+	}
+	return h;
+}
+
+int8_t LCD_GlyphCache::acquire(const uint8_t glyph[LCD_GLYPH_ROWS]) {
+	uint8_t rows[LCD_GLYPH_ROWS];
+	for (uint8_t i = 0; i < LCD_GLYPH_ROWS; i++) {
+		rows[i] = glyph[i] & 0x1F;
+	}
+	uint32_t h = hash(rows);
+	int8_t victim = -1;
+
+	for (uint8_t i = 0; i < LCD_GLYPH_SLOTS; i++) {
+		Slot &s = _slots[i];
+		if (s.used && s.hash == h && memcmp(s.rows, rows, LCD_GLYPH_ROWS) == 0) {
+			s.lastUse = ++_tick;
+			_hits++;
+			return i;
+		}
+		// free slot first, then least recently used
+		if (victim < 0 || (!s.used && _slots[victim].used) ||
+			(s.used == _slots[victim].used && s.lastUse < _slots[victim].lastUse)) {
+			victim = i;
+		}
+	}
+
+	Slot &s = _slots[victim];
+	if (s.used && s.lastUse >= _frameStart) {
+		return -1;	// every slot is on screen in this frame
+	}
+	if (s.used) {
+		_evictions++;
+		if (_fb != NULL) {
+			// not acquired in this frame, so any cell still holding it is left over
+			_fb->replaceChar(victim, ' ');
+		}
+	}
+	s.hash = h;
+	s.used = true;
+	s.lastUse = ++_tick;
+	memcpy(s.rows, rows, LCD_GLYPH_ROWS);
+	_lcd.createChar(victim, s.rows);
+	_loads++;
+	return victim;
+}
+
+uint32_t LCD_GlyphCache::hits() {
+	return _hits;
+}
+
+uint32_t LCD_GlyphCache::loads() {
+	return _loads;
+}
+
+uint32_t LCD_GlyphCache::evictions() {
+	return _evictions;
+}
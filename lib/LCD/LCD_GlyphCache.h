@@ -0,0 +1,72 @@
+#ifndef FDB_LCD_GLYPH_CACHE_H
+#define FDB_LCD_GLYPH_CACHE_H
+
+#include <inttypes.h>
+#include "LiquidCrystal_I2C.h"
+#include "LCD_Framebuffer.h"
+
+#define LCD_GLYPH_SLOTS 8
+#define LCD_GLYPH_ROWS 8
+
+/**
+ * Allocator for the 8 CGRAM custom character slots.
+ *
+ * Glyphs are identified by content (5x8 bitmap), so callers just ask for a bitmap every
+ * frame and get back the character code to print. A glyph that is already loaded costs
+ * nothing; otherwise a free slot, or the least recently used one, is rewritten. The display
+ * shows the new bitmap at once in every cell holding that code, so cells of the framebuffer
+ * that still hold it (drawn in an earlier frame) are blanked.
+ *
+ * createChar() leaves the address counter in CGRAM, so text must be positioned with
+ * setCursor()/writeAt() afterwards (LCD_Framebuffer::flush() always does).
+ */
+class LCD_GlyphCache {
+public:
+	/**
+	 * @param lcd	Display driver.
+	 * @param fb	Optional framebuffer to blank stale cells in when a slot is reassigned.
+	 */
+	LCD_GlyphCache(LiquidCrystal_I2C &lcd, LCD_Framebuffer *fb = NULL);
+
+	/**
+	 * Start of a new frame: glyphs acquired from here on are pinned until the next
+	 * beginFrame(), so one frame can never evict its own glyphs.
+	 */
+	void beginFrame();
+
+	/**
+	 * Character code (0-7) showing `glyph`, loading it into CGRAM if needed.
+	 * Returns -1 if all 8 slots are pinned by the current frame.
+	 */
+	int8_t acquire(const uint8_t glyph[LCD_GLYPH_ROWS]);
+
+	/**
+	 * Forget the CGRAM content, e.g. after lcd.begin().
+	 */
+	void reset();
+
+	uint32_t hits();
+	uint32_t loads();
+	uint32_t evictions();
+
+	static uint32_t hash(const uint8_t glyph[LCD_GLYPH_ROWS]);
+
+private:
+	struct Slot {
+		uint32_t hash;
+		uint32_t lastUse;
+		uint8_t rows[LCD_GLYPH_ROWS];
+		bool used;
+	};
+
+	LiquidCrystal_I2C &_lcd;
+	LCD_Framebuffer *_fb;
+	Slot _slots[LCD_GLYPH_SLOTS];
+	uint32_t _tick;
+	uint32_t _frameStart;
+	uint32_t _hits;
+	uint32_t _loads;
+	uint32_t _evictions;
+};
+
+#endif // FDB_LCD_GLYPH_CACHE_H
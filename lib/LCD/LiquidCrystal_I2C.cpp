@@ -3,6 +3,15 @@
 #include <Arduino.h>
 #include <Wire.h>
 
+// Bytes per transmission in batched mode (ESP32 Wire buffer is 128, AVR 32)
+#ifdef I2C_BUFFER_LENGTH
+#define LCD_BATCH_BYTES I2C_BUFFER_LENGTH
+#else
+#define LCD_BATCH_BYTES 32
+#endif
+// Expander bytes per nibble: data, data|En, data (setup / pulse / hold)
+#define LCD_NIBBLE_BYTES 3
+
 // When the display powers up, it is configured as follows:
 //
 // 1. Display clear
@@ -29,10 +38,16 @@ LiquidCrystal_I2C::LiquidCrystal_I2C(uint8_t lcd_addr, uint8_t lcd_cols, uint8_t
 	_rows = lcd_rows;
 	_charsize = charsize;
 	_backlightval = LCD_BACKLIGHT;
+	_batch = true;
+	_transactions = 0;
+	_waitMicros = 0;
 }
 
 void LiquidCrystal_I2C::begin() {
 	Wire.begin();
+	resetStatistics();
+	// the driver may have been created before Wire.setClock()
+	setBatching(_batch);
 	_displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
 
 	if (_rows > 1) {
@@ -59,15 +74,15 @@ void LiquidCrystal_I2C::begin() {
 
 	// we start in 8bit mode, try to set 4 bit mode
 	write4bits(0x03 << 4);
-	delayMicroseconds(4500); // wait min 4.1ms
+	waitMicros(4500); // wait min 4.1ms
 
 	// second try
 	write4bits(0x03 << 4);
-	delayMicroseconds(4500); // wait min 4.1ms
+	waitMicros(4500); // wait min 4.1ms
 
 	// third go!
 	write4bits(0x03 << 4);
-	delayMicroseconds(150);
+	waitMicros(150);
 
 	// finally, set to 4-bit interface
 	write4bits(0x02 << 4);
@@ -94,20 +109,33 @@ void LiquidCrystal_I2C::begin() {
 /********** high level commands, for the user! */
 void LiquidCrystal_I2C::clear(){
 	command(LCD_CLEARDISPLAY);// clear display, set cursor position to zero
-	delayMicroseconds(2000);  // this command takes a long time!
+	waitMicros(2000);  // this command takes a long time!
 }
 
 void LiquidCrystal_I2C::home(){
 	command(LCD_RETURNHOME);  // set cursor position to zero
-	delayMicroseconds(2000);  // this command takes a long time!
+	waitMicros(2000);  // this command takes a long time!
 }
 
-void LiquidCrystal_I2C::setCursor(uint8_t col, uint8_t row){
-	int row_offsets[] = { 0x00, 0x40, 0x14, 0x54 };
+uint8_t LiquidCrystal_I2C::ddramAddress(uint8_t col, uint8_t row){
+	static const uint8_t row_offsets[] = { 0x00, 0x40, 0x14, 0x54 };
 	if (row > _rows) {
 		row = _rows-1;    // we count rows starting w/0
 	}
-	command(LCD_SETDDRAMADDR | (col + row_offsets[row]));
+	return LCD_SETDDRAMADDR | (col + row_offsets[row & 3]);
+}
+
+void LiquidCrystal_I2C::setCursor(uint8_t col, uint8_t row){
+	command(ddramAddress(col, row));
+}
+
+void LiquidCrystal_I2C::writeAt(uint8_t col, uint8_t row, const uint8_t *buffer, size_t size){
+	if (_batch) {
+		sendBatch(buffer, size, Rs, ddramAddress(col, row));
+		return;
+	}
+	setCursor(col, row);
+	write(buffer, size);
 }
 
 // Turn the display on/off (quickly)
@@ -176,6 +204,11 @@ void LiquidCrystal_I2C::noAutoscroll(void) {
 // with custom characters
 void LiquidCrystal_I2C::createChar(uint8_t location, uint8_t charmap[]) {
 	location &= 0x7; // we only have 8 locations 0-7
+	if (_batch) {
+		// address + 8 rows in one transmission
+		sendBatch(charmap, 8, Rs, LCD_SETCGRAMADDR | (location << 3));
+		return;
+	}
 	command(LCD_SETCGRAMADDR | (location << 3));
 	for (int i=0; i<8; i++) {
 		write(charmap[i]);
@@ -208,17 +241,78 @@ inline size_t LiquidCrystal_I2C::write(uint8_t value) {
 	return 1;
 }
 
+size_t LiquidCrystal_I2C::write(const uint8_t *buffer, size_t size) {
+	if (_batch) {
+		sendBatch(buffer, size, Rs, -1);
+		return size;
+	}
+	for (size_t i = 0; i < size; i++) {
+		send(buffer[i], Rs);
+	}
+	return size;
+}
+
+void LiquidCrystal_I2C::setBatching(bool enable) {
+#if defined(ESP32)
+	// no settle delays in batched mode, only safe while byte times cover them
+	if (Wire.getClock() > LCD_BATCH_MAX_CLOCK) {
+		enable = false;
+	}
+#endif
+	_batch = enable;
+}
+
+bool LiquidCrystal_I2C::getBatching() {
+	return _batch;
+}
+
 
 /************ low level data pushing commands **********/
 
 // write either command or data
 void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode) {
+	if (_batch) {
+		sendBatch(&value, 1, mode, -1);
+		return;
+	}
 	uint8_t highnib=value&0xf0;
 	uint8_t lownib=(value<<4)&0xf0;
 	write4bits((highnib)|mode);
 	write4bits((lownib)|mode);
 }
 
+// Batched: optional command byte (cmd >= 0) then `size` bytes with `mode`, split only
+// where the Wire buffer is full
+void LiquidCrystal_I2C::sendBatch(const uint8_t *data, size_t size, uint8_t mode, int16_t cmd) {
+	size_t i = 0;
+	bool pendingCmd = cmd >= 0;
+	while (pendingCmd || i < size) {
+		size_t queued = 0;
+		Wire.beginTransmission(_addr);
+		if (pendingCmd) {
+			queueNibble(cmd & 0xf0);
+			queueNibble((cmd << 4) & 0xf0);
+			queued += 2 * LCD_NIBBLE_BYTES;
+			pendingCmd = false;
+		}
+		while (i < size && queued + 2 * LCD_NIBBLE_BYTES <= LCD_BATCH_BYTES) {
+			queueNibble((data[i] & 0xf0) | mode);
+			queueNibble(((data[i] << 4) & 0xf0) | mode);
+			queued += 2 * LCD_NIBBLE_BYTES;
+			i++;
+		}
+		Wire.endTransmission();
+		_transactions++;
+	}
+}
+
+void LiquidCrystal_I2C::queueNibble(uint8_t value) {
+	value |= _backlightval;
+	Wire.write(value);
+	Wire.write(value | En);		// En high, at least one byte time (>450ns)
+	Wire.write(value);		// En low latches, data held for the next byte time
+}
+
 void LiquidCrystal_I2C::write4bits(uint8_t value) {
 	expanderWrite(value);
 	pulseEnable(value);
@@ -228,14 +322,20 @@ void LiquidCrystal_I2C::expanderWrite(uint8_t _data){
 	Wire.beginTransmission(_addr);
 	Wire.write((int)(_data) | _backlightval);
 	Wire.endTransmission();
+	_transactions++;
 }
 
 void LiquidCrystal_I2C::pulseEnable(uint8_t _data){
 	expanderWrite(_data | En);	// En high
-	delayMicroseconds(1);		// enable pulse must be >450ns
+	waitMicros(1);		// enable pulse must be >450ns
 
 	expanderWrite(_data & ~En);	// En low
-	delayMicroseconds(50);		// commands need > 37us to settle
+	waitMicros(50);		// commands need > 37us to settle
+}
+
+void LiquidCrystal_I2C::waitMicros(uint32_t us){
+	delayMicroseconds(us);
+	_waitMicros += us;
 }
 
 void LiquidCrystal_I2C::load_custom_character(uint8_t char_num, uint8_t *rows){
@@ -255,3 +355,16 @@ void LiquidCrystal_I2C::printstr(const char c[]){
 	//it's here so the user sketch doesn't have to be changed
 	print(c);
 }
+
+uint32_t LiquidCrystal_I2C::getTransactions(){
+	return _transactions;
+}
+
+uint32_t LiquidCrystal_I2C::getWaitMicros(){
+	return _waitMicros;
+}
+
+void LiquidCrystal_I2C::resetStatistics(){
+	_transactions = 0;
+	_waitMicros = 0;
+}
@@ -50,6 +50,9 @@
 #define Rw B00000010  // Read/Write bit
 #define Rs B00000001  // Register select bit
 
+// Highest bus clock for batched transport: two byte times must cover the 37us execution time
+#define LCD_BATCH_MAX_CLOCK 400000
+
 /**
  * This is the driver for the Liquid Crystal LCD displays that use the I2C bus.
  *
@@ -135,8 +138,26 @@ public:
 	void createChar(uint8_t, uint8_t[]);
 	void setCursor(uint8_t, uint8_t);
 	virtual size_t write(uint8_t);
+	virtual size_t write(const uint8_t *buffer, size_t size);
+	using Print::write;
 	void command(uint8_t);
 
+	/**
+	 * setCursor() followed by the characters, in batched mode sent in the same transmission(s).
+	 */
+	void writeAt(uint8_t col, uint8_t row, const uint8_t *buffer, size_t size);
+
+	/**
+	 * Batched transport (default on): the whole En/nibble sequence of a byte, or of a run of
+	 * bytes, is packed into one I2C transmission, as many as fit in the Wire buffer.
+	 * Enable pulse width and the 37us execution time are covered by the bus time of the
+	 * following expander bytes (22us each at 400kHz), so no delayMicroseconds is needed.
+	 * That only holds up to LCD_BATCH_MAX_CLOCK: above it setBatching(true) and begin()
+	 * leave batching off. Raising the clock after begin() is not detected.
+	 */
+	void setBatching(bool enable);
+	bool getBatching();
+
 	inline void blink_on() { blink(); }
 	inline void blink_off() { noBlink(); }
 	inline void cursor_on() { cursor(); }
@@ -147,11 +168,23 @@ public:
 	void load_custom_character(uint8_t char_num, uint8_t *rows);	// alias for createChar()
 	void printstr(const char[]);
 
+	/**
+	 * Bus statistics since begin() or resetStatistics(): number of I2C transactions sent
+	 * to the expander and microseconds spent in the enable / command settle delays.
+	 */
+	uint32_t getTransactions();
+	uint32_t getWaitMicros();
+	void resetStatistics();
+
 private:
 	void send(uint8_t, uint8_t);
+	void sendBatch(const uint8_t *, size_t, uint8_t, int16_t);
+	void queueNibble(uint8_t);
+	uint8_t ddramAddress(uint8_t, uint8_t);
 	void write4bits(uint8_t);
 	void expanderWrite(uint8_t);
 	void pulseEnable(uint8_t);
+	void waitMicros(uint32_t);
 	uint8_t _addr;
 	uint8_t _displayfunction;
 	uint8_t _displaycontrol;
@@ -160,6 +193,9 @@ private:
 	uint8_t _rows;
 	uint8_t _charsize;
 	uint8_t _backlightval;
+	bool _batch;
+	uint32_t _transactions;
+	uint32_t _waitMicros;
 };
 
 #endif // FDB_LIQUID_CRYSTAL_I2C_H
@@ -10,6 +10,7 @@
 
 PubSubClient::PubSubClient() {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     this->_client = NULL;
     this->stream = NULL;
     setCallback(NULL);
@@ -21,6 +22,7 @@ PubSubClient::PubSubClient() {
 
 PubSubClient::PubSubClient(Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setClient(client);
     this->stream = NULL;
     this->bufferSize = 0;
@@ -31,6 +33,7 @@ PubSubClient::PubSubClient(Client& client) {
 
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(addr, port);
     setClient(client);
     this->stream = NULL;
@@ -41,6 +44,7 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client) {
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(addr,port);
     setClient(client);
     setStream(stream);
@@ -51,6 +55,7 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, Client& client, Stream
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(addr, port);
     setCallback(callback);
     setClient(client);
@@ -62,6 +67,7 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATUR
 }
 PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(addr,port);
     setCallback(callback);
     setClient(client);
@@ -74,6 +80,7 @@ PubSubClient::PubSubClient(IPAddress addr, uint16_t port, MQTT_CALLBACK_SIGNATUR
 
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(ip, port);
     setClient(client);
     this->stream = NULL;
@@ -84,6 +91,7 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client) {
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(ip,port);
     setClient(client);
     setStream(stream);
@@ -94,6 +102,7 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, Client& client, Stream& s
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(ip, port);
     setCallback(callback);
     setClient(client);
@@ -105,6 +114,7 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE,
 }
 PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(ip,port);
     setCallback(callback);
     setClient(client);
@@ -117,6 +127,7 @@ PubSubClient::PubSubClient(uint8_t *ip, uint16_t port, MQTT_CALLBACK_SIGNATURE,
 
 PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(domain,port);
     setClient(client);
     this->stream = NULL;
@@ -127,6 +138,7 @@ PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client) {
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(domain,port);
     setClient(client);
     setStream(stream);
@@ -137,6 +149,7 @@ PubSubClient::PubSubClient(const char* domain, uint16_t port, Client& client, St
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(domain,port);
     setCallback(callback);
     setClient(client);
@@ -148,6 +161,7 @@ PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGN
 }
 PubSubClient::PubSubClient(const char* domain, uint16_t port, MQTT_CALLBACK_SIGNATURE, Client& client, Stream& stream) {
     this->_state = MQTT_DISCONNECTED;
+    this->rawCallback = NULL;
     setServer(domain,port);
     setCallback(callback);
     setClient(client);
@@ -309,6 +323,29 @@ boolean PubSubClient::readByte(uint8_t * result, uint16_t * index){
   return false;
 }
 
+// reads length bytes into result with bulk Client::read() calls
+boolean PubSubClient::readBytes(uint8_t * result, uint32_t length) {
+   uint32_t previousMillis = millis();
+   while (length > 0) {
+     int available = _client->available();
+     if (available > 0) {
+       int rc = _client->read(result, (uint32_t)available < length ? available : length);
+       if (rc > 0) {
+         result += rc;
+         length -= rc;
+         previousMillis = millis();
+         continue;
+       }
+     }
+     yield();
+     uint32_t currentMillis = millis();
+     if(currentMillis - previousMillis >= ((int32_t) this->socketTimeout * 1000)){
+       return false;
+     }
+   }
+   return true;
+}
+
 uint32_t PubSubClient::readPacket(uint8_t* lengthLength) {
     uint16_t len = 0;
     if(!readByte(this->buffer, &len)) return 0;
@@ -316,7 +353,7 @@ uint32_t PubSubClient::readPacket(uint8_t* lengthLength) {
     uint32_t multiplier = 1;
     uint32_t length = 0;
     uint8_t digit = 0;
-    uint16_t skip = 0;
+    uint32_t skip = 0;
     uint32_t start = 0;
 
     do {
@@ -343,25 +380,33 @@ uint32_t PubSubClient::readPacket(uint8_t* lengthLength) {
             // skip message id
             skip += 2;
         }
+        // body offset of the first payload byte
+        skip += 2;
     }
-    uint32_t idx = len;
-
-    for (uint32_t i = start;i<length;i++) {
-        if(!readByte(&digit)) return 0;
-        if (this->stream) {
-            if (isPublish && idx-*lengthLength-2>skip) {
-                this->stream->write(digit);
-            }
-        }
 
+    // Body: bulk reads straight into the buffer, whatever does not fit is drained in chunks
+    uint8_t chunk[MQTT_READ_CHUNK_SIZE];
+    for (uint32_t i = start; i < length; ) {
+        uint8_t* dest = chunk;
+        uint32_t n = length - i;
         if (len < this->bufferSize) {
-            this->buffer[len] = digit;
-            len++;
+            dest = this->buffer + len;
+            if (n > (uint32_t)(this->bufferSize - len)) n = this->bufferSize - len;
+        } else if (n > sizeof(chunk)) {
+            n = sizeof(chunk);
         }
-        idx++;
+        if(!readBytes(dest, n)) return 0;
+        if (this->stream && isPublish && i + n > skip) {
+            uint32_t from = i < skip ? skip - i : 0;
+            this->stream->write(dest + from, n - from);
+        }
+        if (dest != chunk) {
+            len += n;
+        }
+        i += n;
     }
 
-    if (!this->stream && idx > this->bufferSize) {
+    if (!this->stream && *lengthLength + 1 + length > this->bufferSize) {
         len = 0; // This will cause the packet to be ignored.
     }
     return len;
@@ -393,7 +438,26 @@ boolean PubSubClient::loop() {
                 lastInActivity = t;
                 uint8_t type = this->buffer[0]&0xF0;
                 if (type == MQTTPUBLISH) {
-                    if (callback) {
+                    if (rawCallback) {
+                        uint16_t tl = (this->buffer[llen+1]<<8)+this->buffer[llen+2]; /* topic length in bytes */
+                        const char *topic = (const char*) this->buffer+llen+3; /* not NUL-terminated */
+                        // msgId only present for QOS>0
+                        if ((this->buffer[0]&0x06) == MQTTQOS1) {
+                            msgId = (this->buffer[llen+3+tl]<<8)+this->buffer[llen+3+tl+1];
+                            payload = this->buffer+llen+3+tl+2;
+                            rawCallback(topic,tl,payload,len-llen-3-tl-2);
+
+                            this->buffer[0] = MQTTPUBACK;
+                            this->buffer[1] = 2;
+                            this->buffer[2] = (msgId >> 8);
+                            this->buffer[3] = (msgId & 0xFF);
+                            _client->write(this->buffer,4);
+                            lastOutActivity = t;
+                        } else {
+                            payload = this->buffer+llen+3+tl;
+                            rawCallback(topic,tl,payload,len-llen-3-tl);
+                        }
+                    } else if (callback) {
                         uint16_t tl = (this->buffer[llen+1]<<8)+this->buffer[llen+2]; /* topic length in bytes */
                         memmove(this->buffer+llen+2,this->buffer+llen+3,tl); /* move topic inside buffer 1 byte to front */
                         this->buffer[llen+2+tl] = 0; /* end the topic as a 'C' string with \x00 */
@@ -523,6 +587,61 @@ boolean PubSubClient::publish_P(const char* topic, const uint8_t* payload, unsig
     return (rc == expectedLength);
 }
 
+boolean PubSubClient::publishSegments(const char* topic, const MQTTSegment* segments, size_t count, boolean retained) {
+    if (connected()) {
+        size_t tlen = strnlen(topic, this->bufferSize);
+        if (this->bufferSize < MQTT_MAX_HEADER_SIZE + 2 + tlen) {
+            // Too long
+            return false;
+        }
+        uint32_t length = 2 + tlen;
+        for (size_t i = 0; i < count; i++) {
+            if (segments[i].length > MQTT_MAX_REMAINING_LENGTH - length) {
+                return false;
+            }
+            length += segments[i].length;
+        }
+
+        uint16_t pos = writeString(topic,this->buffer,MQTT_MAX_HEADER_SIZE);
+        uint8_t header = MQTTPUBLISH;
+        if (retained) {
+            header |= 1;
+        }
+        size_t hlen = buildHeader(header, this->buffer, length);
+
+        // Fill the rest of the buffer with payload, so header and topic never go out as a
+        // tiny TCP segment of their own (Nagle / delayed ACK stall). A payload that fits
+        // is sent in this single write; only what is left over is written segment by segment.
+        size_t i = 0;
+        size_t offset = 0;
+        while (i < count && pos < this->bufferSize) {
+            size_t n = segments[i].length - offset;
+            if (n > (size_t)(this->bufferSize - pos)) {
+                n = this->bufferSize - pos;
+            }
+            memcpy(this->buffer+pos, segments[i].data+offset, n);
+            pos += n;
+            offset += n;
+            if (offset == segments[i].length) {
+                i++;
+                offset = 0;
+            }
+        }
+        size_t expected = pos-(MQTT_MAX_HEADER_SIZE-hlen);
+        boolean result = (_client->write(this->buffer+(MQTT_MAX_HEADER_SIZE-hlen),expected) == expected);
+        for (; result && i < count; i++) {
+            size_t n = segments[i].length - offset;
+            if (n > 0) {
+                result = (_client->write(segments[i].data+offset,n) == n);
+            }
+            offset = 0;
+        }
+        lastOutActivity = millis();
+        return result;
+    }
+    return false;
+}
+
 boolean PubSubClient::beginPublish(const char* topic, unsigned int plength, boolean retained) {
     if (connected()) {
         // Send the header and variable length field
@@ -554,12 +673,12 @@ size_t PubSubClient::write(const uint8_t *buffer, size_t size) {
     return _client->write(buffer,size);
 }
 
-size_t PubSubClient::buildHeader(uint8_t header, uint8_t* buf, uint16_t length) {
+size_t PubSubClient::buildHeader(uint8_t header, uint8_t* buf, uint32_t length) {
     uint8_t lenBuf[4];
     uint8_t llen = 0;
     uint8_t digit;
     uint8_t pos = 0;
-    uint16_t len = length;
+    uint32_t len = length;
     do {
 
         digit = len  & 127; //digit = len %128
@@ -723,6 +842,11 @@ PubSubClient& PubSubClient::setCallback(MQTT_CALLBACK_SIGNATURE) {
     return *this;
 }
 
+PubSubClient& PubSubClient::setRawCallback(MQTT_RAW_CALLBACK_SIGNATURE) {
+    this->rawCallback = rawCallback;
+    return *this;
+}
+
 PubSubClient& PubSubClient::setClient(Client& client){
     this->_client = &client;
     return *this;
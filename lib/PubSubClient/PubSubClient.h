@@ -75,14 +75,30 @@
 
 // Maximum size of fixed header and variable length size header
 #define MQTT_MAX_HEADER_SIZE 5
+// Largest value the variable length field can encode (4 bytes)
+#define MQTT_MAX_REMAINING_LENGTH 268435455UL
 
 #if defined(ESP8266) || defined(ESP32)
 #include <functional>
 #define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+#define MQTT_RAW_CALLBACK_SIGNATURE std::function<void(const char*, uint16_t, uint8_t*, unsigned int)> rawCallback
 #else
 #define MQTT_CALLBACK_SIGNATURE void (*callback)(char*, uint8_t*, unsigned int)
+#define MQTT_RAW_CALLBACK_SIGNATURE void (*rawCallback)(const char*, uint16_t, uint8_t*, unsigned int)
 #endif
 
+// MQTT_READ_CHUNK_SIZE : bytes drained per Client::read() once an inbound packet
+//  no longer fits in the buffer (discarded, or only passed to the Stream)
+#ifndef MQTT_READ_CHUNK_SIZE
+#define MQTT_READ_CHUNK_SIZE 64
+#endif
+
+// One piece of a publishSegments() payload, written to the Client as-is
+struct MQTTSegment {
+    const uint8_t* data;
+    size_t length;
+};
+
 #define CHECK_STRING_LENGTH(l,s) if (l+2+strnlen(s, this->bufferSize) > this->bufferSize) {_client->stop();return false;}
 
 class PubSubClient : public Print {
@@ -97,16 +113,18 @@ private:
    unsigned long lastInActivity;
    bool pingOutstanding;
    MQTT_CALLBACK_SIGNATURE;
+   MQTT_RAW_CALLBACK_SIGNATURE;
    uint32_t readPacket(uint8_t*);
    boolean readByte(uint8_t * result);
    boolean readByte(uint8_t * result, uint16_t * index);
+   boolean readBytes(uint8_t * result, uint32_t length);
    boolean write(uint8_t header, uint8_t* buf, uint16_t length);
    uint16_t writeString(const char* string, uint8_t* buf, uint16_t pos);
    // Build up the header ready to send
    // Returns the size of the header
    // Note: the header is built at the end of the first MQTT_MAX_HEADER_SIZE bytes, so will start
    //       (MQTT_MAX_HEADER_SIZE - <returned size>) bytes into the buffer
-   size_t buildHeader(uint8_t header, uint8_t* buf, uint16_t length);
+   size_t buildHeader(uint8_t header, uint8_t* buf, uint32_t length);
    IPAddress ip;
    const char* domain;
    uint16_t port;
@@ -134,6 +152,10 @@ public:
    PubSubClient& setServer(uint8_t * ip, uint16_t port);
    PubSubClient& setServer(const char * domain, uint16_t port);
    PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE);
+   // Alternative callback without copying: (topic, topic length, payload, payload length).
+   // The topic points into the receive buffer and is NOT NUL-terminated.
+   // Takes precedence over setCallback() when set.
+   PubSubClient& setRawCallback(MQTT_RAW_CALLBACK_SIGNATURE);
    PubSubClient& setClient(Client& client);
    PubSubClient& setStream(Stream& stream);
    PubSubClient& setKeepAlive(uint16_t keepAlive);
@@ -154,6 +176,12 @@ public:
    boolean publish(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained);
    boolean publish_P(const char* topic, const char* payload, boolean retained);
    boolean publish_P(const char* topic, const uint8_t * payload, unsigned int plength, boolean retained);
+   // Publish a payload made of count segments, in order.
+   // The segments are copied behind the header and topic into the buffer (it must hold the
+   // topic + 7 bytes) and sent in one write when they fit; whatever does not fit is handed
+   // straight to the Client, so the payload size is not limited by the buffer size.
+   // Returns 1 if the whole packet was written, 0 if there was an error
+   boolean publishSegments(const char* topic, const MQTTSegment* segments, size_t count, boolean retained);
    // Start to publish a message.
    // This API:
    //   beginPublish(...)
@@ -31,6 +31,10 @@ uint16_t Arduino_MQTT_Client::get_buffer_size() {
     return m_mqtt_client.getBufferSize();
 }
 
+size_t Arduino_MQTT_Client::get_max_publish_size() {
+    return MQTT_MAX_REMAINING_LENGTH;
+}
+
 void Arduino_MQTT_Client::set_server(const char *domain, const uint16_t& port) {
     m_mqtt_client.setServer(domain, port);
 }
@@ -48,7 +52,8 @@ bool Arduino_MQTT_Client::loop() {
 }
 
 bool Arduino_MQTT_Client::publish(const char *topic, const uint8_t *payload, const size_t& length) {
-    return m_mqtt_client.publish(topic, payload, length, false);
+    const MQTTSegment segment = { payload, length };
+    return m_mqtt_client.publishSegments(topic, &segment, 1U, false);
 }
 
 bool Arduino_MQTT_Client::subscribe(const char *topic) {
@@ -33,6 +33,10 @@ class Arduino_MQTT_Client : public IMQTT_Client {
 
     uint16_t get_buffer_size() override;
 
+    /// @brief Payloads are written straight to the transport client with PubSubClient::publishSegments(),
+    /// so only the topic has to fit into the internal buffer
+    size_t get_max_publish_size() override;
+
     void set_server(const char *domain, const uint16_t& port) override;
 
     bool connect(const char *client_id, const char *user_name, const char *password) override;
@@ -59,6 +59,13 @@ class IMQTT_Client {
     /// @return Internal size of the buffer
     virtual uint16_t get_buffer_size() = 0;
 
+    /// @brief Gets the biggest payload that can be sent with a single call to publish(),
+    /// defaults to the internal buffer size for clients that copy the payload into that buffer before sending it
+    /// @return Maximum payload size in bytes
+    virtual size_t get_max_publish_size() {
+        return get_buffer_size();
+    }
+
     /// @brief Configures the server and port that the client should connect to MQTT over,
     /// should be called atleast once before calling connect() so it is clear which server to connect too
     /// @param domain Server instance name the client should connect too
@@ -498,7 +498,7 @@ class ThingsBoardSized {
 #if THINGSBOARD_ENABLE_STREAM_UTILS
       // Check if the size of the given message would be too big for the actual client,
       // if it is utilize the serialize json work around, so that the internal client buffer can be circumvented
-      if (m_client.get_buffer_size() < jsonSize)  {
+      if (m_client.get_max_publish_size() < jsonSize)  {
 #if THINGSBOARD_ENABLE_DEBUG
         char message[JSON_STRING_SIZE(strlen(SEND_MESSAGE)) + JSON_STRING_SIZE(strlen(topic)) + JSON_STRING_SIZE(strlen(SEND_SERIALIZED))];
         snprintf_P(message, sizeof(message), SEND_MESSAGE, topic, SEND_SERIALIZED);
@@ -544,7 +544,7 @@ class ThingsBoardSized {
         return false;
       }
 
-      const uint16_t& currentBufferSize = m_client.get_buffer_size();
+      const size_t currentBufferSize = m_client.get_max_publish_size();
       const size_t jsonSize = strlen(json);
 
       if (currentBufferSize < jsonSize) {
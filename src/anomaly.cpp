@@ -0,0 +1,151 @@
+#include "anomaly.h"
+#include "tiny_nn.h"
+#include "console.h"
+
+// Model nho, trong so viet tay thay vi train (cung layout voi ban export tu TFLite neu can thay):
+//   conv1d 2->8, kernel 5: sai so du doan nhan qua (4*x[t] - 4 mau truoc) va do doc [-2..2],
+//   moi loai tach +/- de ReLU giu ca hai chieu; maxpool 4 buoc moi nhat; dense 8->1.
+static const int8_t convWeights[ANOMALY_FEATURES][ANOMALY_KERNEL][ANOMALY_CHANNELS] = {
+    { { -1, 0 }, { -1, 0 }, { -1, 0 }, { -1, 0 }, {  4, 0 } },     // nhiet do nhay len
+    { {  1, 0 }, {  1, 0 }, {  1, 0 }, {  1, 0 }, { -4, 0 } },     // nhiet do tut xuong
+    { { 0, -1 }, { 0, -1 }, { 0, -1 }, { 0, -1 }, { 0,  4 } },     // do am nhay len
+    { { 0,  1 }, { 0,  1 }, { 0,  1 }, { 0,  1 }, { 0, -4 } },     // do am tut xuong
+    { { -2, 0 }, { -1, 0 }, {  0, 0 }, {  1, 0 }, {  2, 0 } },     // nhiet do tang nhanh
+    { {  2, 0 }, {  1, 0 }, {  0, 0 }, { -1, 0 }, { -2, 0 } },     // nhiet do giam nhanh
+    { { 0, -2 }, { 0, -1 }, { 0,  0 }, { 0,  1 }, { 0,  2 } },     // do am tang nhanh
+    { { 0,  2 }, { 0,  1 }, { 0,  0 }, { 0, -1 }, { 0, -2 } },     // do am giam nhanh
+};
+
+// Sai so du doan /4 -> don vi input; do doc /10 (13/128) -> LSB moi mau
+static const nn_requant_t convRequant[ANOMALY_FEATURES] = {
+    { 1, 2 }, { 1, 2 }, { 1, 2 }, { 1, 2 },
+    { 13, 7 }, { 13, 7 }, { 13, 7 }, { 13, 7 },
+};
+
+// 0.5 °C hoac 2 %RH nhay dot ngot ~ nguong 64
+static const int8_t denseWeights[ANOMALY_FEATURES] = { 6, 6, 8, 8, 6, 6, 4, 4 };
+static const nn_requant_t denseRequant = { 1, 0 };
+
+#define CONV_STEPS  (ANOMALY_WINDOW - ANOMALY_KERNEL + 1)
+
+// Arena tinh: [input | conv out | pooled]. Chi mot inference tai mot thoi diem (task power).
+static int8_t arena[ANOMALY_ARENA_BYTES];
+static int8_t *const arenaInput = arena;
+static int8_t *const arenaConv = arena + ANOMALY_WINDOW * ANOMALY_CHANNELS;
+static int8_t *const arenaPool = arenaConv + CONV_STEPS * ANOMALY_FEATURES;
+static_assert(ANOMALY_WINDOW * ANOMALY_CHANNELS + CONV_STEPS * ANOMALY_FEATURES + ANOMALY_FEATURES
+              <= ANOMALY_ARENA_BYTES, "anomaly arena too small");
+
+static uint8_t lastScore = 0;
+static uint32_t lastCycles = 0;
+
+void anomaly_init(anomaly_state_t *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+static int8_t quantize(int32_t centi, int32_t mean, int32_t lsb) {
+    int32_t d = centi - mean;
+    int32_t q = d >= 0 ? (d + lsb / 2) / lsb : -((-d + lsb / 2) / lsb);
+    if (q > 127) return 127;
+    if (q < -127) return -127;
+    return (int8_t)q;
+}
+
+void anomaly_quantize(const anomaly_state_t *s, int8_t *input) {
+    uint8_t oldest = (s->head + ANOMALY_WINDOW - s->count) % ANOMALY_WINDOW;
+    int32_t tempSum = 0, humiSum = 0;
+
+    for (uint8_t i = 0; i < s->count; i++) {
+        uint8_t idx = (oldest + i) % ANOMALY_WINDOW;
+        tempSum += s->temp[idx];
+        humiSum += s->humi[idx];
+    }
+    int32_t tempMean = tempSum / s->count;
+    int32_t humiMean = humiSum / s->count;
+
+    // Cua so chua day: lap lai mau cu nhat o dau (tin hieu phang, khong tao gai gia)
+    uint8_t pad = ANOMALY_WINDOW - s->count;
+    for (uint8_t i = 0; i < ANOMALY_WINDOW; i++) {
+        uint8_t idx = (oldest + (i < pad ? 0 : i - pad)) % ANOMALY_WINDOW;
+        input[i * ANOMALY_CHANNELS]     = quantize(s->temp[idx], tempMean, ANOMALY_TEMP_LSB_CENTI);
+        input[i * ANOMALY_CHANNELS + 1] = quantize(s->humi[idx], humiMean, ANOMALY_HUMI_LSB_CENTI);
+    }
+}
+
+int8_t anomaly_infer(const int8_t *input) {
+    int8_t score;
+    nn_conv1d_s8(input, ANOMALY_WINDOW, ANOMALY_CHANNELS, &convWeights[0][0][0], NULL,
+                 ANOMALY_FEATURES, ANOMALY_KERNEL, convRequant, true, arenaConv);
+    nn_maxpool_tail_s8(arenaConv, CONV_STEPS, ANOMALY_FEATURES, ANOMALY_POOL_TAIL, arenaPool);
+    nn_dense_s8(arenaPool, ANOMALY_FEATURES, denseWeights, NULL, 1, &denseRequant, true, &score);
+    return score;
+}
+
+static void push_history(anomaly_state_t *s, int16_t temp_centi, int16_t humi_centi) {
+    s->temp[s->head] = temp_centi;
+    s->humi[s->head] = humi_centi;
+    s->head = (s->head + 1) % ANOMALY_WINDOW;
+    if (s->count < ANOMALY_WINDOW) s->count++;
+}
+
+uint8_t anomaly_feed(anomaly_state_t *s, int16_t temp_centi, int16_t humi_centi) {
+    push_history(s, temp_centi, humi_centi);
+    if (s->count < ANOMALY_MIN_SAMPLES) return 0;
+
+    uint32_t c0 = ESP.getCycleCount();
+    anomaly_quantize(s, arenaInput);
+    uint8_t score = (uint8_t)anomaly_infer(arenaInput);
+    lastCycles = ESP.getCycleCount() - c0;
+    lastScore = score;
+
+    s->lastScore = score;
+    if (score > s->maxScore) s->maxScore = score;
+    s->runs++;
+    if (score >= ANOMALY_THRESHOLD) s->flagged++;
+    return score;
+}
+
+size_t anomaly_format_json(anomaly_state_t *s, char *out, size_t cap) {
+    if (s->runs == 0) return 0;
+    int n = snprintf(out, cap, "{\"anomaly_score\":%u,\"anomaly_max\":%u,\"anomaly_count\":%u}",
+                     (unsigned)s->lastScore, (unsigned)s->maxScore, (unsigned)s->flagged);
+    if (n < 0 || (size_t)n >= cap) return 0;
+    s->maxScore = 0;
+    s->runs = 0;
+    s->flagged = 0;
+    return n;
+}
+
+// Benchmark tren cua so tong hop co mot gai nhiet do 1 °C o mau cuoi.
+// Chi nap lich su, khong qua anomaly_feed, de khong de len lastScore/lastCycles cua mau that.
+static void cmd_ai(int argc, char *argv[]) {
+    const int iterations = 1000;
+    static anomaly_state_t bench;
+    uint32_t cycles = 0;
+    int8_t score = 0;
+
+    anomaly_init(&bench);
+    for (uint8_t i = 0; i < ANOMALY_WINDOW; i++) {
+        push_history(&bench, 2500 + (i == ANOMALY_WINDOW - 1 ? 100 : 0), 6000);
+    }
+    for (int i = 0; i < iterations; i++) {
+        uint32_t c0 = ESP.getCycleCount();
+        anomaly_quantize(&bench, arenaInput);
+        score = anomaly_infer(arenaInput);
+        cycles += ESP.getCycleCount() - c0;
+    }
+
+    Serial.printf("Last score %u (threshold %u), last inference %lu cycles\n",
+                  (unsigned)lastScore, ANOMALY_THRESHOLD, (unsigned long)lastCycles);
+    Serial.printf("Bench: %lu cycles/inference (%lu us), spike score %d, arena %u B\n",
+                  (unsigned long)(cycles / iterations),
+                  (unsigned long)(cycles / iterations / ESP.getCpuFreqMHz()), score,
+                  (unsigned)ANOMALY_ARENA_BYTES);
+    console_prompt();
+}
+
+static const console_cmd_t aiCommand = { "ai", "ai", "Anomaly score + inference benchmark", cmd_ai };
+
+void anomaly_begin() {
+    console_register(&aiCommand);
+}
@@ -0,0 +1,55 @@
+#include "boot_profiler.h"
+#include "esp_sleep.h"
+
+typedef struct {
+    const char *name;
+    uint32_t    end_us;     // micros() khi phase ket thuc
+} boot_phase_t;
+
+static boot_phase_t phases[BOOT_MAX_PHASES];
+static uint8_t phaseCount = 0;
+
+void boot_profiler_mark(const char *name) {
+    if (phaseCount >= BOOT_MAX_PHASES) return;
+    phases[phaseCount].name = name;
+    phases[phaseCount].end_us = micros();
+    phaseCount++;
+}
+
+bool boot_is_fast_wake() {
+    return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER;
+}
+
+uint32_t boot_profiler_total_us() {
+    return phaseCount ? phases[phaseCount - 1].end_us : 0;
+}
+
+void boot_profiler_print() {
+    uint32_t prev = 0;
+    Serial.printf("\nBOOT PROFILE (%s):\n", boot_is_fast_wake() ? "fast wake" : "cold boot");
+    for (uint8_t i = 0; i < phaseCount; i++) {
+        Serial.printf("  %-10s %8lu us  (@%lu)\n", phases[i].name,
+                      (unsigned long)(phases[i].end_us - prev), (unsigned long)phases[i].end_us);
+        prev = phases[i].end_us;
+    }
+    Serial.printf("  %-10s %8lu us\n", "TOTAL", (unsigned long)boot_profiler_total_us());
+}
+
+size_t boot_profiler_format_json(char *out, size_t cap) {
+    uint32_t prev = 0;
+    int n = snprintf(out, cap, "{\"boot_us\":%lu,\"boot_fast\":%d",
+                     (unsigned long)boot_profiler_total_us(), boot_is_fast_wake() ? 1 : 0);
+    if (n < 0 || (size_t)n >= cap) return 0;
+    size_t pos = n;
+    for (uint8_t i = 0; i < phaseCount; i++) {
+        n = snprintf(out + pos, cap - pos, ",\"boot_%s\":%lu", phases[i].name,
+                     (unsigned long)(phases[i].end_us - prev));
+        if (n < 0 || (size_t)n >= cap - pos) return 0;
+        pos += n;
+        prev = phases[i].end_us;
+    }
+    if (pos + 2 > cap) return 0;
+    out[pos++] = '}';
+    out[pos] = '\0';
+    return pos;
+}
@@ -0,0 +1,201 @@
+#include "config_store.h"
+#include <LittleFS.h>
+#include <ArduinoJson.h>
+#include "freertos/semphr.h"
+#include "console.h"
+#include "event_bus.h"
+
+static const char *slotPath[2] = { "/config.a", "/config.b" };
+
+// Hai ban trong RAM: reader giu con tro cu van doc duoc du lieu on dinh
+// trong khi update ghi vao ban con lai roi moi doi `active`.
+static config_record_t records[2];
+static volatile uint8_t active = 0;
+static uint8_t newestSlot = 1;      // slot tren flash dang giu ban moi nhat
+static const config_backend_t *store = NULL;
+static SemaphoreHandle_t writeLock = NULL;
+
+static bool fs_read(uint8_t slot, void *buf, size_t len) {
+    File f = LittleFS.open(slotPath[slot], "r");
+    if (!f) return false;
+    size_t n = f.read((uint8_t *)buf, len);
+    f.close();
+    return n == len;
+}
+
+static bool fs_write(uint8_t slot, const void *buf, size_t len) {
+    File f = LittleFS.open(slotPath[slot], "w");
+    if (!f) return false;
+    size_t n = f.write((const uint8_t *)buf, len);
+    f.close();
+    return n == len;
+}
+
+static const config_backend_t littlefsBackend = { fs_read, fs_write };
+
+uint32_t config_crc32(const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t crc = 0xFFFFFFFFUL;
+    while (len--) {
+        crc ^= *p++;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static bool record_valid(const config_record_t *rec) {
+    return rec->magic == CONFIG_MAGIC &&
+           rec->version == CONFIG_VERSION &&
+           rec->length == sizeof(config_record_t) &&
+           rec->crc == config_crc32(rec, offsetof(config_record_t, crc));
+}
+
+static void record_defaults(config_record_t *rec) {
+    memset(rec, 0, sizeof(*rec));
+    rec->magic = CONFIG_MAGIC;
+    rec->version = CONFIG_VERSION;
+    rec->length = sizeof(config_record_t);
+    strncpy(rec->iot_server, CONFIG_DEFAULT_SERVER, CONFIG_SERVER_LEN - 1);
+    rec->iot_port = CONFIG_DEFAULT_PORT;
+}
+
+// Cung duong voi trang Setting: dong goi thanh {"page":"setting","value":{key:value}}
+static bool apply_setting(const char *key, const char *value) {
+    static const char *const keys[] = { "ssid", "password", "token", "server", "port" };
+    StaticJsonDocument<256> doc;
+    char json[CONSOLE_LINE_MAX + 48];
+
+    for (const char *k : keys) {
+        if (strcasecmp(key, k) != 0) continue;
+        doc["page"] = "setting";
+        doc["value"][k] = value;
+        size_t n = serializeJson(doc, json, sizeof(json));
+        return n > 0 && n < sizeof(json) && config_apply_json(json, n);
+    }
+    return false;
+}
+
+static void cmd_config(int argc, char *argv[]) {
+    if (argc >= 4 && strcasecmp(argv[1], "set") == 0) {
+        if (!apply_setting(argv[2], argv[3])) Serial.println("Key: ssid/password/token/server/port (save failed?)");
+    } else if (argc >= 3 && strcasecmp(argv[1], "json") == 0) {
+        // Message trang Setting, JSON lien khong khoang trang (nhu JSON.stringify)
+        if (!config_apply_json(argv[2], strlen(argv[2]))) Serial.println("Invalid setting message");
+    }
+
+    const config_record_t &r = records[active];
+    Serial.printf("Config gen %lu (slot %c)\n", (unsigned long)r.generation, 'A' + newestSlot);
+    Serial.printf("  ssid:   %s\n", r.wifi_ssid);
+    Serial.printf("  pass:   %s\n", r.wifi_pass[0] ? "********" : "");
+    Serial.printf("  token:  %s\n", r.iot_token[0] ? "********" : "");
+    Serial.printf("  server: %s:%u\n", r.iot_server, r.iot_port);
+    console_prompt();
+}
+
+static const console_cmd_t configCommand = {
+    "cfg", "cfg [set <key> <value> | json <msg>]", "Show / change stored configuration", cmd_config
+};
+
+bool config_store_begin(const config_backend_t *backend) {
+    store = backend ? backend : &littlefsBackend;
+    if (backend == NULL && !LittleFS.begin(true)) {
+        Serial.println("LittleFS mount failed");
+        store = NULL;
+    }
+    if (writeLock == NULL) writeLock = xSemaphoreCreateMutex();
+    console_register(&configCommand);
+
+    // Moi slot mot lan doc; chon slot hop le co generation lon nhat
+    config_record_t slot[2];
+    bool ok[2] = { false, false };
+    for (uint8_t i = 0; store && i < 2; i++) {
+        ok[i] = store->read(i, &slot[i], sizeof(slot[i])) && record_valid(&slot[i]);
+    }
+
+    int best = -1;
+    if (ok[0] && ok[1]) best = slot[1].generation > slot[0].generation ? 1 : 0;
+    else if (ok[0]) best = 0;
+    else if (ok[1]) best = 1;
+
+    if (best < 0) {
+        record_defaults(&records[0]);
+        newestSlot = 1;     // lan ghi dau tien vao slot A
+    } else {
+        records[0] = slot[best];
+        newestSlot = best;
+    }
+    active = 0;
+    return best >= 0;
+}
+
+const char *config_wifi_ssid()   { return records[active].wifi_ssid; }
+const char *config_wifi_pass()   { return records[active].wifi_pass; }
+const char *config_iot_token()   { return records[active].iot_token; }
+const char *config_iot_server()  { return records[active].iot_server; }
+uint16_t    config_iot_port()    { return records[active].iot_port; }
+uint32_t    config_generation()  { return records[active].generation; }
+
+bool config_store_update(const config_record_t *rec) {
+    if (store == NULL) return false;
+    xSemaphoreTake(writeLock, portMAX_DELAY);
+
+    uint8_t spare = active ^ 1;
+    config_record_t &next = records[spare];
+    next = *rec;
+    next.magic = CONFIG_MAGIC;
+    next.version = CONFIG_VERSION;
+    next.length = sizeof(config_record_t);
+    next.generation = records[active].generation + 1;
+    next.wifi_ssid[CONFIG_SSID_LEN - 1] = '\0';
+    next.wifi_pass[CONFIG_PASS_LEN - 1] = '\0';
+    next.iot_token[CONFIG_TOKEN_LEN - 1] = '\0';
+    next.iot_server[CONFIG_SERVER_LEN - 1] = '\0';
+    next.crc = config_crc32(&next, offsetof(config_record_t, crc));
+
+    // Ghi de slot cu hon: mat dien giua chung thi slot moi nhat van con nguyen
+    uint8_t target = newestSlot ^ 1;
+    bool ok = store->write(target, &next, sizeof(next));
+    if (ok) {
+        newestSlot = target;
+        active = spare;
+    }
+    xSemaphoreGive(writeLock);
+
+    if (ok) {
+        uint32_t gen = next.generation;
+        event_bus_publish(EVT_CONFIG_CHANGED, &gen, sizeof(gen));
+    }
+    return ok;
+}
+
+static void copy_field(char *dst, size_t cap, JsonVariantConst v) {
+    const char *s = v.as<const char *>();
+    if (s && *s) {
+        strncpy(dst, s, cap - 1);
+        dst[cap - 1] = '\0';
+    }
+}
+
+bool config_apply_json(const char *json, size_t len) {
+    StaticJsonDocument<512> doc;
+    if (deserializeJson(doc, json, len) != DeserializationError::Ok) return false;
+    if (strcmp(doc["page"] | "", "setting") != 0) return false;
+
+    JsonObjectConst value = doc["value"];
+    if (value.isNull()) return false;
+
+    config_record_t rec = records[active];
+    copy_field(rec.wifi_ssid, sizeof(rec.wifi_ssid), value["ssid"]);
+    copy_field(rec.wifi_pass, sizeof(rec.wifi_pass), value["password"]);
+    copy_field(rec.iot_token, sizeof(rec.iot_token), value["token"]);
+    copy_field(rec.iot_server, sizeof(rec.iot_server), value["server"]);
+
+    // form gui port dang chuoi, chap nhan ca so
+    JsonVariantConst port = value["port"];
+    long p = port.is<const char *>() ? atol(port.as<const char *>()) : port.as<long>();
+    if (p > 0 && p <= 65535) rec.iot_port = (uint16_t)p;
+
+    return config_store_update(&rec);
+}
@@ -0,0 +1,142 @@
+#include "console.h"
+#include <ctype.h>
+#include <errno.h>
+#include <strings.h>
+
+static const console_cmd_t *commands[CONSOLE_MAX_COMMANDS];
+static uint8_t commandCount = 0;
+static portMUX_TYPE commandsMux = portMUX_INITIALIZER_UNLOCKED;
+
+static char line[CONSOLE_LINE_MAX];
+static uint8_t lineLen = 0;
+static bool lineOverflow = false;
+static TaskHandle_t ownerTask = NULL;
+
+bool console_register(const console_cmd_t *cmd) {
+    bool ok = false;
+    portENTER_CRITICAL(&commandsMux);
+    if (commandCount < CONSOLE_MAX_COMMANDS) {
+        commands[commandCount++] = cmd;
+        ok = true;
+    }
+    portEXIT_CRITICAL(&commandsMux);
+    return ok;
+}
+
+#if ARDUINO_USB_CDC_ON_BOOT && ARDUINO_USB_MODE
+static void on_serial_rx(void *arg, esp_event_base_t base, int32_t id, void *data) {
+    if (ownerTask) xTaskNotify(ownerTask, CONSOLE_NOTIFY_BIT, eSetBits);
+}
+#else
+static void on_serial_rx() {
+    if (ownerTask) xTaskNotify(ownerTask, CONSOLE_NOTIFY_BIT, eSetBits);
+}
+#endif
+
+void console_begin(TaskHandle_t owner) {
+    ownerTask = owner;
+#if ARDUINO_USB_CDC_ON_BOOT && ARDUINO_USB_MODE
+    // Serial la HWCDC (USB Serial/JTAG)
+    Serial.onEvent(ARDUINO_HW_CDC_RX_EVENT, on_serial_rx);
+#else
+    Serial.onReceive(on_serial_rx);
+#endif
+}
+
+static const console_cmd_t *find_command(const char *name) {
+    for (uint8_t i = 0; i < commandCount; i++) {
+        if (strcasecmp(commands[i]->name, name) == 0) {
+            return commands[i];
+        }
+    }
+    return NULL;
+}
+
+// Tach token ngay trong line buffer bang cach thay khoang trang bang '\0'
+static int tokenize(char *buf, char *argv[]) {
+    int argc = 0;
+    char *p = buf;
+    while (*p && argc < CONSOLE_MAX_ARGS) {
+        while (*p == ' ' || *p == '\t') p++;
+        if (!*p) break;
+        argv[argc++] = p;
+        while (*p && *p != ' ' && *p != '\t') p++;
+        if (*p) *p++ = '\0';
+    }
+    return argc;
+}
+
+static void execute_line() {
+    char *argv[CONSOLE_MAX_ARGS];
+    line[lineLen] = '\0';
+    int argc = tokenize(line, argv);
+    if (argc == 0) {
+        console_prompt();
+        return;
+    }
+
+    const console_cmd_t *cmd = find_command(argv[0]);
+    if (cmd == NULL) {
+        Serial.printf("Unknown command: %s (M = menu)\n", argv[0]);
+        console_prompt();
+        return;
+    }
+    cmd->handler(argc, argv);
+}
+
+void console_process() {
+    int c;
+    while ((c = Serial.read()) >= 0) {
+        if (c >= 32 && c <= 126) Serial.print((char)c);
+
+        if (c == '\n' || c == '\r') {
+            if (lineLen > 0 || lineOverflow) {
+                Serial.println();
+                if (lineOverflow) {
+                    Serial.println("Line too long");
+                    console_prompt();
+                } else {
+                    execute_line();
+                }
+                lineLen = 0;
+                lineOverflow = false;
+            }
+        } else if (c == 8 || c == 127) {
+            if (lineLen > 0) {
+                lineLen--;
+                Serial.print("\b \b");
+            }
+        } else if (c >= 32 && c <= 126) {
+            if (lineLen < CONSOLE_LINE_MAX - 1) {
+                line[lineLen++] = (char)c;
+            } else {
+                lineOverflow = true;
+            }
+        }
+    }
+}
+
+void console_print_help() {
+    Serial.println("\nCOMMANDS:");
+    for (uint8_t i = 0; i < commandCount; i++) {
+        Serial.printf("  %-8s - %s\n", commands[i]->usage, commands[i]->help);
+    }
+}
+
+void console_prompt() {
+    Serial.print(CONSOLE_PROMPT);
+}
+
+// strtoul tu nhan dau '-' (dao dau, "-1" -> ULONG_MAX) va bao tran qua errno
+bool console_arg_u32(const char *arg, uint32_t *out) {
+    if (arg == NULL) return false;
+    while (isspace((unsigned char)*arg)) arg++;
+    if (!isdigit((unsigned char)*arg)) return false;
+
+    char *end;
+    errno = 0;
+    unsigned long v = strtoul(arg, &end, 10);
+    if (*end != '\0' || errno == ERANGE || v > UINT32_MAX) return false;
+    *out = (uint32_t)v;
+    return true;
+}
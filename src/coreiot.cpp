@@ -0,0 +1,147 @@
+#include "coreiot.h"
+#include <WiFi.h>
+#include <time.h>
+#include "Arduino_MQTT_Client.h"
+#include "ThingsBoard.h"
+#include "deferred_log.h"
+
+WiFiClient wifiClient;
+Arduino_MQTT_Client mqttClient(wifiClient);
+ThingsBoardSized<Default_Fields_Amt, DeferredLogger> tb(mqttClient, COREIOT_BUFFER_SIZE);
+
+bool coreiot_connect(uint32_t timeout_ms) {
+    uint32_t start = millis();
+
+    if (config_wifi_ssid()[0] == '\0') {
+        dlog("WiFi not configured");
+        return false;
+    }
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(config_wifi_ssid(), config_wifi_pass());
+    while (WiFi.status() != WL_CONNECTED) {
+        if (millis() - start > timeout_ms) {
+            dlog("WiFi connect timeout");
+            return false;
+        }
+        vTaskDelay(100 / portTICK_PERIOD_MS);
+    }
+    event_bus_publish(EVT_NETWORK_UP);
+
+    // PubSubClient chi giu con tro server de reconnect; copy de khong phu thuoc ban config dang active
+    static char server[CONFIG_SERVER_LEN];
+    static char token[CONFIG_TOKEN_LEN];
+    strncpy(server, config_iot_server(), sizeof(server) - 1);
+    strncpy(token, config_iot_token(), sizeof(token) - 1);
+    if (!tb.connect(server, token, config_iot_port())) {
+        dlog("CoreIOT connect failed");
+        return false;
+    }
+    dlog("CoreIOT connected in %lums", (unsigned long)(millis() - start));
+    return true;
+}
+
+bool coreiot_sync_time(uint32_t timeout_ms) {
+    uint32_t start = millis();
+    configTime(0, 0, "pool.ntp.org", "time.google.com");
+    while ((uint32_t)time(nullptr) < COREIOT_VALID_EPOCH) {
+        if (millis() - start > timeout_ms) {
+            return false;
+        }
+        vTaskDelay(100 / portTICK_PERIOD_MS);
+    }
+    return true;
+}
+
+bool coreiot_send_telemetry(const char *json) {
+    if (!tb.connected()) {
+        return false;
+    }
+    bool ok = tb.sendTelemetryJson(json);
+    tb.loop();
+    return ok;
+}
+
+// Chi mot request tai mot thoi diem (goi tu task power trong duty cycle)
+static const char *attrKey = NULL;
+static uint32_t *attrValue = NULL;
+static char *attrJson = NULL;
+static size_t attrJsonCap = 0;
+static volatile bool attrAnswered = false;
+
+// Chi ket thuc cho khi dung key dang hoi: tra loi tre cua request truoc (da timeout)
+// den trong luc cho request sau thi bi bo qua
+static void on_shared_attributes(const Attribute_Data &data) {
+    if (attrKey == NULL || !data.containsKey(attrKey)) return;
+    if (attrValue) {
+        *attrValue = data[attrKey].as<uint32_t>();
+    } else if (attrJson) {
+        // ThingsBoard co the tra JSON dang chuoi hoac object
+        JsonVariantConst v = data[attrKey];
+        if (v.is<const char *>()) {
+            const char *str = v.as<const char *>();
+            if (strlen(str) < attrJsonCap) strcpy(attrJson, str);
+            else attrJson[0] = '\0';      // qua dai -> khong cat ngang JSON
+        } else if (serializeJson(v, attrJson, attrJsonCap) >= attrJsonCap - 1) {
+            attrJson[0] = '\0';    // bi cat -> coi nhu khong co
+        }
+    }
+    attrAnswered = true;
+}
+
+// Het cho (co hay khong co tra loi): callback tre khong con cho nao de ghi
+static void clear_request() {
+    attrKey = NULL;
+    attrValue = NULL;
+    attrJson = NULL;
+    attrJsonCap = 0;
+}
+
+static bool request_shared(const char *key, uint32_t timeout_ms) {
+    if (!tb.connected()) {
+        clear_request();
+        return false;
+    }
+    attrKey = key;
+    attrAnswered = false;
+#if THINGSBOARD_ENABLE_STL
+    const std::vector<const char *> keys{key};
+    const Attribute_Request_Callback callback(on_shared_attributes, keys.cbegin(), keys.cend());
+#else
+    const Attribute_Request_Callback callback(key, on_shared_attributes);
+#endif
+    bool answered = false;
+    if (tb.Shared_Attributes_Request(callback)) {
+        uint32_t start = millis();
+        while (!attrAnswered && millis() - start < timeout_ms) {
+            tb.loop();
+            vTaskDelay(20 / portTICK_PERIOD_MS);
+        }
+        answered = attrAnswered;
+    }
+    clear_request();
+    return answered;
+}
+
+bool coreiot_request_shared_u32(const char *key, uint32_t *value, uint32_t timeout_ms) {
+    attrValue = value;
+    attrJson = NULL;
+    return request_shared(key, timeout_ms);
+}
+
+bool coreiot_request_shared_json(const char *key, char *out, size_t cap, uint32_t timeout_ms) {
+    if (cap < 2) return false;
+    out[0] = '\0';
+    attrValue = NULL;
+    attrJson = out;
+    attrJsonCap = cap;
+    return request_shared(key, timeout_ms) && out[0] != '\0';
+}
+
+void coreiot_disconnect() {
+    tb.disconnect();
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+    if (event_bus_state() & EVT_STATE_NETWORK) {
+        event_bus_publish(EVT_NETWORK_DOWN);
+    }
+}
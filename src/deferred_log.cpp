@@ -0,0 +1,361 @@
+#include "deferred_log.h"
+#include <atomic>
+#include "console.h"
+
+// Bounded MPMC ring (Vyukov): moi o co sequence rieng. Producer gianh vi tri
+// bang CAS roi moi ghi du lieu, nen ISR chen ngang mot producer khac van
+// tien len o o ke tiep thay vi cho.
+typedef struct {
+    std::atomic<uint32_t> seq;
+    dlog_record_t         rec;
+} dlog_cell_t;
+
+typedef struct {
+    dlog_cell_t           cells[DLOG_CAPACITY];
+    std::atomic<uint32_t> enqueuePos;
+    std::atomic<uint32_t> dequeuePos;
+    std::atomic<uint32_t> dropped;
+} dlog_ring_t;
+
+static dlog_ring_t logRing;
+static TaskHandle_t drainTask = NULL;
+
+// Bang format: producer tim theo con tro, chua co thi gianh o moi bang CAS.
+// Hai producer cung dang ky mot format luc dua nhau co the ra 2 ID, ca hai deu dung.
+static std::atomic<const char *> fmtTable[DLOG_FMT_MAX];
+static std::atomic<uint32_t> fmtCount;
+
+static_assert((DLOG_CAPACITY & (DLOG_CAPACITY - 1)) == 0, "DLOG_CAPACITY must be a power of 2");
+
+// o i bat dau voi seq = i (san sang cho lan ghi dau)
+static void ring_init(dlog_ring_t *ring) {
+    for (uint32_t i = 0; i < DLOG_CAPACITY; i++) {
+        ring->cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    ring->enqueuePos.store(0, std::memory_order_relaxed);
+    ring->dequeuePos.store(0, std::memory_order_relaxed);
+    ring->dropped.store(0, std::memory_order_relaxed);
+}
+
+// Chay truoc setup() de log ghi truoc dlog_begin() van vao ring
+static bool init_log_ring() {
+    ring_init(&logRing);
+    return true;
+}
+static bool logRingReady = init_log_ring();
+
+static uint16_t fmt_id(const char *fmt) {
+    uint32_t n = fmtCount.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < n; i++) {
+        if (fmtTable[i].load(std::memory_order_acquire) == fmt) return (uint16_t)i;
+    }
+    while (n < DLOG_FMT_MAX) {
+        if (fmtCount.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel)) {
+            fmtTable[n].store(fmt, std::memory_order_release);
+            return (uint16_t)n;
+        }
+    }
+    return DLOG_FMT_NONE;
+}
+
+const char *dlog_fmt_text(uint16_t id) {
+    if (id >= fmtCount.load(std::memory_order_acquire)) return NULL;
+    return fmtTable[id].load(std::memory_order_acquire);
+}
+
+uint16_t dlog_fmt_count() {
+    return (uint16_t)fmtCount.load(std::memory_order_acquire);
+}
+
+static bool ring_write(dlog_ring_t *ring, const char *fmt, uint8_t nargs, const uint8_t *types,
+                       const dlog_word_t *args) {
+    uint32_t pos = ring->enqueuePos.load(std::memory_order_relaxed);
+    dlog_cell_t *cell;
+    while (true) {
+        cell = &ring->cells[pos & (DLOG_CAPACITY - 1)];
+        uint32_t seq = cell->seq.load(std::memory_order_acquire);
+        int32_t dif = (int32_t)(seq - pos);
+        if (dif == 0) {
+            if (ring->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (dif < 0) {
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = ring->enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    dlog_record_t &r = cell->rec;
+    size_t textPos = 0;
+    r.fmt_id = fmt_id(fmt);
+    r.ts_ms = millis();
+    r.nargs = nargs;
+    r.text[0] = '\0';
+    for (uint8_t i = 0; i < nargs; i++) {
+        r.types[i] = types[i];
+        r.args[i] = args[i];
+        if (types[i] != DLOG_ARG_STR) continue;
+        // Chuoi cua producer co the la buffer tren stack -> copy noi tiep nhau vao text
+        const char *str = args[i].s ? args[i].s : "(null)";
+        size_t n = strnlen(str, DLOG_TEXT_MAX - 1 - textPos);
+        memcpy(r.text + textPos, str, n);
+        r.text[textPos + n] = '\0';
+        r.types[i] = DLOG_ARG_TEXT;
+        r.args[i].u = textPos;
+        textPos += n;
+        if (textPos < DLOG_TEXT_MAX - 1) textPos++;
+    }
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+static bool ring_pop(dlog_ring_t *ring, dlog_record_t *out) {
+    uint32_t pos = ring->dequeuePos.load(std::memory_order_relaxed);
+    dlog_cell_t *cell;
+    while (true) {
+        cell = &ring->cells[pos & (DLOG_CAPACITY - 1)];
+        uint32_t seq = cell->seq.load(std::memory_order_acquire);
+        int32_t dif = (int32_t)(seq - (pos + 1));
+        if (dif == 0) {
+            if (ring->dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (dif < 0) {
+            return false;   // rong
+        } else {
+            pos = ring->dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+    *out = cell->rec;
+    cell->seq.store(pos + DLOG_CAPACITY, std::memory_order_release);
+    return true;
+}
+
+bool dlog_write(const char *fmt, uint8_t nargs, const uint8_t *types, const dlog_word_t *args) {
+    if (!ring_write(&logRing, fmt, nargs, types, args)) return false;
+
+    if (drainTask) {
+        if (xPortInIsrContext()) {
+            BaseType_t woken = pdFALSE;
+            vTaskNotifyGiveFromISR(drainTask, &woken);
+            portYIELD_FROM_ISR(woken);
+        } else {
+            xTaskNotifyGive(drainTask);
+        }
+    }
+    return true;
+}
+
+bool dlog_pop(dlog_record_t *out) {
+    return ring_pop(&logRing, out);
+}
+
+uint32_t dlog_dropped() {
+    return logRing.dropped.load(std::memory_order_relaxed);
+}
+
+size_t dlog_format(const dlog_record_t *rec, char *out, size_t cap) {
+    return dlog_format(rec, dlog_fmt_text(rec->fmt_id), out, cap);
+}
+
+// Dinh dang tung conversion mot bang snprintf voi dung kieu da luu,
+// bo qua length modifier (h, l, ll, z) cua format goc.
+size_t dlog_format(const dlog_record_t *rec, const char *fmt, char *out, size_t cap) {
+    const char *p = fmt ? fmt : "?";
+    size_t pos = 0;
+    uint8_t arg = 0;
+    char spec[16];
+
+    if (cap == 0) return 0;
+    while (*p && pos < cap - 1) {
+        if (*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[pos++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // copy flags / width / precision
+        size_t n = 0;
+        spec[n++] = *p++;
+        while (*p && strchr("-+ #0123456789.", *p) && n < sizeof(spec) - 4) spec[n++] = *p++;
+        while (*p && strchr("hlzjt", *p)) p++;
+        char conv = *p ? *p++ : 's';
+
+        int written;
+        if (arg >= rec->nargs) {
+            written = snprintf(out + pos, cap - pos, "?");
+        } else {
+            const dlog_word_t &w = rec->args[arg];
+            switch (rec->types[arg]) {
+                case DLOG_ARG_FLOAT:
+                    spec[n++] = strchr("eEfFgGaA", conv) ? conv : 'f';
+                    spec[n] = '\0';
+                    written = snprintf(out + pos, cap - pos, spec, (double)w.f);
+                    break;
+                case DLOG_ARG_TEXT:
+                    spec[n++] = 's';
+                    spec[n] = '\0';
+                    written = snprintf(out + pos, cap - pos, spec,
+                                       rec->text + (w.u < DLOG_TEXT_MAX ? w.u : DLOG_TEXT_MAX - 1));
+                    break;
+                case DLOG_ARG_UINT:
+                    spec[n++] = 'l';
+                    spec[n++] = strchr("uxXo", conv) ? conv : 'u';
+                    spec[n] = '\0';
+                    written = snprintf(out + pos, cap - pos, spec, (unsigned long)w.u);
+                    break;
+                default:
+                    spec[n++] = 'l';
+                    spec[n++] = 'd';
+                    spec[n] = '\0';
+                    if (conv == 'c') {
+                        written = snprintf(out + pos, cap - pos, "%c", (char)w.i);
+                    } else {
+                        written = snprintf(out + pos, cap - pos, spec, (long)w.i);
+                    }
+                    break;
+            }
+            arg++;
+        }
+        if (written < 0) break;
+        pos += (size_t)written < cap - pos ? (size_t)written : cap - 1 - pos;
+    }
+    out[pos] = '\0';
+    return pos;
+}
+
+static void put_le(uint8_t *out, uint32_t v, uint8_t bytes) {
+    for (uint8_t i = 0; i < bytes; i++) out[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint32_t get_le(const uint8_t *in, uint8_t bytes) {
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < bytes; i++) v |= (uint32_t)in[i] << (8 * i);
+    return v;
+}
+
+// id(2) ts(4) nargs(1) types(nargs) args(4 * nargs) textLen(1) text(textLen, gom ca '\0' giua cac chuoi)
+size_t dlog_encode(const dlog_record_t *rec, uint8_t *out, size_t cap) {
+    uint8_t nargs = rec->nargs <= DLOG_MAX_ARGS ? rec->nargs : DLOG_MAX_ARGS;
+    size_t textLen = 0;
+    for (uint8_t i = 0; i < nargs; i++) {
+        if (rec->types[i] != DLOG_ARG_TEXT || rec->args[i].u >= DLOG_TEXT_MAX) continue;
+        size_t end = rec->args[i].u + strnlen(rec->text + rec->args[i].u, DLOG_TEXT_MAX - rec->args[i].u);
+        if (end + 1 > textLen) textLen = end + 1 <= DLOG_TEXT_MAX ? end + 1 : DLOG_TEXT_MAX;
+    }
+    size_t len = 2 + 4 + 1 + nargs * 5 + 1 + textLen;
+    if (len > cap) return 0;
+
+    uint8_t *p = out;
+    put_le(p, rec->fmt_id, 2);
+    put_le(p + 2, rec->ts_ms, 4);
+    p[6] = nargs;
+    p += 7;
+    for (uint8_t i = 0; i < nargs; i++) *p++ = rec->types[i];
+    for (uint8_t i = 0; i < nargs; i++, p += 4) put_le(p, rec->args[i].u, 4);
+    *p++ = (uint8_t)textLen;
+    memcpy(p, rec->text, textLen);
+    return len;
+}
+
+size_t dlog_decode(const uint8_t *in, size_t len, dlog_record_t *rec) {
+    if (len < 7 || in[6] > DLOG_MAX_ARGS) return 0;
+    uint8_t nargs = in[6];
+    size_t head = 7 + nargs * 5;
+    if (len < head + 1 || in[head] > DLOG_TEXT_MAX || len < head + 1 + in[head]) return 0;
+
+    memset(rec, 0, sizeof(*rec));
+    rec->fmt_id = (uint16_t)get_le(in, 2);
+    rec->ts_ms = get_le(in + 2, 4);
+    rec->nargs = nargs;
+    for (uint8_t i = 0; i < nargs; i++) {
+        rec->types[i] = in[7 + i];
+        if (rec->types[i] == DLOG_ARG_STR) return 0;   // con tro khong dump duoc
+        rec->args[i].u = get_le(in + 7 + nargs + 4 * i, 4);
+    }
+    memcpy(rec->text, in + head + 1, in[head]);
+    rec->text[DLOG_TEXT_MAX - 1] = '\0';
+    return head + 1 + in[head];
+}
+
+void dlog_flush() {
+    dlog_record_t rec;
+    char line[160];
+    while (dlog_pop(&rec)) {
+        dlog_format(&rec, line, sizeof(line));
+        Serial.println(line);
+    }
+    Serial.flush();
+}
+
+static void drain(void *pvParameters) {
+    static dlog_record_t rec;
+    static char line[160];
+    uint32_t lastDropped = 0;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (dlog_pop(&rec)) {
+            dlog_format(&rec, line, sizeof(line));
+            Serial.println(line);
+        }
+        uint32_t dropped = dlog_dropped();
+        if (dropped != lastDropped) {
+            Serial.printf("[dlog] %lu records dropped\n", (unsigned long)(dropped - lastDropped));
+            lastDropped = dropped;
+        }
+    }
+}
+
+// Nhu dlog() (cung packer, cung ring_write) nhung ghi vao ring rieng cua benchmark
+// va khong danh thuc task drain
+template<typename... Args>
+static bool bench_log(dlog_ring_t *ring, const char *fmt, Args... args) {
+    uint8_t types[DLOG_MAX_ARGS];
+    dlog_word_t words[DLOG_MAX_ARGS];
+    uint8_t n = dlog_pack_args(types, words, args...);
+    return ring_write(ring, fmt, n, types, words);
+}
+
+// So sanh chi phi moi lan log: snprintf dong bo vs ghi record nhi phan.
+// Chay tren ring rieng de khong tranh cho voi log that va task drain.
+static void cmd_logbench(int argc, char *argv[]) {
+    const int iterations = 1000;
+    static char buf[96];
+    static dlog_record_t rec;
+    static dlog_ring_t benchRing;
+    float t = 27.31f, h = 61.2f;
+    uint32_t syncCycles = 0, deferCycles = 0;
+
+    ring_init(&benchRing);
+    for (int i = 0; i < iterations; i++) {
+        uint32_t c0 = ESP.getCycleCount();
+        snprintf(buf, sizeof(buf), "Humidity: %.2f%%  Temperature: %.2f°C", h, t);
+        uint32_t c1 = ESP.getCycleCount();
+        bench_log(&benchRing, "Humidity: %.2f%%  Temperature: %.2f°C", h, t);
+        uint32_t c2 = ESP.getCycleCount();
+        syncCycles += c1 - c0;
+        deferCycles += c2 - c1;
+        ring_pop(&benchRing, &rec);
+    }
+
+    Serial.printf("snprintf: %lu cycles/call, dlog: %lu cycles/call (%d calls)\n",
+                  (unsigned long)(syncCycles / iterations), (unsigned long)(deferCycles / iterations),
+                  iterations);
+    console_prompt();
+}
+
+static const console_cmd_t logbenchCommand = { "logbench", "logbench", "Log call cost: sync vs deferred", cmd_logbench };
+
+bool dlog_begin() {
+    if (drainTask) return true;
+    console_register(&logbenchCommand);
+    return xTaskCreate(drain, "DLogDrain", DLOG_TASK_STACK, NULL, DLOG_TASK_PRIORITY, &drainTask) == pdPASS;
+}
+
+void DeferredLogger::log(const char *msg) {
+    static const char fmt[] = "[TB] %s";
+    dlog(fmt, msg);
+}
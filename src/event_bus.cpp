@@ -0,0 +1,150 @@
+#include "event_bus.h"
+#include <atomic>
+#include "console.h"
+
+typedef struct {
+    uint32_t      mask;
+    QueueHandle_t queue;    // NULL -> kieu task notification
+    TaskHandle_t  task;
+} event_sub_t;
+
+static event_sub_t subs[EVENT_MAX_SUBSCRIBERS];
+static volatile uint8_t subCount = 0;
+static portMUX_TYPE subsMux = portMUX_INITIALIZER_UNLOCKED;
+static EventGroupHandle_t stateGroup = NULL;
+
+// Tang tu ca task lan ISR tren 2 core -> atomic, khong can khoa
+static std::atomic<uint32_t> published[EVT_TOPIC_COUNT];
+static std::atomic<uint32_t> dropped[EVT_TOPIC_COUNT];
+
+static const char *topicNames[EVT_TOPIC_COUNT] = {
+    "network-up", "network-down", "new-sample", "config-changed", "ota-started",
+    "relay-changed"
+};
+
+static void cmd_bus(int argc, char *argv[]) {
+    event_bus_print_stats();
+    console_prompt();
+}
+
+static const console_cmd_t busCommand = { "bus", "bus", "Event bus counters", cmd_bus };
+
+bool event_bus_init() {
+    if (stateGroup == NULL) {
+        stateGroup = xEventGroupCreate();
+        console_register(&busCommand);
+    }
+    return stateGroup != NULL;
+}
+
+// Dang ky chi append: entry ghi xong moi tang subCount, nen publish
+// duyet danh sach khong can khoa.
+static bool add_subscriber(uint32_t mask, QueueHandle_t queue, TaskHandle_t task) {
+    bool ok = false;
+    portENTER_CRITICAL(&subsMux);
+    if (subCount < EVENT_MAX_SUBSCRIBERS) {
+        subs[subCount].mask = mask;
+        subs[subCount].queue = queue;
+        subs[subCount].task = task;
+        subCount = subCount + 1;
+        ok = true;
+    }
+    portEXIT_CRITICAL(&subsMux);
+    return ok;
+}
+
+bool event_bus_subscribe_queue(uint32_t topic_mask, QueueHandle_t queue) {
+    return queue != NULL && add_subscriber(topic_mask, queue, NULL);
+}
+
+bool event_bus_subscribe_task(uint32_t topic_mask, TaskHandle_t task) {
+    return task != NULL && add_subscriber(topic_mask, NULL, task);
+}
+
+static void fill_msg(event_msg_t *msg, event_topic_t topic, const void *data, uint8_t len) {
+    if (len > EVENT_PAYLOAD_MAX) len = EVENT_PAYLOAD_MAX;
+    msg->topic = topic;
+    msg->len = len;
+    msg->stamp_ms = millis();
+    if (len) memcpy(msg->data, data, len);
+}
+
+static void update_state(event_topic_t topic, bool from_isr, BaseType_t *woken) {
+    EventBits_t set = 0, clear = 0;
+    if (stateGroup == NULL) return;
+    switch (topic) {
+        case EVT_NETWORK_UP:   set = EVT_STATE_NETWORK; break;
+        case EVT_NETWORK_DOWN: clear = EVT_STATE_NETWORK | EVT_STATE_OTA; break;
+        case EVT_OTA_STARTED:  set = EVT_STATE_OTA; break;
+        default: return;
+    }
+    if (from_isr) {
+        if (set) xEventGroupSetBitsFromISR(stateGroup, set, woken);
+        if (clear) xEventGroupClearBitsFromISR(stateGroup, clear);
+    } else {
+        if (set) xEventGroupSetBits(stateGroup, set);
+        if (clear) xEventGroupClearBits(stateGroup, clear);
+    }
+}
+
+void event_bus_publish(event_topic_t topic, const void *data, uint8_t len) {
+    if (topic >= EVT_TOPIC_COUNT) return;
+    event_msg_t msg;
+    fill_msg(&msg, topic, data, len);
+    update_state(topic, false, NULL);
+    published[topic].fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t bit = EVT_BIT(topic);
+    uint8_t n = subCount;
+    for (uint8_t i = 0; i < n; i++) {
+        if (!(subs[i].mask & bit)) continue;
+        if (subs[i].queue) {
+            if (xQueueSend(subs[i].queue, &msg, 0) != pdPASS) {
+                dropped[topic].fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            xTaskNotify(subs[i].task, bit, eSetBits);
+        }
+    }
+}
+
+void event_bus_publish_from_isr(event_topic_t topic, const void *data, uint8_t len,
+                                BaseType_t *woken) {
+    if (topic >= EVT_TOPIC_COUNT) return;
+    event_msg_t msg;
+    fill_msg(&msg, topic, data, len);
+    update_state(topic, true, woken);
+    published[topic].fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t bit = EVT_BIT(topic);
+    uint8_t n = subCount;
+    for (uint8_t i = 0; i < n; i++) {
+        if (!(subs[i].mask & bit)) continue;
+        if (subs[i].queue) {
+            if (xQueueSendFromISR(subs[i].queue, &msg, woken) != pdPASS) {
+                dropped[topic].fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            xTaskNotifyFromISR(subs[i].task, bit, eSetBits, woken);
+        }
+    }
+}
+
+EventBits_t event_bus_state() {
+    return stateGroup ? xEventGroupGetBits(stateGroup) : 0;
+}
+
+bool event_bus_wait_state(EventBits_t bits, TickType_t timeout) {
+    if (stateGroup == NULL) return false;
+    return (xEventGroupWaitBits(stateGroup, bits, pdFALSE, pdTRUE, timeout) & bits) == bits;
+}
+
+void event_bus_print_stats() {
+    Serial.printf("\nEVENT BUS (%u subscribers, state 0x%02lx):\n", subCount,
+                  (unsigned long)event_bus_state());
+    for (int i = 0; i < EVT_TOPIC_COUNT; i++) {
+        Serial.printf("  %-15s published %6lu  dropped %4lu\n", topicNames[i],
+                      (unsigned long)published[i].load(std::memory_order_relaxed),
+                      (unsigned long)dropped[i].load(std::memory_order_relaxed));
+    }
+}
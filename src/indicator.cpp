@@ -0,0 +1,244 @@
+#include "indicator.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/timers.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "driver/gpio.h"
+#include <Adafruit_NeoPixel.h>
+
+Adafruit_NeoPixel strip(1, INDICATOR_NEO_PIN, NEO_GRB + NEO_KHZ800);
+
+typedef struct {
+    uint8_t             channel;
+    uint8_t             overlay;
+    indicator_pattern_t pattern;
+} indicator_cmd_t;
+
+// Chi timer task doc/ghi `channels`; cac task khac gui lenh qua queue
+static indicator_state_t channels[IND_CH_COUNT];
+static QueueHandle_t cmdQueue = NULL;
+static TimerHandle_t frameTimer = NULL;
+static SemaphoreHandle_t outputLock = NULL;
+static bool suspended = false;
+
+bool indicator_frame(const indicator_pattern_t *p, uint32_t t, uint8_t *level, uint32_t *next_ms) {
+    uint32_t period, ph;
+
+    *next_ms = UINT32_MAX;
+    switch (p->mode) {
+    case IND_SOLID:
+        *level = 255;
+        return true;
+
+    case IND_BLINK:
+        period = (uint32_t)p->on_ms + p->off_ms;
+        if (period == 0) {
+            *level = 255;
+            return true;
+        }
+        if (p->repeat && t / period >= p->repeat) {
+            *level = 0;
+            return false;
+        }
+        ph = t % period;
+        if (ph < p->on_ms) {
+            *level = 255;
+            *next_ms = p->on_ms - ph;
+        } else {
+            *level = 0;
+            *next_ms = period - ph;
+        }
+        return true;
+
+    case IND_BREATHE:
+        if (p->on_ms == 0) {
+            *level = 0;
+            return true;
+        }
+        period = 2UL * p->on_ms;
+        if (p->repeat && t / period >= p->repeat) {
+            *level = 0;
+            return false;
+        }
+        ph = t % period;
+        if (ph >= p->on_ms) ph = period - ph;
+        *level = (uint8_t)(ph * 255 / p->on_ms);
+        *next_ms = INDICATOR_FRAME_MS;
+        return true;
+
+    case IND_CODE: {
+        uint32_t blink = (uint32_t)p->on_ms + p->off_ms;
+        uint32_t burst = blink * p->repeat;
+        if (burst == 0) {
+            *level = 0;
+            return true;
+        }
+        ph = t % (burst + INDICATOR_CODE_GAP_MS);
+        if (ph >= burst) {
+            *level = 0;
+            *next_ms = burst + INDICATOR_CODE_GAP_MS - ph;
+        } else if (ph % blink < p->on_ms) {
+            *level = 255;
+            *next_ms = p->on_ms - ph % blink;
+        } else {
+            *level = 0;
+            *next_ms = blink - ph % blink;
+        }
+        return true;
+    }
+
+    case IND_OFF:
+    default:
+        *level = 0;
+        return true;
+    }
+}
+
+static void output(uint8_t ch, const indicator_pattern_t *p, uint8_t level) {
+    if (ch == IND_CH_D13) {
+        gpio_set_level((gpio_num_t)INDICATOR_D13_PIN, level >= 128);
+        return;
+    }
+    strip.setPixelColor(0, strip.Color((uint16_t)p->r * level / 255,
+                                       (uint16_t)p->g * level / 255,
+                                       (uint16_t)p->b * level / 255));
+    strip.show();
+}
+
+void indicator_state_apply(indicator_state_t *s, const indicator_pattern_t *p, bool overlay, uint32_t now) {
+    if (overlay) {
+        s->overlay = *p;
+        s->overlayActive = true;
+    } else {
+        s->base = *p;
+        if (s->overlayActive) return;   // nen moi se chay khi overlay xong
+    }
+    s->startMs = now;
+    s->lastLevel = -1;
+}
+
+bool indicator_step(indicator_state_t *s, uint32_t now, const indicator_pattern_t **pattern,
+                    uint8_t *level, uint32_t *next_ms) {
+    const indicator_pattern_t *p = s->overlayActive ? &s->overlay : &s->base;
+    if (!indicator_frame(p, now - s->startMs, level, next_ms) && s->overlayActive) {
+        s->overlayActive = false;
+        s->startMs = now;
+        s->lastLevel = -1;
+        p = &s->base;
+        indicator_frame(p, 0, level, next_ms);
+    }
+    *pattern = p;
+    // Chi day ra LED khi level doi; doi pattern thi lastLevel da bi xoa ve -1
+    if (*level == s->lastLevel) return false;
+    s->lastLevel = *level;
+    return true;
+}
+
+static void render(TimerHandle_t xTimer) {
+    if (xSemaphoreTake(outputLock, 0) != pdTRUE) return;   // dang ngu, indicator_wake se ve lai
+    if (suspended) {
+        xSemaphoreGive(outputLock);
+        return;
+    }
+
+    uint32_t now = millis();
+    indicator_cmd_t cmd;
+    while (xQueueReceive(cmdQueue, &cmd, 0) == pdTRUE) {
+        indicator_state_apply(&channels[cmd.channel], &cmd.pattern, cmd.overlay, now);
+    }
+
+    uint32_t wait = UINT32_MAX;
+    for (uint8_t ch = 0; ch < IND_CH_COUNT; ch++) {
+        const indicator_pattern_t *p;
+        uint8_t level;
+        uint32_t next;
+
+        if (indicator_step(&channels[ch], now, &p, &level, &next)) output(ch, p, level);
+        if (next < wait) wait = next;
+    }
+    xSemaphoreGive(outputLock);
+
+    // Chi hen khung ke tiep khi co kenh dang chuyen dong; solid/off thi timer ngu han
+    if (wait != UINT32_MAX) {
+        TickType_t ticks = pdMS_TO_TICKS(wait);
+        xTimerChangePeriod(xTimer, ticks ? ticks : 1, 0);
+    }
+}
+
+static bool post(indicator_channel_t ch, const indicator_pattern_t *p, bool overlay) {
+    if (cmdQueue == NULL || ch >= IND_CH_COUNT || p == NULL) return false;
+    indicator_cmd_t cmd;
+    cmd.channel = ch;
+    cmd.overlay = overlay;
+    cmd.pattern = *p;
+    if (xQueueSend(cmdQueue, &cmd, 0) != pdTRUE) return false;
+    // Ve ngay o tick sau, khong cho het khung dang hen
+    return xTimerChangePeriod(frameTimer, 1, 0) == pdPASS;
+}
+
+bool indicator_set(indicator_channel_t ch, const indicator_pattern_t *p) {
+    return post(ch, p, false);
+}
+
+bool indicator_play(indicator_channel_t ch, const indicator_pattern_t *p) {
+    return post(ch, p, true);
+}
+
+void indicator_sleep() {
+    if (outputLock) {
+        xSemaphoreTake(outputLock, portMAX_DELAY);
+        suspended = true;
+        xTimerStop(frameTimer, 0);
+    }
+
+    strip.setPixelColor(0, strip.Color(0, 0, 0));
+    strip.show();
+    delay(20);
+    gpio_reset_pin((gpio_num_t)INDICATOR_NEO_PIN);
+
+    gpio_reset_pin((gpio_num_t)INDICATOR_D13_PIN);
+    gpio_set_direction((gpio_num_t)INDICATOR_D13_PIN, GPIO_MODE_OUTPUT);
+    gpio_set_level((gpio_num_t)INDICATOR_D13_PIN, 1);
+    gpio_hold_en((gpio_num_t)INDICATOR_D13_PIN);
+
+    if (outputLock) xSemaphoreGive(outputLock);
+}
+
+void indicator_wake() {
+    gpio_hold_dis((gpio_num_t)INDICATOR_D13_PIN);
+    strip.begin();
+    strip.setBrightness(INDICATOR_BRIGHTNESS);
+    if (outputLock == NULL) return;
+
+    xSemaphoreTake(outputLock, portMAX_DELAY);
+    for (uint8_t ch = 0; ch < IND_CH_COUNT; ch++) {
+        channels[ch].lastLevel = -1;
+    }
+    suspended = false;
+    xSemaphoreGive(outputLock);
+    xTimerChangePeriod(frameTimer, 1, 0);
+}
+
+bool indicator_init() {
+    gpio_reset_pin((gpio_num_t)INDICATOR_D13_PIN);
+    gpio_set_direction((gpio_num_t)INDICATOR_D13_PIN, GPIO_MODE_OUTPUT);
+    gpio_hold_dis((gpio_num_t)INDICATOR_D13_PIN);
+    gpio_deep_sleep_hold_dis();
+    gpio_set_level((gpio_num_t)INDICATOR_D13_PIN, 0);
+
+    strip.begin();
+    strip.setBrightness(INDICATOR_BRIGHTNESS);
+
+    for (uint8_t ch = 0; ch < IND_CH_COUNT; ch++) {
+        channels[ch].base.mode = IND_OFF;
+        channels[ch].overlayActive = false;
+        channels[ch].startMs = 0;
+        channels[ch].lastLevel = -1;
+    }
+
+    cmdQueue = xQueueCreate(INDICATOR_QUEUE_LEN, sizeof(indicator_cmd_t));
+    outputLock = xSemaphoreCreateMutex();
+    frameTimer = xTimerCreate("Indicator", 1, pdFALSE, NULL, render);
+    if (cmdQueue == NULL || outputLock == NULL || frameTimer == NULL) return false;
+    return xTimerStart(frameTimer, 0) == pdPASS;
+}
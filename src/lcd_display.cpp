@@ -0,0 +1,268 @@
+#include "lcd_display.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_heap_caps.h"
+#include "LiquidCrystal_I2C.h"
+#include "LCD_Framebuffer.h"
+#include "LCD_GlyphCache.h"
+#include "sensor_snapshot.h"
+#include "relay_manager.h"
+#include "event_bus.h"
+#include "console.h"
+
+typedef enum {
+    REQ_TEXT = 0,
+    REQ_SCREEN,
+    REQ_BACKLIGHT
+} lcd_req_type_t;
+
+typedef struct {
+    uint8_t  type;          // lcd_req_type_t
+    uint8_t  col;
+    uint8_t  row;
+    uint8_t  arg;           // screen / backlight
+    uint32_t stamp_us;
+    char     text[LCD_COLS + 1];
+} lcd_request_t;
+
+// Chi task LCD cham vao man hinh va framebuffer
+static LiquidCrystal_I2C lcd(LCD_I2C_ADDR, LCD_COLS, LCD_ROWS);
+static LCD_Framebuffer fb(lcd, LCD_COLS, LCD_ROWS);
+static LCD_GlyphCache glyphs(lcd, &fb);
+static char textLines[LCD_ROWS][LCD_COLS];
+static uint8_t screen = LCD_SCREEN_SENSOR;
+
+// Mui ten xu huong cho man hinh sensor (CGRAM, nap khi can)
+static const uint8_t glyphUp[8]   = { 0x04, 0x0E, 0x15, 0x04, 0x04, 0x04, 0x04, 0x00 };
+static const uint8_t glyphDown[8] = { 0x04, 0x04, 0x04, 0x04, 0x15, 0x0E, 0x04, 0x00 };
+
+static TaskHandle_t lcdTask = NULL;
+static QueueHandle_t requests = NULL;
+static lcd_stats_t stats;
+static portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+
+static bool post(lcd_request_t *req) {
+    if (requests == NULL) return false;
+    req->stamp_us = micros();
+    bool ok = xQueueSend(requests, req, 0) == pdTRUE;
+    UBaseType_t depth = uxQueueMessagesWaiting(requests);
+
+    portENTER_CRITICAL(&statsMux);
+    stats.requests++;
+    if (!ok) stats.dropped++;
+    if (depth > stats.queue_peak) stats.queue_peak = depth;
+    portEXIT_CRITICAL(&statsMux);
+
+    if (ok) xTaskNotify(lcdTask, LCD_NOTIFY_REQUEST, eSetBits);
+    return ok;
+}
+
+bool lcd_display_text(uint8_t col, uint8_t row, const char *text) {
+    if (row >= LCD_ROWS || col >= LCD_COLS || text == NULL) return false;
+    lcd_request_t req;
+    req.type = REQ_TEXT;
+    req.col = col;
+    req.row = row;
+    strncpy(req.text, text, LCD_COLS);
+    req.text[LCD_COLS] = '\0';
+    return post(&req);
+}
+
+bool lcd_display_screen(lcd_screen_t id) {
+    if (id >= LCD_SCREEN_COUNT) return false;
+    lcd_request_t req;
+    req.type = REQ_SCREEN;
+    req.arg = id;
+    return post(&req);
+}
+
+bool lcd_display_backlight(bool on) {
+    lcd_request_t req;
+    req.type = REQ_BACKLIGHT;
+    req.arg = on;
+    return post(&req);
+}
+
+void lcd_display_get_stats(lcd_stats_t *out) {
+    portENTER_CRITICAL(&statsMux);
+    *out = stats;
+    portEXIT_CRITICAL(&statsMux);
+    out->queue_depth = requests ? uxQueueMessagesWaiting(requests) : 0;
+}
+
+// Glyph mui ten theo do lech so voi mau truoc; ' ' neu dung yen hoac het slot CGRAM
+static void draw_trend(float delta, float deadband) {
+    int8_t code = -1;
+    if (delta > deadband) code = glyphs.acquire(glyphUp);
+    else if (delta < -deadband) code = glyphs.acquire(glyphDown);
+    fb.write(code >= 0 ? (uint8_t)code : ' ');
+}
+
+// Tra ve true neu man hinh dang hien thi bi anh huong
+static bool apply(const lcd_request_t *req) {
+    switch (req->type) {
+        case REQ_TEXT: {
+            size_t len = strnlen(req->text, LCD_COLS - req->col);
+            memcpy(&textLines[req->row][req->col], req->text, len);
+            return screen == LCD_SCREEN_TEXT;
+        }
+        case REQ_SCREEN:
+            if (screen == req->arg) return false;
+            screen = req->arg;
+            return true;
+        case REQ_BACKLIGHT:
+            // 1 lan ghi expander, khong can ve lai
+            if (req->arg) lcd.backlight();
+            else lcd.noBacklight();
+            return false;
+    }
+    return false;
+}
+
+static void draw() {
+    static sensor_snapshot_t prev;
+    static float dTemp = 0, dHumi = 0;
+    sensor_snapshot_t snap;
+
+    // Ve lai toan bo vao RAM; flush() chi gui o thay doi nen nhan nhan co dinh mien phi
+    fb.clear();
+    glyphs.beginFrame();
+    switch (screen) {
+        case LCD_SCREEN_SENSOR:
+            if (!sensor_snapshot_read(&snap)) {
+                fb.print("Waiting sensor");
+            } else if (snap.status != 0) {
+                fb.printf("Sensor error %d", snap.status);
+            } else {
+                if (snap.sequence != prev.sequence) {
+                    if (prev.sequence != 0 && prev.status == 0) {
+                        dTemp = snap.temperature - prev.temperature;
+                        dHumi = snap.humidity - prev.humidity;
+                    }
+                    prev = snap;
+                }
+                fb.printf("Temp %6.2f C ", snap.temperature);
+                draw_trend(dTemp, 0.05f);
+                fb.setCursor(0, 1);
+                fb.printf("Humi %6.2f %% ", snap.humidity);
+                draw_trend(dHumi, 0.2f);
+            }
+            break;
+        case LCD_SCREEN_SYSTEM:
+            fb.printf("Up %lus", (unsigned long)(millis() / 1000));
+            fb.setCursor(0, 1);
+            fb.printf("Heap %luK R%02lX", (unsigned long)(heap_caps_get_free_size(MALLOC_CAP_8BIT) / 1024),
+                      (unsigned long)relay_state());
+            break;
+        case LCD_SCREEN_TEXT:
+            for (uint8_t r = 0; r < LCD_ROWS; r++) {
+                fb.setCursor(0, r);
+                fb.write((const uint8_t *)textLines[r], LCD_COLS);
+            }
+            break;
+    }
+    fb.flush();
+}
+
+static void render_task(void *pvParameters) {
+    static lcd_request_t req;
+    uint32_t lastSystemMs = 0;
+
+    // begin() ~1.1s: delay() nhuong CPU, chi task nay cho
+    lcd.begin();
+    glyphs.reset();
+    bool dirty = true;
+
+    while (1) {
+        // Man hinh he thong co deadline (uptime), con lai chi thuc day khi co request / su kien
+        TickType_t wait = portMAX_DELAY;
+        if (screen == LCD_SCREEN_SYSTEM) {
+            uint32_t elapsed = millis() - lastSystemMs;
+            wait = elapsed >= LCD_SYSTEM_PERIOD_MS ? 0 : pdMS_TO_TICKS(LCD_SYSTEM_PERIOD_MS - elapsed);
+        }
+        uint32_t bits = 0;
+        if (!dirty) xTaskNotifyWait(0, UINT32_MAX, &bits, wait);
+
+        // Gop moi request dang cho thanh mot frame
+        uint32_t oldest = micros();
+        while (xQueueReceive(requests, &req, 0) == pdTRUE) {
+            dirty = apply(&req) || dirty;
+            if ((int32_t)(req.stamp_us - oldest) < 0) oldest = req.stamp_us;
+        }
+        if ((bits & EVT_BIT(EVT_NEW_SAMPLE)) && screen == LCD_SCREEN_SENSOR) dirty = true;
+        if (screen == LCD_SCREEN_SYSTEM &&
+            ((bits & EVT_BIT(EVT_RELAY_CHANGED)) || millis() - lastSystemMs >= LCD_SYSTEM_PERIOD_MS)) {
+            dirty = true;
+        }
+        if (!dirty) continue;
+
+        draw();
+        dirty = false;
+        if (screen == LCD_SCREEN_SYSTEM) lastSystemMs = millis();
+
+        uint32_t latency = micros() - oldest;
+        portENTER_CRITICAL(&statsMux);
+        stats.renders++;
+        stats.last_latency_us = latency;
+        if (latency > stats.max_latency_us) stats.max_latency_us = latency;
+        stats.last_transactions = fb.lastFlushTransactions();
+        stats.total_transactions += fb.lastFlushTransactions();
+        stats.glyph_hits = glyphs.hits();
+        stats.glyph_loads = glyphs.loads();
+        portEXIT_CRITICAL(&statsMux);
+    }
+}
+
+static void cmd_lcd(int argc, char *argv[]) {
+    static char line[LCD_COLS + 1];
+    uint32_t n;
+    lcd_stats_t s;
+
+    if (argc >= 4 && strcasecmp(argv[1], "text") == 0 && console_arg_u32(argv[2], &n)) {
+        // argv tach theo dau cach: noi lai phan con lai, dem space cho het dong
+        size_t pos = 0;
+        for (int i = 3; i < argc && pos < LCD_COLS; i++) {
+            pos += snprintf(line + pos, sizeof(line) - pos, "%s%s", i > 3 ? " " : "", argv[i]);
+        }
+        if (pos > LCD_COLS) pos = LCD_COLS;
+        snprintf(line + pos, sizeof(line) - pos, "%*s", (int)(LCD_COLS - pos), "");
+        if (n >= LCD_ROWS || !lcd_display_text(0, n, line) || !lcd_display_screen(LCD_SCREEN_TEXT)) {
+            Serial.println("Invalid row / queue full");
+        }
+    } else if (argc >= 2 && strcasecmp(argv[1], "light") == 0) {
+        lcd_display_backlight(argc < 3 || strcasecmp(argv[2], "off") != 0);
+    } else if (argc >= 2) {
+        if (!console_arg_u32(argv[1], &n) || !lcd_display_screen((lcd_screen_t)n)) {
+            Serial.println("Invalid screen");
+        }
+    }
+
+    lcd_display_get_stats(&s);
+    Serial.printf("Screen %u, queue %u (peak %u), requests %lu, dropped %lu\n", screen, s.queue_depth,
+                  s.queue_peak, (unsigned long)s.requests, (unsigned long)s.dropped);
+    Serial.printf("Renders %lu, latency %lu us (max %lu), I2C last %lu total %lu\n",
+                  (unsigned long)s.renders, (unsigned long)s.last_latency_us,
+                  (unsigned long)s.max_latency_us, (unsigned long)s.last_transactions,
+                  (unsigned long)s.total_transactions);
+    Serial.printf("Glyphs: %lu hits, %lu CGRAM loads\n", (unsigned long)s.glyph_hits,
+                  (unsigned long)s.glyph_loads);
+    console_prompt();
+}
+
+static const console_cmd_t lcdCommand = {
+    "lcd", "lcd [0|1|2 | text <row> <msg> | light on|off]", "LCD screen / render metrics", cmd_lcd
+};
+
+bool lcd_display_begin() {
+    if (lcdTask) return true;
+    memset(textLines, ' ', sizeof(textLines));
+    requests = xQueueCreate(LCD_QUEUE_LEN, sizeof(lcd_request_t));
+    if (requests == NULL) return false;
+    if (xTaskCreate(render_task, "LCD", LCD_TASK_STACK, NULL, LCD_TASK_PRIORITY, &lcdTask) != pdPASS) {
+        return false;
+    }
+    event_bus_subscribe_task(EVT_BIT(EVT_NEW_SAMPLE) | EVT_BIT(EVT_RELAY_CHANGED), lcdTask);
+    console_register(&lcdCommand);
+    return true;
+}
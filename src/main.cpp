@@ -1,6 +1,15 @@
 
 #include <Arduino.h>
 #include "task_power_demo.h"
+#include "temp_humi_monitor.h"
+#include "sys_monitor.h"
+#include "boot_profiler.h"
+#include "config_store.h"
+#include "event_bus.h"
+#include "deferred_log.h"
+#include "relay_manager.h"
+#include "rule_engine.h"
+#include "lcd_display.h"
 
 
 
@@ -10,9 +19,33 @@ void setup() {
     // Khởi tạo Serial ở đây là tốt nhất để debug ngay từ đầu
     Serial.begin(115200);
     
-    // Đợi một chút cho Serial ổn định
-    delay(1000);
+    // Đợi một chút cho Serial ổn định (bo qua khi thuc day bang timer)
+    if (!boot_is_fast_wake()) delay(1000);
     Serial.println("--- SYSTEM START ---");
+    dlog_begin();
+    boot_profiler_mark("serial");
+
+    event_bus_init();
+
+    // Cau hinh doc 1 lan tu flash, can cho ca duty cycle (bat mang)
+    config_store_begin();
+    boot_profiler_mark("config");
+
+    // Truoc duty cycle: rule nhan tu server luc flush co the dang ky relay
+    relay_manager_begin();
+
+    // Duty cycle: do mau, gui batch neu can, roi ngu lai ngay
+    duty_cycle_resume();
+
+    // DHT20 chay bang software timer, khong can task rieng
+    temp_humi_monitor_init();
+    boot_profiler_mark("sensor");
+    // Rule nap tu flash, chay duoc ca khi chua co mang (sau sensor: dat nguong theo doi)
+    rules_begin();
+    sys_monitor_init();
+    boot_profiler_mark("sysmon");
+    // LCD begin() chay trong task rieng (Wire da begin o sensor)
+    lcd_display_begin();
 
     // Tạo Task
     xTaskCreate(
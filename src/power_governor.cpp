@@ -0,0 +1,186 @@
+#include "power_governor.h"
+#include "task_power_demo.h"
+#include <sys/time.h>
+
+static const char *stateNames[PWR_STATE_COUNT] = { "ACTIVE", "IDLE", "LIGHT", "DEEP" };
+
+static governor_job_t jobs[GOVERNOR_MAX_JOBS];
+static portMUX_TYPE jobsMux = portMUX_INITIALIZER_UNLOCKED;
+static bool governorEnabled = false;
+static uint32_t lastStepMs = 0;
+static power_state_t lastState = PWR_STATE_ACTIVE;
+static governor_veto_t deepVeto = NULL;
+
+// Residency giu qua deep sleep de bao cao ca chu ky
+RTC_DATA_ATTR static uint64_t residencyMs[PWR_STATE_COUNT];
+RTC_DATA_ATTR static uint32_t residencyEntries[PWR_STATE_COUNT];
+// Gio RTC (chay ca khi deep sleep) luc vao deep; thuc day som thi van tinh dung
+RTC_DATA_ATTR static int64_t deepEnterUs = -1;
+
+static int64_t rtc_now_us() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+int power_governor_register(const char *name, uint32_t period_ms, bool deep_ok,
+                            governor_wake_hook_t on_wake) {
+    int id = -1;
+    portENTER_CRITICAL(&jobsMux);
+    for (int i = 0; i < GOVERNOR_MAX_JOBS; i++) {
+        if (!jobs[i].used) {
+            jobs[i].name = name;
+            jobs[i].period_ms = period_ms;
+            jobs[i].last_run_ms = millis();
+            jobs[i].deep_ok = deep_ok;
+            jobs[i].on_wake = on_wake;
+            jobs[i].used = true;
+            id = i;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&jobsMux);
+    return id;
+}
+
+void power_governor_unregister(int id) {
+    if (id < 0 || id >= GOVERNOR_MAX_JOBS) return;
+    portENTER_CRITICAL(&jobsMux);
+    jobs[id].used = false;
+    portEXIT_CRITICAL(&jobsMux);
+}
+
+void power_governor_set_period(int id, uint32_t period_ms) {
+    if (id < 0 || id >= GOVERNOR_MAX_JOBS) return;
+    portENTER_CRITICAL_SAFE(&jobsMux);
+    jobs[id].period_ms = period_ms;
+    portEXIT_CRITICAL_SAFE(&jobsMux);
+}
+
+void power_governor_job_ran(int id, uint32_t now_ms) {
+    if (id < 0 || id >= GOVERNOR_MAX_JOBS) return;
+    portENTER_CRITICAL_SAFE(&jobsMux);
+    jobs[id].last_run_ms = now_ms;
+    portEXIT_CRITICAL_SAFE(&jobsMux);
+}
+
+static void snapshot_jobs(governor_job_t *out) {
+    portENTER_CRITICAL(&jobsMux);
+    memcpy(out, jobs, sizeof(jobs));
+    portEXIT_CRITICAL(&jobsMux);
+}
+
+power_state_t power_governor_decide(const governor_job_t *jobs, uint8_t count, uint32_t now_ms,
+                                    bool deep_allowed, uint32_t *gap_ms) {
+    uint32_t gap = UINT32_MAX;
+    bool deepOk = deep_allowed;
+    bool any = false;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (!jobs[i].used) continue;
+        any = true;
+        uint32_t elapsed = now_ms - jobs[i].last_run_ms;
+        uint32_t remain = elapsed >= jobs[i].period_ms ? 0 : jobs[i].period_ms - elapsed;
+        if (remain < gap) gap = remain;
+        deepOk = deepOk && jobs[i].deep_ok;
+    }
+
+    if (!any) {
+        // khong co job nao -> khong biet khi nao thuc day, chi idle
+        *gap_ms = 0;
+        return PWR_STATE_IDLE;
+    }
+
+    *gap_ms = gap;
+    if (gap == 0) return PWR_STATE_ACTIVE;
+    if (gap <= GOVERNOR_LIGHT_MIN_MS + GOVERNOR_WAKE_MARGIN_MS) return PWR_STATE_IDLE;
+    if (deepOk && gap >= GOVERNOR_DEEP_MIN_MS) return PWR_STATE_DEEP_SLEEP;
+    return PWR_STATE_LIGHT_SLEEP;
+}
+
+void power_governor_enable(bool on) {
+    governorEnabled = on;
+    lastStepMs = millis();
+    lastState = PWR_STATE_ACTIVE;
+}
+
+bool power_governor_enabled() {
+    return governorEnabled;
+}
+
+void power_governor_set_deep_veto(governor_veto_t veto) {
+    deepVeto = veto;
+}
+
+void power_governor_boot() {
+    if (deepEnterUs < 0) return;
+    int64_t slept = rtc_now_us() - deepEnterUs;
+    deepEnterUs = -1;
+    if (slept > 0) power_governor_account(PWR_STATE_DEEP_SLEEP, (uint32_t)(slept / 1000));
+}
+
+void power_governor_account(power_state_t state, uint32_t ms) {
+    residencyMs[state] += ms;
+    residencyEntries[state]++;
+}
+
+static void reconcile_after_wake(uint32_t slept_ms) {
+    governor_job_t snapshot[GOVERNOR_MAX_JOBS];
+    snapshot_jobs(snapshot);
+
+    for (int i = 0; i < GOVERNOR_MAX_JOBS; i++) {
+        if (snapshot[i].used && snapshot[i].on_wake) {
+            snapshot[i].on_wake(slept_ms);
+        }
+    }
+}
+
+void power_governor_step() {
+    if (!governorEnabled) return;
+
+    uint32_t now = millis();
+    // thoi gian tu buoc truoc tinh cho trang thai da chon o buoc truoc
+    power_governor_account(lastState, now - lastStepMs);
+
+    governor_job_t snapshot[GOVERNOR_MAX_JOBS];
+    uint32_t gap;
+    snapshot_jobs(snapshot);
+    bool deepAllowed = deepVeto == NULL || !deepVeto();
+    power_state_t state = power_governor_decide(snapshot, GOVERNOR_MAX_JOBS, now, deepAllowed, &gap);
+
+    if (state == PWR_STATE_LIGHT_SLEEP) {
+        uint32_t slept = light_sleep_for(gap - GOVERNOR_WAKE_MARGIN_MS);
+        power_governor_account(PWR_STATE_LIGHT_SLEEP, slept);
+        reconcile_after_wake(slept);
+        state = PWR_STATE_ACTIVE;
+    } else if (state == PWR_STATE_DEEP_SLEEP) {
+        // residency ghi o power_governor_boot() theo thoi gian ngu that
+        deepEnterUs = rtc_now_us();
+        enter_deep_sleep((gap - GOVERNOR_WAKE_MARGIN_MS) / 1000);
+    }
+
+    lastState = state;
+    lastStepMs = millis();
+}
+
+void power_governor_print_report() {
+    uint64_t total = 0;
+    for (int i = 0; i < PWR_STATE_COUNT; i++) total += residencyMs[i];
+
+    Serial.println("\nPOWER STATE RESIDENCY:");
+    for (int i = 0; i < PWR_STATE_COUNT; i++) {
+        uint32_t permille = total ? (uint32_t)(residencyMs[i] * 1000 / total) : 0;
+        Serial.printf("  %-7s %10llu ms  %3u.%u%%  (%u entries)\n", stateNames[i],
+                      (unsigned long long)residencyMs[i], permille / 10, permille % 10,
+                      (unsigned)residencyEntries[i]);
+    }
+
+    Serial.println("JOBS:");
+    uint32_t now = millis();
+    for (int i = 0; i < GOVERNOR_MAX_JOBS; i++) {
+        if (!jobs[i].used) continue;
+        Serial.printf("  %-16s every %6lu ms, last %6lu ms ago%s\n", jobs[i].name,
+                      (unsigned long)jobs[i].period_ms, (unsigned long)(now - jobs[i].last_run_ms),
+                      jobs[i].deep_ok ? "" : " (no deep)");
+    }
+}
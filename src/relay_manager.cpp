@@ -0,0 +1,357 @@
+#include "relay_manager.h"
+#include <ArduinoJson.h>
+#include "driver/gpio.h"
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+#include "event_bus.h"
+#include "console.h"
+
+#define RELAY_GPIO_MAX  48
+
+// Strapping (0, 3, 45, 46), I2C cam bien (11, 12), USB (19, 20), khong ton tai (22-25),
+// flash (26-32), NeoPixel/D13 cua indicator (45, 48)
+static const uint64_t reservedPins =
+    (1ULL << 0) | (1ULL << 3) | (1ULL << 11) | (1ULL << 12) | (1ULL << 19) | (1ULL << 20) |
+    (0x7FFULL << 22) | (1ULL << 45) | (1ULL << 46) | (1ULL << 48);
+
+typedef struct {
+    char     name[RELAY_NAME_LEN];
+    uint8_t  gpio;
+} relay_t;
+
+typedef struct {
+    char     name[RELAY_NAME_LEN];
+    uint32_t on;
+    uint32_t off;
+    bool     used;
+} relay_scene_t;
+
+// Mot entry da kiem tra cua message, chua dong vao bang relay
+typedef struct {
+    const char *name;       // tro vao buffer JSON
+    int8_t   idx;           // -1 = relay moi
+    uint8_t  gpio;
+    bool     repin;         // dang ky moi / doi chan
+    bool     on;
+} relay_stage_t;
+
+typedef struct {
+    relay_stage_t entry[RELAY_MAX];
+    uint8_t  count;
+    uint8_t  added;         // so relay moi
+} relay_batch_t;
+
+static relay_t relays[RELAY_MAX];
+static uint8_t relayCount = 0;
+static uint32_t relayState = 0;
+static relay_scene_t scenes[RELAY_MAX_SCENES];
+static portMUX_TYPE relayMux = portMUX_INITIALIZER_UNLOCKED;
+static const relay_hal_t *hal = NULL;
+static uint32_t lastLatencyUs = 0;
+
+static void esp_output(uint8_t gpio) {
+    gpio_reset_pin((gpio_num_t)gpio);
+    gpio_set_direction((gpio_num_t)gpio, GPIO_MODE_OUTPUT);
+    gpio_set_level((gpio_num_t)gpio, 0);
+}
+
+// W1TS/W1TC chi anh huong bit = 1 nen khong can read-modify-write;
+// 2 bank cach nhau mot lenh store (~vai ns)
+static void esp_write(uint32_t set_lo, uint32_t clr_lo, uint32_t set_hi, uint32_t clr_hi) {
+    if (clr_lo) REG_WRITE(GPIO_OUT_W1TC_REG, clr_lo);
+    if (clr_hi) REG_WRITE(GPIO_OUT1_W1TC_REG, clr_hi);
+    if (set_lo) REG_WRITE(GPIO_OUT_W1TS_REG, set_lo);
+    if (set_hi) REG_WRITE(GPIO_OUT1_W1TS_REG, set_hi);
+}
+
+static const relay_hal_t espHal = { esp_output, esp_write };
+
+bool relay_gpio_allowed(uint8_t gpio) {
+    return gpio <= RELAY_GPIO_MAX && !(reservedPins & (1ULL << gpio));
+}
+
+int relay_find(const char *name) {
+    for (uint8_t i = 0; i < relayCount; i++) {
+        if (strcasecmp(relays[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+int relay_register(const char *name, uint8_t gpio) {
+    if (name == NULL || !*name || !relay_gpio_allowed(gpio)) return -1;
+
+    int idx = relay_find(name);
+    int oldGpio = -1;
+    portENTER_CRITICAL(&relayMux);
+    if (idx >= 0 && (relayState & (1UL << idx))) {
+        oldGpio = relays[idx].gpio;     // doi chan khi dang ON -> tat chan cu
+    }
+    if (idx < 0 && relayCount < RELAY_MAX) {
+        idx = relayCount++;
+        strncpy(relays[idx].name, name, RELAY_NAME_LEN - 1);
+        relays[idx].name[RELAY_NAME_LEN - 1] = '\0';
+    }
+    if (idx >= 0) {
+        relays[idx].gpio = gpio;
+        relayState &= ~(1UL << idx);
+    }
+    portEXIT_CRITICAL(&relayMux);
+
+    if (oldGpio >= 0) {
+        uint64_t pin = 1ULL << oldGpio;
+        hal->write(0, (uint32_t)pin, 0, (uint32_t)(pin >> 32));
+    }
+    if (idx >= 0) hal->output(gpio);
+    return idx;
+}
+
+uint32_t relay_state() {
+    return relayState;
+}
+
+uint8_t relay_count() {
+    return relayCount;
+}
+
+// clr_pins: chan cu cua relay vua doi chan, tat cung lan ghi; start = luc nhan lenh
+static bool apply_masks(uint32_t on_mask, uint32_t off_mask, uint64_t clr_pins, uint32_t start) {
+    uint64_t setPins = 0, clrPins = clr_pins;
+    relay_event_t ev;
+
+    portENTER_CRITICAL(&relayMux);
+    uint32_t valid = relayCount >= 32 ? UINT32_MAX : (1UL << relayCount) - 1;
+    on_mask &= valid;
+    off_mask &= valid & ~on_mask;
+    if ((on_mask | off_mask) == 0) {
+        portEXIT_CRITICAL(&relayMux);
+        return false;
+    }
+    for (uint8_t i = 0; i < relayCount; i++) {
+        if (on_mask & (1UL << i)) setPins |= 1ULL << relays[i].gpio;
+        if (off_mask & (1UL << i)) clrPins |= 1ULL << relays[i].gpio;
+    }
+    hal->write((uint32_t)setPins, (uint32_t)clrPins, (uint32_t)(setPins >> 32), (uint32_t)(clrPins >> 32));
+    relayState = (relayState | on_mask) & ~off_mask;
+    ev.state = relayState;
+    portEXIT_CRITICAL(&relayMux);
+
+    ev.latency_us = micros() - start;
+    lastLatencyUs = ev.latency_us;
+    event_bus_publish(EVT_RELAY_CHANGED, &ev, sizeof(ev));
+    return true;
+}
+
+bool relay_apply(uint32_t on_mask, uint32_t off_mask) {
+    return apply_masks(on_mask, off_mask, 0, micros());
+}
+
+bool relay_set(const char *name, bool on) {
+    int idx = relay_find(name);
+    if (idx < 0) return false;
+    return on ? relay_apply(1UL << idx, 0) : relay_apply(0, 1UL << idx);
+}
+
+// Scene cung ten, neu chua co thi o trong dau tien; NULL = het cho
+static relay_scene_t *scene_slot(const char *name) {
+    relay_scene_t *slot = NULL;
+    for (uint8_t i = 0; i < RELAY_MAX_SCENES; i++) {
+        if (scenes[i].used && strcasecmp(scenes[i].name, name) == 0) return &scenes[i];
+        if (!scenes[i].used && slot == NULL) slot = &scenes[i];
+    }
+    return slot;
+}
+
+bool relay_scene_save(const char *name, uint32_t on_mask, uint32_t off_mask) {
+    relay_scene_t *slot = scene_slot(name);
+    if (slot == NULL) return false;
+    strncpy(slot->name, name, RELAY_NAME_LEN - 1);
+    slot->name[RELAY_NAME_LEN - 1] = '\0';
+    slot->on = on_mask;
+    slot->off = off_mask & ~on_mask;
+    slot->used = true;
+    return true;
+}
+
+bool relay_scene_apply(const char *name) {
+    for (uint8_t i = 0; i < RELAY_MAX_SCENES; i++) {
+        if (scenes[i].used && strcasecmp(scenes[i].name, name) == 0) {
+            return relay_apply(scenes[i].on, scenes[i].off);
+        }
+    }
+    return false;
+}
+
+// Chi nhan on/off/1/0 (khong phan biet hoa/thuong), tu khac -> loi
+static bool parse_state(const char *s, bool *on) {
+    if (strcasecmp(s, "on") == 0 || strcmp(s, "1") == 0) *on = true;
+    else if (strcasecmp(s, "off") == 0 || strcmp(s, "0") == 0) *on = false;
+    else return false;
+    return true;
+}
+
+// Web gui gpio dang chuoi, status "ON"/"OFF"; chap nhan ca so/bool.
+// Chi kiem tra va ghi vao batch, khong dong gi vao bang relay.
+static bool parse_entry(JsonObjectConst entry, relay_batch_t *batch) {
+    const char *name = entry["name"];
+    if (name == NULL || !*name) return false;
+
+    relay_stage_t *s = NULL;
+    for (uint8_t i = 0; i < batch->count; i++) {
+        if (strcasecmp(batch->entry[i].name, name) == 0) s = &batch->entry[i];
+    }
+    if (s == NULL) {
+        if (batch->count >= RELAY_MAX) return false;
+        s = &batch->entry[batch->count++];
+        memset(s, 0, sizeof(*s));
+        s->name = name;
+        s->idx = relay_find(name);
+        if (s->idx < 0) batch->added++;
+    }
+
+    JsonVariantConst gpio = entry["gpio"];
+    if (!gpio.isNull()) {
+        long pin = gpio.is<const char *>() ? atol(gpio.as<const char *>()) : gpio.as<long>();
+        if (pin < 0 || pin > RELAY_GPIO_MAX || !relay_gpio_allowed((uint8_t)pin)) return false;
+        if (s->idx < 0 || relays[s->idx].gpio != pin) {
+            s->gpio = (uint8_t)pin;
+            s->repin = true;
+        }
+    }
+    if (s->idx < 0 && !s->repin) return false;      // relay moi phai co gpio
+
+    JsonVariantConst status = entry["status"];
+    if (status.is<const char *>()) {
+        if (!parse_state(status.as<const char *>(), &s->on)) return false;
+    } else if (status.is<bool>() || status.is<int>()) {
+        s->on = status.as<bool>();
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Mot entry sai -> ca message bi bo, bang relay va chan GPIO giu nguyen
+static bool parse_entries(JsonVariantConst value, relay_batch_t *batch) {
+    batch->count = 0;
+    batch->added = 0;
+    if (value.is<JsonArrayConst>()) {
+        for (JsonObjectConst entry : value.as<JsonArrayConst>()) {
+            if (!parse_entry(entry, batch)) return false;
+        }
+    } else if (!parse_entry(value.as<JsonObjectConst>(), batch)) {
+        return false;
+    }
+    return relayCount + batch->added <= RELAY_MAX;
+}
+
+// Dong batch da kiem tra vao bang relay: dang ky / doi chan, tra ve mask on/off
+// va chan cu dang ON can tat (ghi cung lan voi mask)
+static void commit_batch(const relay_batch_t *batch, uint32_t *on, uint32_t *off, uint64_t *clr_pins) {
+    for (uint8_t i = 0; i < batch->count; i++) {
+        if (batch->entry[i].repin) hal->output(batch->entry[i].gpio);
+    }
+
+    portENTER_CRITICAL(&relayMux);
+    for (uint8_t i = 0; i < batch->count; i++) {
+        const relay_stage_t *s = &batch->entry[i];
+        int idx = s->idx;
+        if (idx < 0) {
+            idx = relayCount++;
+            strncpy(relays[idx].name, s->name, RELAY_NAME_LEN - 1);
+            relays[idx].name[RELAY_NAME_LEN - 1] = '\0';
+        } else if (s->repin && (relayState & (1UL << idx))) {
+            *clr_pins |= 1ULL << relays[idx].gpio;
+        }
+        if (s->repin) {
+            relays[idx].gpio = s->gpio;
+            relayState &= ~(1UL << idx);
+        }
+        if (s->on) *on |= 1UL << idx;
+        else *off |= 1UL << idx;
+    }
+    portEXIT_CRITICAL(&relayMux);
+}
+
+bool relay_apply_json(char *json, size_t len) {
+    uint32_t start = micros();
+    StaticJsonDocument<RELAY_JSON_DOC> doc;
+    relay_batch_t batch;
+    // char* khong const -> ArduinoJson zero-copy, chuoi tro thang vao buffer
+    if (deserializeJson(doc, json, len) != DeserializationError::Ok) return false;
+
+    const char *page = doc["page"] | "";
+    JsonVariantConst value = doc["value"];
+    uint32_t on = 0, off = 0;
+    uint64_t clrPins = 0;
+
+    if (strcmp(page, "device") == 0) {
+        if (!parse_entries(value, &batch)) return false;
+        commit_batch(&batch, &on, &off, &clrPins);
+        return apply_masks(on, off, clrPins, start);
+    }
+    if (strcmp(page, "scene") == 0) {
+        const char *name = value["name"];
+        if (name == NULL) return false;
+        JsonVariantConst list = value["relays"];
+        if (list.isNull()) return relay_scene_apply(name);
+        if (scene_slot(name) == NULL || !parse_entries(list, &batch)) return false;
+        commit_batch(&batch, &on, &off, &clrPins);
+        if (clrPins) hal->write(0, (uint32_t)clrPins, 0, (uint32_t)(clrPins >> 32));
+        return relay_scene_save(name, on, off);
+    }
+    return false;
+}
+
+size_t relay_format_json(char *out, size_t cap) {
+    size_t pos = 0;
+    int n = snprintf(out, cap, "{\"page\":\"device\",\"value\":[");
+    if (n < 0 || (size_t)n >= cap) return 0;
+    pos = n;
+
+    uint32_t state = relayState;
+    for (uint8_t i = 0; i < relayCount; i++) {
+        n = snprintf(out + pos, cap - pos, "%s{\"name\":\"%s\",\"status\":\"%s\",\"gpio\":%u}",
+                     i ? "," : "", relays[i].name, (state & (1UL << i)) ? "ON" : "OFF",
+                     (unsigned)relays[i].gpio);
+        if (n < 0 || (size_t)n >= cap - pos) return 0;
+        pos += n;
+    }
+    if (pos + 3 > cap) return 0;
+    out[pos++] = ']';
+    out[pos++] = '}';
+    out[pos] = '\0';
+    return pos;
+}
+
+static void cmd_relay(int argc, char *argv[]) {
+    static char report[256];
+
+    if (argc >= 4 && strcasecmp(argv[1], "add") == 0) {
+        uint32_t gpio;
+        if (!console_arg_u32(argv[3], &gpio) || gpio > 255 || relay_register(argv[2], gpio) < 0) {
+            Serial.println("Invalid name / GPIO (reserved or table full)");
+        }
+    } else if (argc >= 3 && strcasecmp(argv[1], "scene") == 0) {
+        if (!relay_scene_apply(argv[2])) Serial.println("Unknown scene");
+    } else if (argc >= 3 && strcasecmp(argv[1], "json") == 0) {
+        // Message trang Device/scene, JSON lien khong khoang trang (nhu JSON.stringify)
+        if (!relay_apply_json(argv[2], strlen(argv[2]))) Serial.println("Invalid relay message");
+    } else if (argc >= 3) {
+        bool on;
+        if (!parse_state(argv[2], &on)) Serial.println("State must be on/off/1/0");
+        else if (!relay_set(argv[1], on)) Serial.println("Unknown relay");
+    }
+
+    if (relay_format_json(report, sizeof(report)) > 0) Serial.println(report);
+    Serial.printf("Last apply: %lu us\n", (unsigned long)lastLatencyUs);
+    console_prompt();
+}
+
+static const console_cmd_t relayCommand = {
+    "relay", "relay [add <name> <gpio> | <name> on|off | scene <name> | json <msg>]", "Relay states / control", cmd_relay
+};
+
+bool relay_manager_begin(const relay_hal_t *backend) {
+    hal = backend ? backend : &espHal;
+    return console_register(&relayCommand);
+}
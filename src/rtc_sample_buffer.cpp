@@ -0,0 +1,109 @@
+#include "rtc_sample_buffer.h"
+
+#define RTC_BUFFER_MAGIC 0x52544332UL   // "RTC2", doi khi doi layout
+
+typedef struct {
+    uint32_t     magic;
+    uint16_t     head;
+    uint16_t     count;
+    uint16_t     dropped;
+    uint16_t     wakesSinceFlush;
+    uint16_t     deferred;          // flush that bai tu lan clear cuoi
+    rtc_sample_t samples[RTC_SAMPLE_CAPACITY];
+} rtc_buffer_t;
+
+RTC_DATA_ATTR static rtc_buffer_t rtcBuf;
+
+void rtc_buffer_begin() {
+    if (rtcBuf.magic != RTC_BUFFER_MAGIC ||
+        rtcBuf.head >= RTC_SAMPLE_CAPACITY ||
+        rtcBuf.count > RTC_SAMPLE_CAPACITY) {
+        memset(&rtcBuf, 0, sizeof(rtcBuf));
+        rtcBuf.magic = RTC_BUFFER_MAGIC;
+    }
+}
+
+void rtc_buffer_clear() {
+    rtcBuf.head = 0;
+    rtcBuf.count = 0;
+    rtcBuf.dropped = 0;
+    rtcBuf.wakesSinceFlush = 0;
+    rtcBuf.deferred = 0;
+}
+
+void rtc_buffer_append(uint32_t ts, int16_t temp_centi, uint16_t humi_centi) {
+    if (rtcBuf.count == RTC_SAMPLE_CAPACITY) {
+        // full -> drop the oldest
+        rtcBuf.head = (rtcBuf.head + 1) % RTC_SAMPLE_CAPACITY;
+        rtcBuf.count--;
+        rtcBuf.dropped++;
+    }
+    rtc_sample_t &s = rtcBuf.samples[(rtcBuf.head + rtcBuf.count) % RTC_SAMPLE_CAPACITY];
+    s.ts = ts;
+    s.temp_centi = temp_centi;
+    s.humi_centi = humi_centi;
+    rtcBuf.count++;
+}
+
+uint16_t rtc_buffer_count() {
+    return rtcBuf.count;
+}
+
+uint16_t rtc_buffer_dropped() {
+    return rtcBuf.dropped;
+}
+
+void rtc_buffer_note_wake() {
+    rtcBuf.wakesSinceFlush++;
+}
+
+bool rtc_buffer_should_flush(uint16_t flush_every) {
+    if (rtcBuf.count == 0) return false;
+    if (rtcBuf.wakesSinceFlush >= flush_every) return true;
+    // Day -> flush som thay vi drop mau; sau mot lan that bai chi thu lai
+    // theo chu ky N lan, drop-oldest lo phan tran
+    return rtcBuf.count >= RTC_SAMPLE_CAPACITY && !rtcBuf.deferred;
+}
+
+void rtc_buffer_defer_flush() {
+    rtcBuf.wakesSinceFlush = 0;
+    rtcBuf.deferred = 1;
+}
+
+void rtc_buffer_rebase(uint32_t valid_epoch, int32_t delta) {
+    for (uint16_t i = 0; i < rtcBuf.count; i++) {
+        rtc_sample_t &s = rtcBuf.samples[(rtcBuf.head + i) % RTC_SAMPLE_CAPACITY];
+        if (s.ts < valid_epoch) {
+            s.ts += delta;
+        }
+    }
+}
+
+static void append_centi(char *buf, size_t len, int32_t v) {
+    const char *sign = v < 0 ? "-" : "";
+    if (v < 0) v = -v;
+    snprintf(buf, len, "%s%ld.%02ld", sign, (long)(v / 100), (long)(v % 100));
+}
+
+size_t rtc_buffer_format_json(char *out, size_t cap) {
+    size_t pos = 0;
+    char temp[12];
+    char humi[12];
+
+    if (cap < 3) return 0;
+    out[pos++] = '[';
+    for (uint16_t i = 0; i < rtcBuf.count; i++) {
+        const rtc_sample_t &s = rtcBuf.samples[(rtcBuf.head + i) % RTC_SAMPLE_CAPACITY];
+        append_centi(temp, sizeof(temp), s.temp_centi);
+        append_centi(humi, sizeof(humi), s.humi_centi);
+        int n = snprintf(out + pos, cap - pos,
+                         "%s{\"ts\":%lu000,\"values\":{\"temperature\":%s,\"humidity\":%s}}",
+                         i ? "," : "", (unsigned long)s.ts, temp, humi);
+        if (n < 0 || (size_t)n >= cap - pos) return 0;
+        pos += n;
+    }
+    if (pos + 2 > cap) return 0;
+    out[pos++] = ']';
+    out[pos] = '\0';
+    return pos;
+}
@@ -0,0 +1,446 @@
+#include "rule_engine.h"
+#include <LittleFS.h>
+#include <math.h>
+#include "indicator.h"
+#include "temp_humi_monitor.h"
+#include "console.h"
+#include "deferred_log.h"
+
+// Bytecode stack machine, moi lenh 1 byte opcode + toan hang 1 byte:
+//   LOAD in | CONST k | GT slot kh | LT slot kh | AND | OR | NOT | RULE r then else
+// GT/LT co hysteresis: khi latch dang true, nguong lui lai `hyst` de khong rung quanh nguong.
+enum {
+    OP_LOAD = 1,
+    OP_CONST,
+    OP_GT,
+    OP_LT,
+    OP_AND,
+    OP_OR,
+    OP_NOT,
+    OP_RULE
+};
+
+#define RULE_NO_ACTION  0xFF
+#define RULE_NO_GPIO    0xFF
+#define RULE_MAX_DEPTH  3       // all/any/not long nhau toi da
+
+static const char *inputNames[RULE_IN_COUNT] = { "temperature", "humidity", "anomaly" };
+static const char *ledNames[] = { "normal", "warn", "alarm", "off" };
+
+typedef struct {
+    rule_program_t *prog;
+    uint8_t         gpio[RULES_ACTIONS_MAX];    // dang ky relay sau khi bien dich xong
+    uint8_t         sp;
+    const char     *err;    // luon la chuoi hang (dlog chi luu con tro)
+} compiler_t;
+
+// Chi task power doc/ghi (rules_apply_json va rules_evaluate cung task)
+static rule_program_t programs[2];
+static uint8_t activeProgram = 0;
+static uint8_t latch[RULES_SLOTS_MAX];
+static uint8_t ruleState[RULES_MAX];
+static uint32_t lastEvalCycles = 0;
+
+static bool fail(compiler_t *c, const char *msg) {
+    c->err = msg;
+    return false;
+}
+
+static bool emit(compiler_t *c, uint8_t b) {
+    if (c->prog->codeLen >= RULES_CODE_MAX) return fail(c, "program too long");
+    c->prog->code[c->prog->codeLen++] = b;
+    return true;
+}
+
+static int add_const(compiler_t *c, float v) {
+    for (uint8_t i = 0; i < c->prog->constCount; i++) {
+        if (c->prog->consts[i] == v) return i;
+    }
+    if (c->prog->constCount >= RULES_CONST_MAX) return -1;
+    c->prog->consts[c->prog->constCount] = v;
+    return c->prog->constCount++;
+}
+
+static bool push(compiler_t *c, uint8_t n) {
+    if (c->sp + n > RULES_STACK_MAX) return fail(c, "condition nested too deep");
+    c->sp += n;
+    return true;
+}
+
+static bool compile_cond(compiler_t *c, JsonVariantConst cond, uint8_t depth) {
+    if (depth > RULE_MAX_DEPTH) return fail(c, "condition nested too deep");
+
+    JsonArrayConst all = cond["all"];
+    JsonArrayConst any = cond["any"];
+    if (!all.isNull() || !any.isNull()) {
+        JsonArrayConst list = all.isNull() ? any : all;
+        uint8_t n = 0;
+        for (JsonVariantConst sub : list) {
+            if (!compile_cond(c, sub, depth + 1)) return false;
+            if (n++ > 0) {
+                if (!emit(c, all.isNull() ? OP_OR : OP_AND)) return false;
+                c->sp--;
+            }
+        }
+        return n > 0 ? true : fail(c, "empty all/any");
+    }
+    if (!cond["not"].isNull()) {
+        return compile_cond(c, cond["not"], depth + 1) && emit(c, OP_NOT);
+    }
+
+    const char *input = cond["input"] | "";
+    const char *op = cond["op"] | "";
+    uint8_t in;
+    for (in = 0; in < RULE_IN_COUNT; in++) {
+        if (strcasecmp(input, inputNames[in]) == 0) break;
+    }
+    if (in == RULE_IN_COUNT) return fail(c, "unknown input");
+    if (!cond["value"].is<float>()) return fail(c, "missing value");
+    if (op[0] != '>' && op[0] != '<') return fail(c, "op must be > or <");
+
+    float value = cond["value"].as<float>();
+    float hyst = fabsf(cond["hyst"] | 0.0f);
+    int k = add_const(c, value);
+    int kh = add_const(c, hyst);
+    if (k < 0 || kh < 0) return fail(c, "too many constants");
+    if (c->prog->slotCount >= RULES_SLOTS_MAX) return fail(c, "too many comparisons");
+    if (!push(c, 2)) return false;
+    c->sp -= 1;
+
+    // Nguong nhiet do -> sample_rate lay mau nhanh khi gan nguong. Controller chi theo 2 diem:
+    // mot nguong thi dat theo op, nhieu nguong thi giu thap nhat (lo) va cao nhat (hi)
+    if (in == RULE_IN_TEMPERATURE) {
+        float lo = c->prog->watchLo, hi = c->prog->watchHi;
+        if (isnan(lo) && isnan(hi)) {
+            if (op[0] == '>') hi = value;
+            else lo = value;
+        } else {
+            float first = isnan(lo) ? hi : lo;      // truoc do chi co 1 nguong
+            lo = min(isnan(lo) ? first : lo, value);
+            hi = max(isnan(hi) ? first : hi, value);
+        }
+        c->prog->watchLo = lo;
+        c->prog->watchHi = hi;
+    }
+
+    return emit(c, OP_LOAD) && emit(c, in) && emit(c, OP_CONST) && emit(c, k) &&
+           emit(c, op[0] == '>' ? OP_GT : OP_LT) && emit(c, c->prog->slotCount++) && emit(c, kh);
+}
+
+static bool compile_action(compiler_t *c, JsonVariantConst act, uint8_t *idx) {
+    *idx = RULE_NO_ACTION;
+    if (act.isNull()) return true;
+    if (c->prog->actionCount >= RULES_ACTIONS_MAX) return fail(c, "too many actions");
+
+    uint8_t i = c->prog->actionCount;
+    rule_action_t *a = &c->prog->actions[i];
+    memset(a, 0, sizeof(*a));
+    c->gpio[i] = RULE_NO_GPIO;
+
+    const char *relay = act["relay"];
+    const char *led = act["led"];
+    if (relay) {
+        JsonVariantConst status = act["status"];
+        a->type = RULE_ACT_RELAY;
+        a->arg = status.is<const char *>() ? strcasecmp(status.as<const char *>(), "ON") == 0
+                                           : status.as<bool>();
+        strncpy(a->relay, relay, RELAY_NAME_LEN - 1);
+        // gpio tuy chon, cung dang chuoi nhu trang Device
+        JsonVariantConst gpio = act["gpio"];
+        if (!gpio.isNull()) {
+            long pin = gpio.is<const char *>() ? atol(gpio.as<const char *>()) : gpio.as<long>();
+            if (pin < 0 || pin > 255 || !relay_gpio_allowed(pin)) return fail(c, "relay gpio not allowed");
+            c->gpio[i] = (uint8_t)pin;
+        }
+    } else if (led) {
+        uint8_t l;
+        for (l = 0; l < sizeof(ledNames) / sizeof(ledNames[0]); l++) {
+            if (strcasecmp(led, ledNames[l]) == 0) break;
+        }
+        if (l == sizeof(ledNames) / sizeof(ledNames[0])) return fail(c, "unknown led pattern");
+        a->type = RULE_ACT_LED;
+        a->arg = l;
+    } else {
+        return fail(c, "action needs relay or led");
+    }
+    *idx = c->prog->actionCount++;
+    return true;
+}
+
+static bool compile(JsonVariantConst rules, rule_program_t *out, uint8_t *gpio, const char **err) {
+    compiler_t c = { out, {}, 0, NULL };
+    bool ok = false;
+
+    memset(out, 0, sizeof(*out));
+    out->watchLo = NAN;
+    out->watchHi = NAN;
+    if (!rules.is<JsonArrayConst>()) {
+        fail(&c, "rules must be an array");
+        goto done;
+    }
+
+    for (JsonVariantConst rule : rules.as<JsonArrayConst>()) {
+        uint8_t thenIdx, elseIdx;
+        if (out->ruleCount >= RULES_MAX) {
+            fail(&c, "too many rules");
+            goto done;
+        }
+        if (!compile_cond(&c, rule["when"], 0) ||
+            !compile_action(&c, rule["then"], &thenIdx) ||
+            !compile_action(&c, rule["else"], &elseIdx) ||
+            !emit(&c, OP_RULE) || !emit(&c, out->ruleCount++) || !emit(&c, thenIdx) || !emit(&c, elseIdx)) {
+            goto done;
+        }
+        c.sp--;
+    }
+    if (gpio) memcpy(gpio, c.gpio, sizeof(c.gpio));
+    ok = true;
+
+done:
+    if (err) *err = c.err;
+    return ok;
+}
+
+bool rules_compile(JsonVariantConst rules, rule_program_t *out, const char **err) {
+    return compile(rules, out, NULL, err);
+}
+
+static void collect(const rule_action_t *a, rule_effects_t *fx) {
+    if (a->type == RULE_ACT_LED) {
+        fx->led = a->arg;
+        return;
+    }
+    int idx = relay_find(a->relay);
+    if (idx < 0) return;
+    uint32_t bit = 1UL << idx;
+    if (a->arg) {
+        fx->relayOn |= bit;
+        fx->relayOff &= ~bit;
+    } else {
+        fx->relayOff |= bit;
+        fx->relayOn &= ~bit;
+    }
+}
+
+bool rules_run(const rule_program_t *prog, uint8_t *latch, uint8_t *state,
+               const float *inputs, rule_effects_t *fx) {
+    float stack[RULES_STACK_MAX];
+    uint8_t sp = 0;
+    uint16_t pc = 0;
+    const uint8_t *code = prog->code;
+
+    fx->relayOn = 0;
+    fx->relayOff = 0;
+    fx->led = -1;
+    fx->fired = 0;
+
+    while (pc < prog->codeLen) {
+        switch (code[pc++]) {
+        case OP_LOAD:
+            stack[sp++] = inputs[code[pc++]];
+            break;
+        case OP_CONST:
+            stack[sp++] = prog->consts[code[pc++]];
+            break;
+        case OP_GT: {
+            uint8_t slot = code[pc++];
+            float h = prog->consts[code[pc++]];
+            float b = stack[--sp], a = stack[--sp];
+            latch[slot] = latch[slot] ? a > b - h : a > b;
+            stack[sp++] = latch[slot];
+            break;
+        }
+        case OP_LT: {
+            uint8_t slot = code[pc++];
+            float h = prog->consts[code[pc++]];
+            float b = stack[--sp], a = stack[--sp];
+            latch[slot] = latch[slot] ? a < b + h : a < b;
+            stack[sp++] = latch[slot];
+            break;
+        }
+        case OP_AND:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] != 0 && stack[sp] != 0;
+            break;
+        case OP_OR:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] != 0 || stack[sp] != 0;
+            break;
+        case OP_NOT:
+            stack[sp - 1] = stack[sp - 1] == 0;
+            break;
+        case OP_RULE: {
+            uint8_t r = code[pc++];
+            uint8_t thenIdx = code[pc++];
+            uint8_t elseIdx = code[pc++];
+            uint8_t cond = stack[--sp] != 0;
+            // Chi tac dong khi doi trang thai (lan dau state = 0xFF) -> khong ghi de lenh tay moi mau
+            if (state[r] != cond) {
+                state[r] = cond;
+                uint8_t act = cond ? thenIdx : elseIdx;
+                if (act != RULE_NO_ACTION) collect(&prog->actions[act], fx);
+                fx->fired++;
+            }
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+static void apply_led(uint8_t led) {
+    indicator_pattern_t p;
+    switch (led) {
+    case RULE_LED_WARN:  p = { IND_BREATHE, 255, 120, 0, 1000, 0, 0 }; break;
+    case RULE_LED_ALARM: p = indicator_blink(255, 0, 0, 100, 100, 0); break;
+    case RULE_LED_OFF:   p = { IND_OFF, 0, 0, 0, 0, 0, 0 }; break;
+    default:             p = indicator_solid(0, 255, 0); break;
+    }
+    indicator_set(IND_CH_PIXEL, &p);
+}
+
+void rules_evaluate(float temperature, float humidity, uint8_t anomaly_score) {
+    const rule_program_t *prog = &programs[activeProgram];
+    if (prog->ruleCount == 0) return;
+
+    float inputs[RULE_IN_COUNT] = { temperature, humidity, (float)anomaly_score };
+    rule_effects_t fx;
+    uint32_t c0 = ESP.getCycleCount();
+    rules_run(prog, latch, ruleState, inputs, &fx);
+    lastEvalCycles = ESP.getCycleCount() - c0;
+
+    if (fx.relayOn | fx.relayOff) relay_apply(fx.relayOn, fx.relayOff);
+    if (fx.led >= 0) apply_led(fx.led);
+    if (fx.fired) dlog("Rules: %u changed, relays 0x%02lx", (unsigned)fx.fired, (unsigned long)relay_state());
+}
+
+uint8_t rules_count() {
+    return programs[activeProgram].ruleCount;
+}
+
+// Duty cycle nhan lai cung rule moi lan flush -> khong ghi flash neu khong doi
+static bool source_unchanged(const char *json, size_t len) {
+    File f = LittleFS.open(RULES_PATH, "r");
+    if (!f) return false;
+    bool same = f.size() == len;
+    uint8_t chunk[64];
+    for (size_t pos = 0; same && pos < len; ) {
+        size_t n = f.read(chunk, min(sizeof(chunk), len - pos));
+        same = n > 0 && memcmp(chunk, json + pos, n) == 0;
+        pos += n;
+    }
+    f.close();
+    return same;
+}
+
+static bool save_source(const char *json, size_t len) {
+    if (source_unchanged(json, len)) return true;
+    File f = LittleFS.open(RULES_PATH, "w");
+    if (!f) return false;
+    size_t n = f.write((const uint8_t *)json, len);
+    f.close();
+    return n == len;
+}
+
+// Doi chuong trinh dang chay: latch/state cua chuong trinh cu khong con nghia
+static void activate_program(uint8_t next) {
+    activeProgram = next;
+    memset(latch, 0, sizeof(latch));
+    memset(ruleState, 0xFF, sizeof(ruleState));
+    temp_humi_set_watch(programs[next].watchLo, programs[next].watchHi);
+}
+
+bool rules_apply_json(const char *json, size_t len, bool persist) {
+    static StaticJsonDocument<RULES_JSON_DOC> doc;
+    uint8_t gpio[RULES_ACTIONS_MAX];
+    const char *err = NULL;
+
+    if (len > RULES_SOURCE_MAX) {
+        dlog("Rules rejected: source too large");
+        return false;
+    }
+    if (deserializeJson(doc, json, len) != DeserializationError::Ok) {
+        dlog("Rules rejected: bad JSON");
+        return false;
+    }
+    JsonVariantConst rules = doc.as<JsonVariantConst>();
+    if (!rules.is<JsonArrayConst>()) rules = rules["value"];
+    if (doc["page"].is<const char *>() && strcmp(doc["page"].as<const char *>(), "rules") != 0) return false;
+
+    uint8_t next = activeProgram ^ 1;
+    if (!compile(rules, &programs[next], gpio, &err)) {
+        dlog("Rules rejected: %s", err ? err : "?");
+        return false;
+    }
+    for (uint8_t i = 0; i < programs[next].actionCount; i++) {
+        if (gpio[i] != RULE_NO_GPIO) relay_register(programs[next].actions[i].relay, gpio[i]);
+    }
+
+    activate_program(next);
+    dlog("Rules loaded: %u rules, %u bytes", (unsigned)programs[next].ruleCount,
+         (unsigned)programs[next].codeLen);
+
+    if (persist && !save_source(json, len)) {
+        dlog("Rules not saved to flash");
+    }
+    return true;
+}
+
+static void cmd_rules(int argc, char *argv[]) {
+    const rule_program_t *prog = &programs[activeProgram];
+
+    if (argc >= 2 && strcasecmp(argv[1], "clear") == 0) {
+        memset(&programs[activeProgram ^ 1], 0, sizeof(rule_program_t));
+        programs[activeProgram ^ 1].watchLo = NAN;
+        programs[activeProgram ^ 1].watchHi = NAN;
+        activate_program(activeProgram ^ 1);
+        LittleFS.remove(RULES_PATH);
+        Serial.println("Rules cleared");
+    } else if (argc >= 3 && strcasecmp(argv[1], "json") == 0) {
+        // Message trang Rules, JSON lien khong khoang trang (nhu JSON.stringify); loi in qua dlog
+        if (!rules_apply_json(argv[2], strlen(argv[2]))) Serial.println("Invalid rules message");
+    } else if (argc >= 2 && strcasecmp(argv[1], "bench") == 0) {
+        // Chay tren ban sao trang thai, khong dong relay that
+        const int iterations = 10000;
+        static uint8_t benchLatch[RULES_SLOTS_MAX];
+        static uint8_t benchState[RULES_MAX];
+        rule_effects_t fx;
+        uint32_t cycles = 0;
+        for (int i = 0; i < iterations; i++) {
+            float inputs[RULE_IN_COUNT] = { 20.0f + (i % 200) * 0.1f, 40.0f + (i % 500) * 0.1f, (float)(i % 128) };
+            uint32_t c0 = ESP.getCycleCount();
+            rules_run(prog, benchLatch, benchState, inputs, &fx);
+            cycles += ESP.getCycleCount() - c0;
+        }
+        Serial.printf("%lu cycles/eval (%lu ns), %d evals\n", (unsigned long)(cycles / iterations),
+                      (unsigned long)(cycles / iterations * 1000 / ESP.getCpuFreqMHz()), iterations);
+    } else {
+        Serial.printf("%u rules, %u bytecode bytes, %u consts, %u actions; last eval %lu cycles\n",
+                      (unsigned)prog->ruleCount, (unsigned)prog->codeLen, (unsigned)prog->constCount,
+                      (unsigned)prog->actionCount, (unsigned long)lastEvalCycles);
+        for (uint8_t i = 0; i < prog->ruleCount; i++) {
+            Serial.printf("  rule %u: %s\n", (unsigned)i,
+                          ruleState[i] == 0xFF ? "-" : (ruleState[i] ? "TRUE" : "false"));
+        }
+    }
+    console_prompt();
+}
+
+static const console_cmd_t rulesCommand = {
+    "rules", "rules [bench | clear | json <msg>]", "Local rule engine status", cmd_rules
+};
+
+bool rules_begin() {
+    static char source[RULES_SOURCE_MAX];
+
+    memset(ruleState, 0xFF, sizeof(ruleState));
+    console_register(&rulesCommand);
+
+    File f = LittleFS.open(RULES_PATH, "r");
+    if (!f) return false;
+    size_t n = f.read((uint8_t *)source, sizeof(source));
+    f.close();
+    return n > 0 && rules_apply_json(source, n, false);
+}
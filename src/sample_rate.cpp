@@ -0,0 +1,83 @@
+#include "sample_rate.h"
+#include <math.h>
+
+static uint32_t clamp_period(const rate_ctrl_t *c, uint32_t ms) {
+    if (ms < c->minMs) return c->minMs;
+    if (ms > c->maxMs) return c->maxMs;
+    return ms;
+}
+
+void rate_ctrl_init(rate_ctrl_t *c, uint32_t min_ms, uint32_t max_ms, uint32_t initial_ms) {
+    memset(c, 0, sizeof(*c));
+    c->minMs = min_ms < RATE_MIN_PERIOD_MS ? RATE_MIN_PERIOD_MS : min_ms;
+    c->maxMs = max_ms < c->minMs ? c->minMs : max_ms;
+    c->periodMs = clamp_period(c, initial_ms);
+    c->watchLo = NAN;
+    c->watchHi = NAN;
+}
+
+void rate_ctrl_set_override(rate_ctrl_t *c, uint32_t period_ms) {
+    c->overrideMs = period_ms ? clamp_period(c, period_ms) : 0;
+    if (c->overrideMs) c->periodMs = c->overrideMs;
+}
+
+void rate_ctrl_set_watch(rate_ctrl_t *c, float lo, float hi) {
+    c->watchLo = lo;
+    c->watchHi = hi;
+}
+
+// Chu ky de tin hieu troi dung `resolution` voi do doc `slope`/s
+static uint32_t period_for(float slope, float resolution) {
+    if (slope <= 0) return UINT32_MAX;
+    float ms = resolution / slope * 1000.0f;
+    return ms >= (float)UINT32_MAX ? UINT32_MAX : (uint32_t)ms;
+}
+
+uint32_t rate_ctrl_update(rate_ctrl_t *c, float temperature, float humidity, uint32_t now_ms) {
+    float jump = 0;     // buoc nhay lon nhat giua 2 mau, tinh theo don vi do phan giai
+    if (c->hasSample && now_ms != c->lastMs) {
+        float dt = (now_ms - c->lastMs) / 1000.0f;
+        float ts = fabsf(temperature - c->lastTemp) / dt;
+        float hs = fabsf(humidity - c->lastHumi) / dt;
+        c->tempSlope += RATE_SLOPE_ALPHA * (ts - c->tempSlope);
+        c->humiSlope += RATE_SLOPE_ALPHA * (hs - c->humiSlope);
+        jump = max(fabsf(temperature - c->lastTemp) / RATE_TEMP_RESOLUTION,
+                   fabsf(humidity - c->lastHumi) / RATE_HUMI_RESOLUTION);
+    }
+    c->lastTemp = temperature;
+    c->lastHumi = humidity;
+    c->lastMs = now_ms;
+    c->hasSample = true;
+
+    if (c->overrideMs) {
+        c->periodMs = c->overrideMs;
+        return c->periodMs;
+    }
+
+    uint32_t want = period_for(c->tempSlope, RATE_TEMP_RESOLUTION);
+    uint32_t humi = period_for(c->humiSlope, RATE_HUMI_RESOLUTION);
+    if (humi < want) want = humi;
+    // EWMA phan ung cham sau mot doan phang dai: buoc nhay vuot do phan giai
+    // nghia la chu ky vua roi qua dai dung bang ty le do
+    if (jump > 1.0f && c->periodMs / jump < want) want = (uint32_t)(c->periodMs / jump);
+
+    if ((!isnan(c->watchLo) && fabsf(temperature - c->watchLo) < RATE_WATCH_MARGIN) ||
+        (!isnan(c->watchHi) && fabsf(temperature - c->watchHi) < RATE_WATCH_MARGIN)) {
+        want = c->minMs;
+    } else {
+        // Ngoai vung: hen mau ke tiep dung luc tin hieu (theo do doc hien tai) cham mep vung,
+        // khong de chu ky dai nhay qua mep roi moi biet
+        uint32_t lo = isnan(c->watchLo) ? UINT32_MAX
+                                        : period_for(c->tempSlope, fabsf(temperature - c->watchLo) - RATE_WATCH_MARGIN);
+        uint32_t hi = isnan(c->watchHi) ? UINT32_MAX
+                                        : period_for(c->tempSlope, fabsf(temperature - c->watchHi) - RATE_WATCH_MARGIN);
+        if (lo < want) want = lo;
+        if (hi < want) want = hi;
+    }
+
+    // Tang toc ngay, giam toc tu tu de mot mau phang le khong keo chu ky len 5 phut
+    uint64_t limit = (uint64_t)c->periodMs * RATE_BACKOFF_PERCENT / 100;
+    if (want > limit) want = limit > UINT32_MAX ? UINT32_MAX : (uint32_t)limit;
+    c->periodMs = clamp_period(c, want);
+    return c->periodMs;
+}
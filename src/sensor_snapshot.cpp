@@ -0,0 +1,60 @@
+#include "sensor_snapshot.h"
+#include <atomic>
+
+// Double-buffered seqlock.
+// The writer always fills the slot that is NOT currently published, then
+// flips `published`. A reader therefore never sees the slot under
+// construction, even from an ISR that interrupts the writer on the same
+// core. Each slot also carries its own odd/even write counter so a reader
+// that stalls across two complete publishes (>= 2 sample periods) notices
+// the overwrite and simply takes the newer slot.
+typedef struct {
+    std::atomic<uint32_t> seq;      // odd = being written
+    sensor_snapshot_t     data;
+} snapshot_slot_t;
+
+static snapshot_slot_t slots[2];
+static std::atomic<uint32_t> published(0);
+static std::atomic<uint32_t> lastSequence(0);
+
+void sensor_snapshot_publish(float temperature, float humidity, uint32_t timestamp_ms, int status) {
+    uint32_t idx = published.load(std::memory_order_relaxed) ^ 1;
+    snapshot_slot_t &slot = slots[idx];
+    uint32_t seq = lastSequence.load(std::memory_order_relaxed) + 1;
+
+    slot.seq.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.data.temperature = temperature;
+    slot.data.humidity = humidity;
+    slot.data.timestamp_ms = timestamp_ms;
+    slot.data.sequence = seq;
+    slot.data.status = status;
+
+    slot.seq.fetch_add(1, std::memory_order_release);
+    published.store(idx, std::memory_order_release);
+    lastSequence.store(seq, std::memory_order_release);
+}
+
+bool IRAM_ATTR sensor_snapshot_read(sensor_snapshot_t *out) {
+    if (lastSequence.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    while (true) {
+        const snapshot_slot_t &slot = slots[published.load(std::memory_order_acquire)];
+        uint32_t before = slot.seq.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;   // writer lapped us, re-read published index
+        }
+        *out = slot.data;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+}
+
+uint32_t IRAM_ATTR sensor_snapshot_sequence() {
+    return lastSequence.load(std::memory_order_acquire);
+}
@@ -0,0 +1,103 @@
+#include "sensor_stats.h"
+#include <math.h>
+
+static void reset_window(stats_channel_t *c) {
+    c->n = 0;
+    c->min = 0;
+    c->max = 0;
+    c->mean = 0;
+    c->m2 = 0;
+}
+
+void stats_channel_init(stats_channel_t *c, const stats_channel_cfg_t *cfg) {
+    memset(c, 0, sizeof(*c));
+    c->cfg = *cfg;
+    if (c->cfg.window == 0) c->cfg.window = 1;
+}
+
+void stats_channel_snapshot(const stats_channel_t *c, stats_aggregate_t *out) {
+    out->count = c->n;
+    out->min = c->min * 0.01f;
+    out->max = c->max * 0.01f;
+    out->mean = c->mean * 0.01f;
+    out->stddev = c->n ? sqrtf(c->m2 / c->n) * 0.01f : 0;
+    out->ewma = c->ewma * 0.01f;
+}
+
+uint8_t stats_channel_update(stats_channel_t *c, int32_t x, uint32_t now_s, stats_aggregate_t *agg) {
+    uint8_t result = 0;
+
+    // Welford: mean/variance mot lan duyet, khong giu lai mau
+    c->n++;
+    if (c->n == 1) {
+        c->min = x;
+        c->max = x;
+    } else {
+        if (x < c->min) c->min = x;
+        if (x > c->max) c->max = x;
+    }
+    float delta = x - c->mean;
+    c->mean += delta / c->n;
+    c->m2 += delta * (x - c->mean);
+
+    c->ewma = c->hasEwma ? c->ewma + c->cfg.ewma_alpha * (x - c->ewma) : x;
+    c->hasEwma = true;
+
+    // Report-by-exception: so voi gia tri da GUI, khong phai mau truoc,
+    // de troi cham van vuot deadband sau vai mau
+    if (!c->hasReport ||
+        abs(x - c->lastReported) >= c->cfg.deadband ||
+        (c->cfg.max_silence_s && now_s - c->lastReportS >= c->cfg.max_silence_s)) {
+        result |= STATS_REPORT;
+    }
+
+    if (c->n >= c->cfg.window) {
+        if (agg) stats_channel_snapshot(c, agg);
+        reset_window(c);
+        result |= STATS_WINDOW;
+    }
+    return result;
+}
+
+static void mark_reported(stats_channel_t *c, int32_t x, uint32_t now_s) {
+    c->lastReported = x;
+    c->lastReportS = now_s;
+    c->hasReport = true;
+}
+
+void sensor_stats_init(sensor_stats_t *s) {
+    const stats_channel_cfg_t temp = { STATS_TEMP_DEADBAND, STATS_MAX_SILENCE_S, STATS_WINDOW_SAMPLES, STATS_EWMA_ALPHA };
+    const stats_channel_cfg_t humi = { STATS_HUMI_DEADBAND, STATS_MAX_SILENCE_S, STATS_WINDOW_SAMPLES, STATS_EWMA_ALPHA };
+
+    memset(s, 0, sizeof(*s));
+    stats_channel_init(&s->temperature, &temp);
+    stats_channel_init(&s->humidity, &humi);
+}
+
+uint8_t sensor_stats_feed(sensor_stats_t *s, const sensor_sample_t *sample, uint32_t now_s) {
+    if (sample->status != DHT20_OK) return 0;
+
+    uint8_t result = stats_channel_update(&s->temperature, sample->temp_centi, now_s, &s->tempAgg) |
+                     stats_channel_update(&s->humidity, sample->humi_centi, now_s, &s->humiAgg);
+    if (result & STATS_REPORT) {
+        mark_reported(&s->temperature, sample->temp_centi, now_s);
+        mark_reported(&s->humidity, sample->humi_centi, now_s);
+    }
+    return result;
+}
+
+size_t sensor_stats_format_json(const sensor_stats_t *s, char *out, size_t cap) {
+    const stats_aggregate_t *t = &s->tempAgg;
+    const stats_aggregate_t *h = &s->humiAgg;
+
+    if (t->count == 0) return 0;
+    int n = snprintf(out, cap,
+                     "{\"temperature_min\":%.2f,\"temperature_max\":%.2f,\"temperature_mean\":%.2f,"
+                     "\"temperature_std\":%.3f,\"temperature_ewma\":%.2f,"
+                     "\"humidity_min\":%.2f,\"humidity_max\":%.2f,\"humidity_mean\":%.2f,"
+                     "\"humidity_std\":%.3f,\"humidity_ewma\":%.2f,\"window\":%u}",
+                     t->min, t->max, t->mean, t->stddev, t->ewma,
+                     h->min, h->max, h->mean, h->stddev, h->ewma, (unsigned)t->count);
+    if (n < 0 || (size_t)n >= cap) return 0;
+    return n;
+}
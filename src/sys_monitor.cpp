@@ -0,0 +1,184 @@
+#include "sys_monitor.h"
+#include "freertos/timers.h"
+#include "esp_heap_caps.h"
+#include <atomic>
+#include "console.h"
+
+// Double buffer nhu sensor_snapshot: timer task dung report moi vao slot KHONG duoc
+// publish roi doi index, critical section chi bao ve index (report ~700 byte khong
+// copy trong khoa). seq le = dang ghi; reader bi vuot 2 lan publish thi doc lai.
+typedef struct {
+    std::atomic<uint32_t> seq;
+    sysmon_report_t       report;
+} sysmon_slot_t;
+
+static sysmon_slot_t slots[2];
+static uint8_t published = 0;
+static bool haveReport = false;
+static uint32_t lastTotalRuntime = 0;
+static portMUX_TYPE reportMux = portMUX_INITIALIZER_UNLOCKED;
+static TimerHandle_t sysmonTimer = NULL;
+
+#if configUSE_TRACE_FACILITY
+static TaskStatus_t statusBuf[SYSMON_MAX_TASKS];
+#endif
+
+void sys_monitor_aggregate(sysmon_report_t *cur, const sysmon_report_t *prev,
+                           uint32_t total_runtime_delta, uint8_t cores) {
+    uint64_t capacity = (uint64_t)total_runtime_delta * cores;
+    uint32_t idle = 0;
+
+    for (uint8_t i = 0; i < cur->task_count; i++) {
+        sysmon_task_t &t = cur->tasks[i];
+        uint32_t before = 0;
+        bool found = false;
+        for (uint8_t j = 0; prev && j < prev->task_count; j++) {
+            if (prev->tasks[j].number == t.number) {
+                before = prev->tasks[j].runtime;
+                found = true;
+                break;
+            }
+        }
+        // task moi tao: tinh tu 0, runtime chua vuot qua chu ky
+        uint32_t delta = found ? t.runtime - before : t.runtime;
+        t.cpu_permille = capacity ? (uint16_t)min<uint64_t>(1000, (uint64_t)delta * 1000 / capacity) : 0;
+        if (strncmp(t.name, "IDLE", 4) == 0) {
+            idle += t.cpu_permille;
+        }
+    }
+    cur->idle_permille = (uint16_t)min<uint32_t>(1000, idle);
+}
+
+// Chi mot writer (timer task, hoac task goi khi timer chua chay) nen doc `published` khong can khoa
+static void sample(TimerHandle_t xTimer) {
+    sysmon_slot_t &slot = slots[published ^ 1];
+    sysmon_report_t &next = slot.report;
+    slot.seq.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memset(&next, 0, sizeof(next));
+    next.uptime_ms = millis();
+    next.heap_free = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    next.heap_min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    next.heap_largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+
+#if configUSE_TRACE_FACILITY
+    uint32_t totalRuntime = 0;
+    UBaseType_t total = uxTaskGetNumberOfTasks();
+    UBaseType_t n = uxTaskGetSystemState(statusBuf, SYSMON_MAX_TASKS, &totalRuntime);
+    if (n == 0 && total > SYSMON_MAX_TASKS) {
+        // bang qua nho -> API tra ve 0, chi bao so task bi bo
+        next.tasks_truncated = total;
+    }
+    for (UBaseType_t i = 0; i < n; i++) {
+        sysmon_task_t &t = next.tasks[next.task_count++];
+        strncpy(t.name, statusBuf[i].pcTaskName, SYSMON_NAME_LEN - 1);
+        t.number = statusBuf[i].xTaskNumber;
+        t.runtime = statusBuf[i].ulRunTimeCounter;
+        t.stack_free = statusBuf[i].usStackHighWaterMark;
+        t.priority = statusBuf[i].uxCurrentPriority;
+        t.state = statusBuf[i].eCurrentState;
+#if CONFIG_FREERTOS_VTASKLIST_INCLUDE_COREID
+        t.core = statusBuf[i].xCoreID == tskNO_AFFINITY ? -1 : statusBuf[i].xCoreID;
+#else
+        t.core = -1;
+#endif
+    }
+    // slot dang publish chi bi ghi o day nen doc khong can khoa
+    sys_monitor_aggregate(&next, haveReport ? &slots[published].report : NULL,
+                          totalRuntime - lastTotalRuntime, portNUM_PROCESSORS);
+    lastTotalRuntime = totalRuntime;
+#endif
+
+    slot.seq.fetch_add(1, std::memory_order_release);
+    portENTER_CRITICAL(&reportMux);
+    published ^= 1;
+    haveReport = true;
+    portEXIT_CRITICAL(&reportMux);
+}
+
+void sys_monitor_sample_now() {
+    if (sysmonTimer == NULL) sample(NULL);
+}
+
+bool sys_monitor_get(sysmon_report_t *out) {
+    while (true) {
+        portENTER_CRITICAL(&reportMux);
+        bool ok = haveReport;
+        uint8_t idx = published;
+        portEXIT_CRITICAL(&reportMux);
+        if (!ok) return false;
+
+        const sysmon_slot_t &slot = slots[idx];
+        uint32_t before = slot.seq.load(std::memory_order_acquire);
+        if (before & 1) continue;   // writer da vuot qua, lay lai index
+        *out = slot.report;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == before) return true;
+    }
+}
+
+static const char *state_name(uint8_t state) {
+    switch (state) {
+        case eRunning:   return "RUN";
+        case eReady:     return "RDY";
+        case eBlocked:   return "BLK";
+        case eSuspended: return "SUS";
+        case eDeleted:   return "DEL";
+        default:         return "?";
+    }
+}
+
+void sys_monitor_print(const sysmon_report_t *r) {
+    Serial.printf("\nUptime %lus  heap free %lu  min %lu  largest %lu  idle %u.%u%%\n",
+                  (unsigned long)(r->uptime_ms / 1000), (unsigned long)r->heap_free,
+                  (unsigned long)r->heap_min_free, (unsigned long)r->heap_largest,
+                  r->idle_permille / 10, r->idle_permille % 10);
+    Serial.println("  TASK             PRI STATE CORE  CPU%   STACK_FREE");
+    for (uint8_t i = 0; i < r->task_count; i++) {
+        const sysmon_task_t &t = r->tasks[i];
+        Serial.printf("  %-16s %3u %-5s %4d %3u.%u %8lu\n", t.name, t.priority, state_name(t.state),
+                      t.core, t.cpu_permille / 10, t.cpu_permille % 10, (unsigned long)t.stack_free);
+    }
+    if (r->tasks_truncated) {
+        Serial.printf("  (%u tasks, table holds %d)\n", r->tasks_truncated, SYSMON_MAX_TASKS);
+    }
+}
+
+size_t sys_monitor_format_json(const sysmon_report_t *r, char *out, size_t cap) {
+    // task co stack it nhat -> dau hieu can tang stack
+    const sysmon_task_t *tightest = NULL;
+    for (uint8_t i = 0; i < r->task_count; i++) {
+        if (!tightest || r->tasks[i].stack_free < tightest->stack_free) {
+            tightest = &r->tasks[i];
+        }
+    }
+    int n = snprintf(out, cap,
+                     "{\"heap_free\":%lu,\"heap_min\":%lu,\"heap_blk\":%lu,\"cpu_idle\":%u,"
+                     "\"tasks\":%u,\"stack_min\":%lu,\"stack_min_task\":\"%s\"}",
+                     (unsigned long)r->heap_free, (unsigned long)r->heap_min_free,
+                     (unsigned long)r->heap_largest, r->idle_permille / 10, r->task_count,
+                     tightest ? (unsigned long)tightest->stack_free : 0UL,
+                     tightest ? tightest->name : "");
+    if (n < 0 || (size_t)n >= cap) return 0;
+    return n;
+}
+
+static void cmd_stats(int argc, char *argv[]) {
+    static sysmon_report_t r;
+    if (sys_monitor_get(&r)) {
+        sys_monitor_print(&r);
+    } else {
+        Serial.println("No stats yet");
+    }
+    console_prompt();
+}
+
+static const console_cmd_t statsCommand = { "stats", "stats", "Task CPU / stack / heap stats", cmd_stats };
+
+bool sys_monitor_init() {
+    console_register(&statsCommand);
+    sysmonTimer = xTimerCreate("SysMon", pdMS_TO_TICKS(SYSMON_PERIOD_MS), pdTRUE, NULL, sample);
+    if (sysmonTimer == NULL) return false;
+    return xTimerStart(sysmonTimer, 0) == pdPASS;
+}
@@ -1,46 +1,49 @@
 #include "task_power_demo.h"
+#include "temp_humi_monitor.h"
+#include "rtc_sample_buffer.h"
+#include "coreiot.h"
+#include "power_governor.h"
+#include "console.h"
+#include "sys_monitor.h"
+#include "boot_profiler.h"
+#include "event_bus.h"
+#include "deferred_log.h"
+#include "indicator.h"
+#include "sensor_stats.h"
+#include "sample_rate.h"
+#include "anomaly.h"
+#include "relay_manager.h"
+#include "rule_engine.h"
+#include <time.h>
 #include "esp_sleep.h"
 #include "driver/gpio.h"
 #include "driver/rtc_io.h" 
-#include <Adafruit_NeoPixel.h>
 
-#define NEO_PIN     45 
-#define LED_D13_PIN 48 
-#define NUM_PIXELS  1
-
-Adafruit_NeoPixel strip(NUM_PIXELS, NEO_PIN, NEO_GRB + NEO_KHZ800);
+#define POWER_TASK_IDLE_MS 1000
 
 RTC_DATA_ATTR int bootCount = 0;
-String inputBuffer = "";
+RTC_DATA_ATTR uint32_t dutyCycleSec = 0;   // 0 = duty cycle off
+// Deadband/aggregate phai song qua deep sleep, neu khong moi lan thuc day deu la "mau dau tien"
+RTC_DATA_ATTR sensor_stats_t dutyStats;
+RTC_DATA_ATTR bool dutyAggPending = false;
+// dutyCycleSec la chu ky ngan nhat; controller gian ra khi tin hieu phang
+RTC_DATA_ATTR rate_ctrl_t dutyRate;
+RTC_DATA_ATTR anomaly_state_t dutyAnomaly;
+static sensor_stats_t liveStats;
+static anomaly_state_t liveAnomaly;
 
 void led_blink_reset() {
     Serial.println("System Reset/Wakeup -> Blinking RED...");
-    for(int i = 0; i < 3; i++) {
-        strip.setPixelColor(0, strip.Color(255, 0, 0));
-        strip.show();
-        delay(150);
-        strip.setPixelColor(0, strip.Color(0, 0, 0)); 
-        strip.show();
-        delay(150);
-    }
+    // Timer indicator tu ve 3 nhay roi quay ve nen xanh, task nay khong phai cho 900ms
+    indicator_pattern_t p = indicator_blink(255, 0, 0, 150, 150, 3);
+    indicator_play(IND_CH_PIXEL, &p);
 }
 
 void led_active_mode() {
-    gpio_set_level((gpio_num_t)LED_D13_PIN, 0);
-    
-    strip.setPixelColor(0, strip.Color(0, 255, 0));
-    strip.show();
-}
-
-void led_sleep_mode_setup() {
-    strip.setPixelColor(0, strip.Color(0, 0, 0));
-    strip.show();
-    delay(20); 
-    gpio_reset_pin((gpio_num_t)NEO_PIN);
-
-    gpio_reset_pin((gpio_num_t)LED_D13_PIN);
-    gpio_set_direction((gpio_num_t)LED_D13_PIN, GPIO_MODE_OUTPUT);
-    gpio_set_level((gpio_num_t)LED_D13_PIN, 1);
+    indicator_pattern_t off = { IND_OFF, 0, 0, 0, 0, 0, 0 };
+    indicator_pattern_t green = indicator_solid(0, 255, 0);
+    indicator_set(IND_CH_D13, &off);
+    indicator_set(IND_CH_PIXEL, &green);
 }
 
 void print_menu() {
@@ -60,112 +63,286 @@ void print_menu() {
     Serial.printf("Boot count: %d\n", bootCount);
     
     Serial.println("\nLED STATUS:");
-    Serial.println(" - Blink RED 3x: Startup / Wake from Deep Sleep");
+    Serial.println(" - Blink RED 3x: Startup / Wake by BUTTON (TIMER wake skips it)");
     Serial.println(" - Solid GREEN:  Running (Active)");
     Serial.println(" - D13 ON:       Sleeping");
     
-    Serial.println("\nCOMMANDS:");
-    Serial.println("  L <sec> - Light Sleep");
-    Serial.println("  D <sec> - Deep Sleep");
-    Serial.print(">>> ");
+    console_print_help();
+    console_prompt();
 }
 
-void enter_light_sleep(uint32_t time_sec) {
-    Serial.printf("Light Sleep: %d sec...\n", time_sec);
-    Serial.println("   (NeoPixel OFF -> LED D13 ON)");
-    Serial.flush();
-    
-    led_sleep_mode_setup();
-    gpio_hold_en((gpio_num_t)LED_D13_PIN); 
+uint32_t light_sleep_for(uint32_t time_ms) {
+    dlog_flush();
+    indicator_sleep();
 
-    esp_sleep_enable_timer_wakeup(time_sec * 1000000ULL);
+    esp_sleep_enable_timer_wakeup(time_ms * 1000ULL);
     
     uint32_t start = millis();
     esp_light_sleep_start();
     
-    gpio_hold_dis((gpio_num_t)LED_D13_PIN);
-    
-    strip.begin();
-    strip.setBrightness(50);
-    
-    led_active_mode(); 
+    indicator_wake();
+
+    return millis() - start;
+}
 
-    uint32_t duration = (millis() - start) / 1000;
+void enter_light_sleep(uint32_t time_sec) {
+    Serial.printf("Light Sleep: %d sec...\n", time_sec);
+    Serial.println("   (NeoPixel OFF -> LED D13 ON)");
+    Serial.flush();
+    
+    uint32_t duration = light_sleep_for(rate_sec_to_ms(time_sec)) / 1000;
     Serial.printf("Woke up! Slept for: %ds\n", duration);
     Serial.print(">>> ");
 }
 
 void enter_deep_sleep(uint32_t time_sec) {
+    dlog_flush();
     Serial.printf("Deep Sleep: %d sec...\n", time_sec);
     Serial.println("   (Will BLINK RED upon wake/reset)");
     Serial.flush();
     
     bootCount++;
-    led_sleep_mode_setup();
-    
-    gpio_hold_en((gpio_num_t)LED_D13_PIN);
+    indicator_sleep();
     gpio_deep_sleep_hold_en();
 
     esp_sleep_enable_timer_wakeup(time_sec * 1000000ULL);
     esp_deep_sleep_start();
 }
 
-void parse_command(String cmd) {
-    cmd.trim();
-    cmd.toUpperCase();
-    if (cmd.length() == 0) { Serial.print(">>> "); return; }
-    if (cmd == "M") { print_menu(); return; }
-    
-    if (cmd.length() < 3) { Serial.print(">>> "); return; }
-    
-    char mode = cmd.charAt(0);
-    int time = cmd.substring(2).toInt();
-    
-    if (time <= 0) return;
-    
-    if (mode == 'L') enter_light_sleep(time);
-    else if (mode == 'D') enter_deep_sleep(time);
+void duty_cycle_flush() {
+    static char json[COREIOT_TELEMETRY_MAX];
+    uint32_t start = millis();
+
+    if (!coreiot_connect()) {
+        boot_profiler_mark("network");
+        // giu buffer, thu lai sau N lan thuc day nua
+        rtc_buffer_defer_flush();
+        coreiot_disconnect();
+        return;
+    }
+
+    boot_profiler_mark("network");
+
+    // Mau chup truoc lan sync NTP dau tien mang gio RTC -> doi sang epoch
+    uint32_t before = time(nullptr);
+    uint32_t syncStart = millis();
+    if (before < COREIOT_VALID_EPOCH && coreiot_sync_time()) {
+        uint32_t elapsed = (millis() - syncStart) / 1000;
+        rtc_buffer_rebase(COREIOT_VALID_EPOCH, (int32_t)(time(nullptr) - before - elapsed));
+    }
+
+    uint16_t count = rtc_buffer_count();
+    if (rtc_buffer_format_json(json, sizeof(json)) > 0 && coreiot_send_telemetry(json)) {
+        dlog("Flushed %u samples in %lums", (unsigned)count, (unsigned long)(millis() - start));
+        rtc_buffer_clear();
+    } else {
+        dlog("Telemetry flush failed");
+        rtc_buffer_defer_flush();
+    }
+    // Shared attribute ghi de chu ky ngu; khong co attribute -> tu dong.
+    // Chi duty cycle moi ket noi CoreIOT nen che do active khong nhan attribute nay.
+    uint32_t periodSec = 0;
+    if (coreiot_request_shared_u32(COREIOT_ATTR_SAMPLE_PERIOD, &periodSec)) {
+        rate_ctrl_set_override(&dutyRate, rate_sec_to_ms(periodSec));
+    }
+    // Rule moi tu server: bien dich + luu flash, chay khi quay lai che do active
+    static char rules[RULES_SOURCE_MAX];
+    if (coreiot_request_shared_json(COREIOT_ATTR_RULES, rules, sizeof(rules))) {
+        rules_apply_json(rules, strlen(rules));
+    }
+    if (anomaly_format_json(&dutyAnomaly, json, sizeof(json)) > 0) {
+        coreiot_send_telemetry(json);
+    }
+    if (dutyAggPending && sensor_stats_format_json(&dutyStats, json, sizeof(json)) > 0 &&
+        coreiot_send_telemetry(json)) {
+        dutyAggPending = false;
+    }
+
+    // radio dang bat san -> gui kem heap/stack stats, gan nhu mien phi
+    static sysmon_report_t stats;
+    sys_monitor_sample_now();
+    if (sys_monitor_get(&stats) && sys_monitor_format_json(&stats, json, sizeof(json)) > 0) {
+        coreiot_send_telemetry(json);
+    }
+    boot_profiler_mark("flush");
+    if (boot_profiler_format_json(json, sizeof(json)) > 0) {
+        coreiot_send_telemetry(json);
+    }
+    coreiot_disconnect();
 }
 
-void task_power_demo_init() {
-    gpio_reset_pin((gpio_num_t)LED_D13_PIN);
-    gpio_set_direction((gpio_num_t)LED_D13_PIN, GPIO_MODE_OUTPUT);
-    gpio_hold_dis((gpio_num_t)LED_D13_PIN);
-    gpio_deep_sleep_hold_dis();
+bool duty_cycle_resume() {
+    rtc_buffer_begin();
+    if (dutyCycleSec == 0 || esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER) {
+        dutyCycleSec = 0;
+        return false;
+    }
 
-    strip.begin();
-    strip.setBrightness(50);
-    
-    led_blink_reset(); 
-    
+    rtc_buffer_note_wake();
+    sensor_sample_t s;
+    if (temp_humi_sample_once(&s)) {
+        uint32_t now = time(nullptr);
+        uint8_t ev = sensor_stats_feed(&dutyStats, &s, now);
+        // Mau bat thuong luon duoc luu, du nam trong deadband
+        if (anomaly_feed(&dutyAnomaly, s.temp_centi, s.humi_centi) >= ANOMALY_THRESHOLD) ev |= STATS_REPORT;
+        // Chi luu mau khi vuot deadband / qua lau im lang -> batch nho, it lan bat radio
+        if (ev & STATS_REPORT) rtc_buffer_append(now, s.temp_centi, s.humi_centi);
+        if (ev & STATS_WINDOW) dutyAggPending = true;
+        // Gio RTC nhan 1000 co the tran 32 bit, nhung controller chi dung hieu so
+        rate_ctrl_update(&dutyRate, sample_temperature(&s), sample_humidity(&s), (uint32_t)((uint64_t)now * 1000));
+    } else {
+        dlog("Failed to read from DHT sensor! (%d)", s.status);
+    }
+    boot_profiler_mark("sample");
+    dlog("Duty cycle wake #%d: %u samples buffered", bootCount, (unsigned)rtc_buffer_count());
+
+    if (rtc_buffer_should_flush(RTC_FLUSH_EVERY_N)) {
+        duty_cycle_flush();
+    }
+    enter_deep_sleep((uint32_t)(((uint64_t)dutyRate.periodMs + 500) / 1000));
+    return true;
+}
+
+void enter_duty_cycle(uint32_t time_sec) {
+    Serial.printf("Duty cycle: sample every %d sec, upload every %d wakes\n", time_sec, RTC_FLUSH_EVERY_N);
+    Serial.println("   (Press RESET to exit)");
+    dutyCycleSec = time_sec;
+    sensor_stats_init(&dutyStats);
+    dutyAggPending = false;
+    anomaly_init(&dutyAnomaly);
+    uint32_t periodMs = rate_sec_to_ms(time_sec);
+    rate_ctrl_init(&dutyRate, periodMs, max(periodMs, (uint32_t)RATE_MAX_PERIOD_MS), periodMs);
+    rtc_buffer_clear();
+    enter_deep_sleep(time_sec);
+}
+
+static bool parse_seconds(int argc, char *argv[], uint32_t *sec) {
+    if (argc < 2 || !console_arg_u32(argv[1], sec) || *sec == 0) {
+        Serial.printf("Usage: %s <sec>\n", argv[0]);
+        console_prompt();
+        return false;
+    }
+    return true;
+}
+
+static void cmd_menu(int argc, char *argv[]) {
+    print_menu();
+}
+
+static void cmd_light(int argc, char *argv[]) {
+    uint32_t sec;
+    if (parse_seconds(argc, argv, &sec)) enter_light_sleep(sec);
+}
+
+static void cmd_deep(int argc, char *argv[]) {
+    uint32_t sec;
+    if (parse_seconds(argc, argv, &sec)) enter_deep_sleep(sec);
+}
+
+static void cmd_duty(int argc, char *argv[]) {
+    uint32_t sec;
+    if (parse_seconds(argc, argv, &sec)) enter_duty_cycle(sec);
+}
+
+static void cmd_auto(int argc, char *argv[]) {
+    power_governor_enable(!power_governor_enabled());
+    Serial.printf("Auto governor: %s\n", power_governor_enabled() ? "ON" : "OFF");
+    console_prompt();
+}
+
+static void cmd_report(int argc, char *argv[]) {
+    power_governor_print_report();
+    console_prompt();
+}
+
+static void cmd_boot(int argc, char *argv[]) {
+    boot_profiler_print();
+    console_prompt();
+}
+
+static const console_cmd_t powerCommands[] = {
+    { "M", "M",       "Show this menu",                          cmd_menu },
+    { "L", "L <sec>", "Light Sleep",                             cmd_light },
+    { "D", "D <sec>", "Deep Sleep",                              cmd_deep },
+    { "C", "C <sec>", "Duty cycle (sample/wake, batch upload)",  cmd_duty },
+    { "A", "A",       "Auto power governor ON/OFF",              cmd_auto },
+    { "R", "R",       "Power state residency report",            cmd_report },
+    { "B", "B",       "Boot phase timing",                       cmd_boot },
+};
+
+void print_samples() {
+    sensor_sample_t s;
+    while (temp_humi_pop_sample(&s)) {
+        if (s.status != DHT20_OK) {
+            dlog("Failed to read from DHT sensor! (%d)", s.status);
+            continue;
+        }
+        uint8_t ev = sensor_stats_feed(&liveStats, &s, s.timestamp_ms / 1000);
+        float temp = sample_temperature(&s);
+        float humi = sample_humidity(&s);
+        uint8_t score = anomaly_feed(&liveAnomaly, s.temp_centi, s.humi_centi);
+        rules_evaluate(temp, humi, score);
+        if (score >= ANOMALY_THRESHOLD) {
+            indicator_pattern_t p = indicator_blink(255, 120, 0, 100, 100, 5);
+            indicator_play(IND_CH_PIXEL, &p);
+            dlog("Anomaly! score %u: %.2f°C %.2f%%", (unsigned)score, temp, humi);
+        } else if (ev & STATS_REPORT) {
+            dlog("Humidity: %.2f%%  Temperature: %.2f°C", humi, temp);
+        }
+        if (ev & STATS_WINDOW) {
+            const stats_aggregate_t &t = liveStats.tempAgg;
+            const stats_aggregate_t &h = liveStats.humiAgg;
+            dlog("Window T: %.2f..%.2f mean %.2f sd %.3f", t.min, t.max, t.mean, t.stddev);
+            dlog("Window H: %.2f..%.2f mean %.2f sd %.3f", h.min, h.max, h.mean, h.stddev);
+        }
+    }
+}
+
+// Relay dang bat (khong duoc giu qua deep sleep) hoac rule dang chay -> governor khong deep
+static bool ram_state_in_use() {
+    return relay_state() != 0 || rules_count() > 0;
+}
+
+void task_power_demo_init() {
+    power_governor_boot();
+    power_governor_set_deep_veto(ram_state_in_use);
+    indicator_init();
+    sensor_stats_init(&liveStats);
+    anomaly_init(&liveAnomaly);
+    anomaly_begin();
     led_active_mode();
+    // Blink chi de trang tri, bo qua khi thuc day bang timer
+    if (!boot_is_fast_wake()) led_blink_reset(); 
+    boot_profiler_mark("led");
 
+    for (size_t i = 0; i < sizeof(powerCommands) / sizeof(powerCommands[0]); i++) {
+        console_register(&powerCommands[i]);
+    }
+    boot_profiler_mark("console");
+    boot_profiler_print();
     print_menu();
 }
 
 void task_power_management(void *pvParameters) {
     task_power_demo_init();
+
+    // Thuc day khi co byte UART hoac event tu bus, khong poll 10ms nua
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    console_begin(self);
+    event_bus_subscribe_task(EVT_BIT(EVT_NEW_SAMPLE) | EVT_BIT(EVT_CONFIG_CHANGED) |
+                             EVT_BIT(EVT_RELAY_CHANGED), self);
     
     while(1) {
-        if (Serial.available()) {
-            char c = Serial.read();
-            if (c >= 32 && c <= 126) Serial.print(c);
-            
-            if (c == '\n' || c == '\r') {
-                if (inputBuffer.length() > 0) {
-                    Serial.println();
-                    parse_command(inputBuffer);
-                    inputBuffer = "";
-                }
-            } else if (c == 8 || c == 127) {
-                if (inputBuffer.length() > 0) {
-                    inputBuffer.remove(inputBuffer.length() - 1);
-                    Serial.print("\b \b");
-                }
-            } else {
-                inputBuffer += c;
-            }
+        uint32_t bits = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &bits, pdMS_TO_TICKS(POWER_TASK_IDLE_MS));
+        if (bits & CONSOLE_NOTIFY_BIT) console_process();
+        if (bits & EVT_BIT(EVT_NEW_SAMPLE)) print_samples();
+        if (bits & EVT_BIT(EVT_CONFIG_CHANGED)) {
+            dlog("Config updated (gen %lu)", (unsigned long)config_generation());
         }
-        vTaskDelay(10 / portTICK_PERIOD_MS);
+        if (bits & EVT_BIT(EVT_RELAY_CHANGED)) {
+            dlog("Relays now 0x%02lx", (unsigned long)relay_state());
+        }
+        power_governor_step();
     }
-}
\ No newline at end of file
+}
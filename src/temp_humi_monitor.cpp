@@ -1,45 +1,245 @@
 #include "temp_humi_monitor.h"
+#include "freertos/timers.h"
+#include "power_governor.h"
+#include "console.h"
+#include "deferred_log.h"
+#include "sample_rate.h"
+
 DHT20 dht20;
-LiquidCrystal_I2C lcd(33,16,2);
 
+// Acquisition state machine, driven entirely from the timer service task:
+//   IDLE --(sample timer)--> CONVERTING --(conversion timer)--> IDLE
+// startMeasurement() triggers the measurement, then the one-shot conversion timer
+// fires ~80ms later to poll() (status + data in one read). Nothing busy-waits.
+enum sensor_state_t {
+    SENSOR_IDLE,
+    SENSOR_CONVERTING
+};
+
+static volatile sensor_state_t sensorState = SENSOR_IDLE;
+static uint32_t sampleStartMs = 0;
+static int sensorJobId = -1;
+
+// Chi timer task cap nhat `rate`; task khac di qua xTimerPendFunctionCall
+static rate_ctrl_t rate;
+static volatile uint32_t currentPeriodMs = SENSOR_SAMPLE_PERIOD_MS;
+
+static TimerHandle_t sampleTimer = NULL;
+static TimerHandle_t conversionTimer = NULL;
+
+static sensor_sample_t ring[SENSOR_RING_SIZE];
+static uint32_t ringHead = 0;
+static uint32_t ringCount = 0;
+static uint32_t ringDropped = 0;
+static portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void push_sample(int16_t temp_centi, uint16_t humi_centi, int status) {
+    sensor_sample_t s;
+    s.temp_centi = temp_centi;
+    s.humi_centi = humi_centi;
+    s.timestamp_ms = millis();
+    s.status = status;
+
+    portENTER_CRITICAL(&ringMux);
+    if (ringCount == SENSOR_RING_SIZE) {
+        // full -> drop the oldest
+        ringHead = (ringHead + 1) % SENSOR_RING_SIZE;
+        ringCount--;
+        ringDropped++;
+    }
+    ring[(ringHead + ringCount) % SENSOR_RING_SIZE] = s;
+    ringCount++;
+    portEXIT_CRITICAL(&ringMux);
+
+    // deadline tiep theo tinh tu luc bat dau do, khong phai luc xong
+    power_governor_job_ran(sensorJobId, sampleStartMs);
+
+    // Publish nguyen khoi cho cac consumer (MQTT, LCD, web)
+    sensor_snapshot_publish(sample_temperature(&s), sample_humidity(&s), s.timestamp_ms, status);
+
+    uint32_t seq = sensor_snapshot_sequence();
+    event_bus_publish(EVT_NEW_SAMPLE, &seq, sizeof(seq));
+}
+
+static uint16_t humidity_centi() {
+    // offset co the day ra ngoai 0..100 %RH
+    int32_t h = dht20.getHumidityCenti();
+    return (uint16_t)constrain(h, 0, 10000);
+}
 
-void temp_humi_monitor(void *pvParameters){
+static void apply_period(uint32_t period_ms) {
+    if (period_ms == currentPeriodMs) return;
+    dlog("Sample period %lu -> %lu ms", (unsigned long)currentPeriodMs, (unsigned long)period_ms);
+    currentPeriodMs = period_ms;
+    // Timer auto-reload: lan ban tiep theo = now + period moi
+    xTimerChangePeriod(sampleTimer, pdMS_TO_TICKS(period_ms), 0);
+    power_governor_set_period(sensorJobId, period_ms);
+}
 
-    Wire.begin(11, 12);
-    Serial.begin(115200);
+static void on_conversion_timer(TimerHandle_t xTimer) {
+    int rv = dht20.poll();
+    // Status byte bit7 = still measuring -> check again shortly (poll() tu timeout)
+    if (rv == DHT20_PENDING) {
+        xTimerChangePeriod(conversionTimer, pdMS_TO_TICKS(SENSOR_BUSY_RETRY_MS), 0);
+        return;
+    }
+
+    if (rv != DHT20_OK) {
+        push_sample(0, 0, rv);
+    } else {
+        int16_t t = dht20.getTemperatureCenti();
+        uint16_t h = humidity_centi();
+        push_sample(t, h, DHT20_OK);
+        apply_period(rate_ctrl_update(&rate, t * 0.01f, h * 0.01f, sampleStartMs));
+    }
+    sensorState = SENSOR_IDLE;
+}
+
+static void on_sample_timer(TimerHandle_t xTimer) {
+    if (sensorState != SENSOR_IDLE) {
+        // previous conversion still pending, keep the fixed period
+        return;
+    }
+
+    sampleStartMs = millis();
+    int rv = dht20.startMeasurement();
+    if (rv != DHT20_OK) {
+        push_sample(0, 0, rv);
+        return;
+    }
+
+    sensorState = SENSOR_CONVERTING;
+    xTimerChangePeriod(conversionTimer, pdMS_TO_TICKS(SENSOR_CONVERSION_MS), 0);
+}
+
+static void sample_now(void *param, uint32_t unused) {
+    on_sample_timer(sampleTimer);
+}
+
+// esp_light_sleep_start() does not advance the RTOS tick, so after a
+// governor light sleep the periodic timer is late: restart it and take
+// the sample that is due right away.
+static void on_governor_wake(uint32_t slept_ms) {
+    if (millis() - sampleStartMs < currentPeriodMs / 2) {
+        return;     // timer already caught up
+    }
+    xTimerReset(sampleTimer, 0);
+    xTimerPendFunctionCall(sample_now, NULL, 0, 0);
+}
+
+static void cmd_sensor(int argc, char *argv[]) {
+    sensor_snapshot_t snap;
+    if (!sensor_snapshot_read(&snap)) {
+        Serial.println("No sample yet");
+    } else {
+        Serial.printf("#%lu @%lums: %.2f°C %.2f%% (status %d)\n", (unsigned long)snap.sequence,
+                      (unsigned long)snap.timestamp_ms, snap.temperature, snap.humidity, snap.status);
+    }
+    Serial.printf("Pending %lu, dropped %lu\n", (unsigned long)temp_humi_pending(),
+                  (unsigned long)temp_humi_dropped());
+    Serial.printf("I2C: %lu transactions, %lu us waiting, calibrated %d\n",
+                  (unsigned long)dht20.getTransactions(), (unsigned long)dht20.getWaitMicros(),
+                  dht20.isCalibratedCached());
+    console_prompt();
+}
+
+static void set_interval(void *param, uint32_t period_ms) {
+    rate_ctrl_set_override(&rate, period_ms);
+    apply_period(rate.periodMs);
+}
+
+static void cmd_rate(int argc, char *argv[]) {
+    uint32_t sec;
+    if (argc >= 2 && strcasecmp(argv[1], "auto") == 0) {
+        temp_humi_set_interval(0);
+    } else if (argc >= 2 && console_arg_u32(argv[1], &sec)) {
+        temp_humi_set_interval(rate_sec_to_ms(sec));
+    } else {
+        Serial.printf("Sample period %lu ms (%s)\n", (unsigned long)currentPeriodMs,
+                      rate.overrideMs ? "fixed" : "auto");
+    }
+    console_prompt();
+}
+
+static const console_cmd_t sensorCommands[] = {
+    { "T",    "T",               "Latest DHT20 sample",                cmd_sensor },
+    { "rate", "rate [sec|auto]", "Show / fix / auto the sample period", cmd_rate },
+};
+
+bool temp_humi_monitor_init() {
+    Wire.begin(SENSOR_SDA_PIN, SENSOR_SCL_PIN);
+    dht20.begin();
+
+    conversionTimer = xTimerCreate("DHT20Conv", pdMS_TO_TICKS(SENSOR_CONVERSION_MS),
+                                   pdFALSE, NULL, on_conversion_timer);
+    sampleTimer = xTimerCreate("DHT20Sample", pdMS_TO_TICKS(SENSOR_SAMPLE_PERIOD_MS),
+                               pdTRUE, NULL, on_sample_timer);
+    if (conversionTimer == NULL || sampleTimer == NULL) {
+        dlog("Failed to create DHT20 timers!");
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(sensorCommands) / sizeof(sensorCommands[0]); i++) {
+        console_register(&sensorCommands[i]);
+    }
+    rate_ctrl_init(&rate, RATE_MIN_PERIOD_MS, RATE_MAX_PERIOD_MS, SENSOR_SAMPLE_PERIOD_MS);
+    // Che do active giu liveStats/anomaly/rule trong RAM, khong co duong resume sau deep sleep
+    sensorJobId = power_governor_register("sensor", SENSOR_SAMPLE_PERIOD_MS, false, on_governor_wake);
+    return xTimerStart(sampleTimer, 0) == pdPASS;
+}
+
+bool temp_humi_sample_once(sensor_sample_t *out) {
+    Wire.begin(SENSOR_SDA_PIN, SENSOR_SCL_PIN);
     dht20.begin();
 
-    while (1){
-        /* code */
-        
-        dht20.read();
-        // Reading temperature in Celsius
-        float temperature = dht20.getTemperature();
-        // Reading humidity
-        float humidity = dht20.getHumidity();
-
-        
-
-        // Check if any reads failed and exit early
-        if (isnan(temperature) || isnan(humidity)) {
-            Serial.println("Failed to read from DHT sensor!");
-            temperature = humidity =  -1;
-            //return;
-        }
-
-        //Update global variables for temperature and humidity
-        glob_temperature = temperature;
-        glob_humidity = humidity;
-
-        // Print the results
-        
-        Serial.print("Humidity: ");
-        Serial.print(humidity);
-        Serial.print("%  Temperature: ");
-        Serial.print(temperature);
-        Serial.println("°C");
-        
-        vTaskDelay(5000);
-    }
-    
-}
\ No newline at end of file
+    out->timestamp_ms = millis();
+    out->temp_centi = 0;
+    out->humi_centi = 0;
+    out->status = dht20.startMeasurement();
+    if (out->status != DHT20_OK) return false;
+
+    // sleep through the conversion instead of polling the bus
+    vTaskDelay(pdMS_TO_TICKS(SENSOR_CONVERSION_MS));
+    while ((out->status = dht20.poll()) == DHT20_PENDING) {
+        vTaskDelay(pdMS_TO_TICKS(SENSOR_BUSY_RETRY_MS));
+    }
+    if (out->status != DHT20_OK) return false;
+
+    out->temp_centi = dht20.getTemperatureCenti();
+    out->humi_centi = humidity_centi();
+    return true;
+}
+
+bool temp_humi_pop_sample(sensor_sample_t *out) {
+    bool ok = false;
+    portENTER_CRITICAL(&ringMux);
+    if (ringCount > 0) {
+        *out = ring[ringHead];
+        ringHead = (ringHead + 1) % SENSOR_RING_SIZE;
+        ringCount--;
+        ok = true;
+    }
+    portEXIT_CRITICAL(&ringMux);
+    return ok;
+}
+
+uint32_t temp_humi_pending() {
+    return ringCount;
+}
+
+uint32_t temp_humi_dropped() {
+    return ringDropped;
+}
+
+uint32_t temp_humi_interval() {
+    return currentPeriodMs;
+}
+
+bool temp_humi_set_interval(uint32_t period_ms) {
+    if (sampleTimer == NULL) return false;
+    return xTimerPendFunctionCall(set_interval, NULL, period_ms, 0) == pdPASS;
+}
+
+void temp_humi_set_watch(float lo, float hi) {
+    // 2 float doc/ghi nguyen tu tren ESP32; lech mot mau giua lo/hi khong sao
+    rate_ctrl_set_watch(&rate, lo, hi);
+}
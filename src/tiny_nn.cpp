@@ -0,0 +1,60 @@
+#include "tiny_nn.h"
+
+int8_t nn_requantize(int32_t acc, const nn_requant_t *rq) {
+    int64_t v = (int64_t)acc * rq->mult;
+    if (rq->shift) {
+        // lam tron doi xung quanh 0 de am/duong cho cung ket qua tren moi compiler
+        int64_t half = (int64_t)1 << (rq->shift - 1);
+        v = v >= 0 ? (v + half) >> rq->shift : -((-v + half) >> rq->shift);
+    }
+    if (v > 127) return 127;
+    if (v < -128) return -128;
+    return (int8_t)v;
+}
+
+int32_t nn_dot_s8(const int8_t *a, const int8_t *b, size_t n) {
+    int32_t acc = 0;
+    for (size_t i = 0; i < n; i++) {
+        acc += (int32_t)a[i] * b[i];
+    }
+    return acc;
+}
+
+void nn_conv1d_s8(const int8_t *in, uint16_t len, uint8_t in_ch,
+                  const int8_t *w, const int32_t *bias, uint8_t out_ch, uint8_t kernel,
+                  const nn_requant_t *rq, bool relu, int8_t *out) {
+    if (len < kernel) return;
+    const size_t taps = (size_t)kernel * in_ch;
+    const uint16_t steps = len - kernel + 1;
+
+    for (uint16_t t = 0; t < steps; t++) {
+        const int8_t *x = in + (size_t)t * in_ch;
+        for (uint8_t o = 0; o < out_ch; o++) {
+            int32_t acc = nn_dot_s8(x, w + o * taps, taps) + (bias ? bias[o] : 0);
+            int8_t v = nn_requantize(acc, &rq[o]);
+            *out++ = (relu && v < 0) ? 0 : v;
+        }
+    }
+}
+
+void nn_dense_s8(const int8_t *in, uint16_t in_len,
+                 const int8_t *w, const int32_t *bias, uint16_t out_len,
+                 const nn_requant_t *rq, bool relu, int8_t *out) {
+    for (uint16_t o = 0; o < out_len; o++) {
+        int32_t acc = nn_dot_s8(in, w + (size_t)o * in_len, in_len) + (bias ? bias[o] : 0);
+        int8_t v = nn_requantize(acc, &rq[o]);
+        out[o] = (relu && v < 0) ? 0 : v;
+    }
+}
+
+void nn_maxpool_tail_s8(const int8_t *in, uint16_t len, uint8_t ch, uint16_t tail, int8_t *out) {
+    if (tail > len) tail = len;
+    for (uint8_t c = 0; c < ch; c++) {
+        int8_t m = -128;
+        for (uint16_t t = len - tail; t < len; t++) {
+            int8_t v = in[(size_t)t * ch + c];
+            if (v > m) m = v;
+        }
+        out[c] = m;
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef SIM_ADAFRUIT_NEOPIXEL_H
+#define SIM_ADAFRUIT_NEOPIXEL_H
+#include <Arduino.h>
+
+#define NEO_GRB     0x52
+#define NEO_KHZ800  0x0000
+
+// Mot dai LED gia: ghi lai mau da show() va so lan show()
+class Adafruit_NeoPixel {
+public:
+    Adafruit_NeoPixel(uint16_t n, int16_t pin, uint16_t type) { (void)n; (void)pin; (void)type; }
+
+    void begin() {}
+    void setBrightness(uint8_t b) { brightness = b; }
+    void setPixelColor(uint16_t, uint32_t c) { pending = c; }
+    void show() {
+        shown = pending;
+        shows++;
+    }
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+        return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+    }
+
+    uint8_t  brightness = 255;
+    uint32_t pending = 0;
+    uint32_t shown = 0;
+    uint32_t shows = 0;
+};
+
+#endif
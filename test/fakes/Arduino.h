@@ -0,0 +1,93 @@
+#ifndef FAKE_ARDUINO_H
+#define FAKE_ARDUINO_H
+// Host stand-in cho Arduino core (env:native). Thoi gian la dong ho ao:
+// delay()/delayMicroseconds() va moi giao dich I2C cua Wire gia chi cong sim::now_us.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+#include "Print.h"
+#include "Stream.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+#define B00000001 1
+#define B00000010 2
+#define B00000100 4
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr) pgm_read_byte(addr)
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncpy_P strncpy
+#define memcpy_P memcpy
+
+using std::min;
+using std::max;
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+namespace sim {
+inline uint64_t now_us = 0;     // dong ho ao, test tu dat / cong them
+inline void advance(uint64_t us) { now_us += us; }
+}
+
+inline uint32_t millis() { return (uint32_t)(sim::now_us / 1000); }
+inline uint32_t micros() { return (uint32_t)sim::now_us; }
+inline void delay(uint32_t ms) { sim::now_us += (uint64_t)ms * 1000; }
+inline void delayMicroseconds(uint32_t us) { sim::now_us += us; }
+// yield() trong vong cho cua driver: 1 us de vong timeout luon tien
+inline void yield() { sim::now_us += 1; }
+
+// Bo dem chu ky 240 MHz chay theo dong ho ao
+class EspClass {
+public:
+    uint32_t getCycleCount() { return (uint32_t)(sim::now_us * 240); }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getFreeHeap() { return 200 * 1024; }
+};
+inline EspClass ESP;
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+
+// Serial ghi vao bo nho de test doc lai
+class HardwareSerial : public Stream {
+public:
+    std::string output;
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override { output += (char)c; return 1; }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void onReceive(void (*cb)()) { rxCallback = cb; }
+    void (*rxCallback)() = nullptr;
+    operator bool() { return true; }
+};
+inline HardwareSerial Serial;
+
+// Arduino-ESP32 keo FreeRTOS vao qua Arduino.h
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef FAKE_IPADDRESS_H
+#define FAKE_IPADDRESS_H
+#include <stdint.h>
+
+class IPAddress {
+public:
+    IPAddress() : _addr{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _addr{a, b, c, d} {}
+    uint8_t operator[](int i) const { return _addr[i]; }
+private:
+    uint8_t _addr[4];
+};
+
+#endif
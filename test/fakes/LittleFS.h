@@ -0,0 +1,65 @@
+#ifndef SIM_LITTLEFS_H
+#define SIM_LITTLEFS_H
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// He file trong RAM: moi path la mot vector byte.
+// writeBudget gia lap mat dien: con bao nhieu byte ghi duoc nua, het thi moi write bi cat cut.
+namespace sim {
+inline std::map<std::string, std::vector<uint8_t>> files;
+inline size_t writeBudget = SIZE_MAX;
+}
+
+class File {
+  public:
+    File() {}
+    File(std::vector<uint8_t> *data, bool write) : _data(data), _write(write) {
+        if (write) data->clear();
+    }
+    size_t read(uint8_t *buf, size_t size) {
+        if (!_data || _write) return 0;
+        size_t n = _data->size() - _pos;
+        if (n > size) n = size;
+        memcpy(buf, _data->data() + _pos, n);
+        _pos += n;
+        return n;
+    }
+    size_t write(const uint8_t *buf, size_t size) {
+        if (!_data || !_write) return 0;
+        if (size > sim::writeBudget) size = sim::writeBudget;
+        sim::writeBudget -= size;
+        _data->insert(_data->end(), buf, buf + size);
+        return size;
+    }
+    size_t size() const { return _data ? _data->size() : 0; }
+    void close() { _data = nullptr; }
+    operator bool() const { return _data != nullptr; }
+
+  private:
+    std::vector<uint8_t> *_data = nullptr;
+    bool _write = false;
+    size_t _pos = 0;
+};
+
+class LittleFSFS {
+  public:
+    bool begin(bool formatOnFail = false) { return true; }
+    File open(const char *path, const char *mode) {
+        bool write = mode[0] == 'w';
+        auto it = sim::files.find(path);
+        if (it == sim::files.end()) {
+            if (!write) return File();
+            it = sim::files.emplace(path, std::vector<uint8_t>()).first;
+        }
+        return File(&it->second, write);
+    }
+    bool exists(const char *path) { return sim::files.count(path) > 0; }
+    bool remove(const char *path) { return sim::files.erase(path) > 0; }
+};
+
+inline LittleFSFS LittleFS;
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef FAKE_WIRE_H
+#define FAKE_WIRE_H
+// Host TwoWire: giao dich I2C di toi cac model thiet bi gan bang sim::attach(),
+// moi giao dich cong thoi gian bus vao dong ho ao va vao bo dem cua sim::bus.
+#include "Arduino.h"
+#include <vector>
+
+#define I2C_BUFFER_LENGTH 128
+
+namespace sim {
+
+struct I2cDevice {
+    virtual ~I2cDevice() {}
+    // false = NACK
+    virtual bool write(const uint8_t *data, size_t size) = 0;
+    virtual size_t read(uint8_t *data, size_t size) = 0;
+};
+
+struct I2cBus {
+    uint32_t clockHz = 100000;
+    uint32_t overheadUs = 0;        // chi phi driver moi giao dich (ESP-IDF ~30-60 us)
+    uint32_t transactions = 0;
+    uint32_t bytes = 0;
+    uint64_t busyUs = 0;
+    uint64_t startUs = 0;           // luc bat dau giao dich dang xu ly
+    I2cDevice *devices[128] = {};
+
+    // START + dia chi (9 bit) + n * 9 bit + STOP
+    uint32_t duration(size_t n) const {
+        uint64_t bits = 2 + 9 + 9 * (uint64_t)n;
+        return (uint32_t)((bits * 1000000ULL + clockHz - 1) / clockHz) + overheadUs;
+    }
+    // Thoi diem byte du lieu thu i cua giao dich hien tai truyen xong (cho model kiem tra timing)
+    double byteDoneUs(size_t i) const {
+        return startUs + overheadUs + (1.0 + 9.0 * (i + 2)) * 1e6 / clockHz;
+    }
+    void charge(size_t n) {
+        uint32_t us = duration(n);
+        startUs = now_us;
+        transactions++;
+        bytes += n;
+        busyUs += us;
+        now_us += us;
+    }
+    void resetCounters() {
+        transactions = 0;
+        bytes = 0;
+        busyUs = 0;
+    }
+};
+
+inline I2cBus bus;
+
+inline void attach(uint8_t addr, I2cDevice *dev) { bus.devices[addr & 0x7F] = dev; }
+inline void detachAll() { for (auto &d : bus.devices) d = nullptr; }
+
+}
+
+class TwoWire : public Stream {
+public:
+    bool begin() { return true; }
+    bool begin(int sda, int scl, uint32_t frequency = 0) {
+        if (frequency) setClock(frequency);
+        return true;
+    }
+    bool setClock(uint32_t frequency) { sim::bus.clockHz = frequency; return true; }
+    uint32_t getClock() { return sim::bus.clockHz; }
+    void setTimeOut(uint16_t) {}
+
+    void beginTransmission(uint8_t address) {
+        _addr = address;
+        _tx.clear();
+    }
+    uint8_t endTransmission(bool sendStop = true) {
+        // ESP32: qua I2C_BUFFER_LENGTH thi write() da tu choi tu truoc
+        sim::bus.charge(_tx.size());
+        sim::I2cDevice *dev = sim::bus.devices[_addr & 0x7F];
+        if (dev == nullptr) return 2;
+        return dev->write(_tx.data(), _tx.size()) ? 0 : 3;
+    }
+    uint8_t requestFrom(uint8_t address, uint8_t quantity) { return requestFrom(address, (size_t)quantity, true); }
+    uint8_t requestFrom(uint8_t address, size_t quantity, bool sendStop) {
+        sim::bus.charge(quantity);
+        _rx.assign(quantity, 0);
+        _rpos = 0;
+        sim::I2cDevice *dev = sim::bus.devices[address & 0x7F];
+        _rx.resize(dev ? dev->read(_rx.data(), quantity) : 0);
+        return (uint8_t)_rx.size();
+    }
+
+    size_t write(uint8_t data) override {
+        if (_tx.size() >= I2C_BUFFER_LENGTH) return 0;
+        _tx.push_back(data);
+        return 1;
+    }
+    size_t write(const uint8_t *data, size_t size) override {
+        size_t n = 0;
+        while (n < size && write(data[n])) n++;
+        return n;
+    }
+    // nhu core ESP32: write(0) khong bi nham voi write(const char *)
+    size_t write(int data) { return write((uint8_t)data); }
+    size_t write(unsigned int data) { return write((uint8_t)data); }
+    using Print::write;
+    int available() override { return (int)(_rx.size() - _rpos); }
+    int read() override { return _rpos < _rx.size() ? _rx[_rpos++] : -1; }
+    int peek() override { return _rpos < _rx.size() ? _rx[_rpos] : -1; }
+
+private:
+    uint8_t _addr = 0;
+    std::vector<uint8_t> _tx, _rx;
+    size_t _rpos = 0;
+};
+
+inline TwoWire Wire;
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef SIM_DRIVER_GPIO_H
+#define SIM_DRIVER_GPIO_H
+#include <stdint.h>
+
+// Chi du de bien dich; test relay dung relay_hal_t rieng. Level cuoi cua moi chan ghi vao sim::gpioLevel.
+typedef int gpio_num_t;
+typedef enum { GPIO_MODE_INPUT, GPIO_MODE_OUTPUT } gpio_mode_t;
+
+namespace sim {
+inline uint32_t gpioLevel[64];
+}
+
+inline int gpio_reset_pin(gpio_num_t) { return 0; }
+inline int gpio_set_direction(gpio_num_t, gpio_mode_t) { return 0; }
+inline int gpio_set_level(gpio_num_t pin, uint32_t level) {
+    if (pin >= 0 && pin < 64) sim::gpioLevel[pin] = level;
+    return 0;
+}
+inline int gpio_hold_en(gpio_num_t) { return 0; }
+inline int gpio_hold_dis(gpio_num_t) { return 0; }
+inline int gpio_deep_sleep_hold_en() { return 0; }
+inline void gpio_deep_sleep_hold_dis() {}
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef SIM_ESP_HEAP_CAPS_H
+#define SIM_ESP_HEAP_CAPS_H
+#include <stddef.h>
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+
+// Heap gia co dinh, du cho code chi doc so lieu
+inline size_t heap_caps_get_free_size(int caps) { return 200000; }
+inline size_t heap_caps_get_minimum_free_size(int caps) { return 150000; }
+inline size_t heap_caps_get_largest_free_block(int caps) { return 110592; }
+
+#endif
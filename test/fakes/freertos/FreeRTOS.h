@@ -0,0 +1,51 @@
+#ifndef FAKE_FREERTOS_H
+#define FAKE_FREERTOS_H
+// FreeRTOS gia cho test tren host: mot luong, thoi gian la dong ho ao cua Arduino.h.
+// Critical section chi dem do sau (test kiem tra can bang), cho = cong dong ho.
+#include <Arduino.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+#define portMAX_DELAY       ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS  1
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+#define portNUM_PROCESSORS  2
+#define configMAX_TASK_NAME_LEN 16
+#define configUSE_TRACE_FACILITY 1
+#define tskNO_AFFINITY          0x7FFFFFFF
+
+typedef struct {
+    int depth;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+
+namespace sim {
+inline int criticalDepth = 0;   // tong do sau dang giu, phai ve 0 sau moi ham
+inline bool inIsr = false;
+}
+
+#define portENTER_CRITICAL(m)       do { (m)->depth++; sim::criticalDepth++; } while (0)
+#define portEXIT_CRITICAL(m)        do { (m)->depth--; sim::criticalDepth--; } while (0)
+#define portENTER_CRITICAL_ISR(m)   portENTER_CRITICAL(m)
+#define portEXIT_CRITICAL_ISR(m)    portEXIT_CRITICAL(m)
+#define portENTER_CRITICAL_SAFE(m)  portENTER_CRITICAL(m)
+#define portEXIT_CRITICAL_SAFE(m)   portEXIT_CRITICAL(m)
+#define portYIELD_FROM_ISR(...)     do { } while (0)
+
+inline BaseType_t xPortInIsrContext() { return sim::inIsr; }
+inline TickType_t xTaskGetTickCount() { return millis(); }
+
+// Cho `ticks` tren dong ho ao (portMAX_DELAY = khong bao gio toi -> tra ve ngay)
+namespace sim {
+inline void wait_ticks(TickType_t ticks) {
+    if (ticks != portMAX_DELAY) advance((uint64_t)ticks * 1000);
+}
+}
+
+#endif
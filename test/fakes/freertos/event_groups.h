@@ -0,0 +1,40 @@
+#ifndef FAKE_FREERTOS_EVENT_GROUPS_H
+#define FAKE_FREERTOS_EVENT_GROUPS_H
+#include "FreeRTOS.h"
+
+typedef uint32_t EventBits_t;
+struct sim_event_group_t {
+    EventBits_t bits;
+};
+typedef sim_event_group_t *EventGroupHandle_t;
+
+inline EventGroupHandle_t xEventGroupCreate() { return new sim_event_group_t{ 0 }; }
+inline EventBits_t xEventGroupGetBits(EventGroupHandle_t g) { return g->bits; }
+inline EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t bits) { return g->bits |= bits; }
+inline EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t bits) {
+    EventBits_t old = g->bits;
+    g->bits &= ~bits;
+    return old;
+}
+inline BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t g, EventBits_t bits, BaseType_t *) {
+    xEventGroupSetBits(g, bits);
+    return pdPASS;
+}
+inline BaseType_t xEventGroupClearBitsFromISR(EventGroupHandle_t g, EventBits_t bits) {
+    xEventGroupClearBits(g, bits);
+    return pdPASS;
+}
+// Khong co task khac set bit trong luc cho: het ticks thi tra ve bit hien tai
+inline EventBits_t xEventGroupWaitBits(EventGroupHandle_t g, EventBits_t bits, BaseType_t clearOnExit,
+                                       BaseType_t waitAll, TickType_t ticks) {
+    EventBits_t v = g->bits;
+    bool ok = waitAll ? (v & bits) == bits : (v & bits) != 0;
+    if (!ok) {
+        sim::wait_ticks(ticks);
+        return g->bits;
+    }
+    if (clearOnExit) g->bits &= ~bits;
+    return v;
+}
+
+#endif
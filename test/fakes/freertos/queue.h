@@ -0,0 +1,48 @@
+#ifndef FAKE_FREERTOS_QUEUE_H
+#define FAKE_FREERTOS_QUEUE_H
+#include "FreeRTOS.h"
+#include <deque>
+#include <vector>
+
+struct sim_queue_t {
+    UBaseType_t capacity;
+    UBaseType_t itemSize;
+    std::deque<std::vector<uint8_t>> items;
+};
+typedef sim_queue_t *QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    QueueHandle_t q = new sim_queue_t();
+    q->capacity = length;
+    q->itemSize = itemSize;
+    return q;
+}
+inline void vQueueDelete(QueueHandle_t q) { delete q; }
+
+// Day: khong co ai lay ra trong khi cho, nen chi cong dong ho roi bao loi
+inline BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks) {
+    if (q->items.size() >= q->capacity) {
+        sim::wait_ticks(ticks);
+        return pdFAIL;
+    }
+    const uint8_t *p = (const uint8_t *)item;
+    q->items.emplace_back(p, p + q->itemSize);
+    return pdPASS;
+}
+#define xQueueSendToBack xQueueSend
+inline BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *) {
+    return xQueueSend(q, item, 0);
+}
+inline BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks) {
+    if (q->items.empty()) {
+        sim::wait_ticks(ticks);
+        return pdFALSE;
+    }
+    memcpy(item, q->items.front().data(), q->itemSize);
+    q->items.pop_front();
+    return pdTRUE;
+}
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) { return q->items.size(); }
+inline UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q) { return q->capacity - q->items.size(); }
+
+#endif
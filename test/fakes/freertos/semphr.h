@@ -0,0 +1,28 @@
+#ifndef FAKE_FREERTOS_SEMPHR_H
+#define FAKE_FREERTOS_SEMPHR_H
+#include "FreeRTOS.h"
+
+struct sim_semaphore_t {
+    UBaseType_t count;
+    UBaseType_t max;
+};
+typedef sim_semaphore_t *SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return new sim_semaphore_t{ 1, 1 }; }
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return new sim_semaphore_t{ 0, 1 }; }
+inline void vSemaphoreDelete(SemaphoreHandle_t s) { delete s; }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+    if (s->count == 0) {
+        sim::wait_ticks(ticks);
+        return pdFALSE;
+    }
+    s->count--;
+    return pdTRUE;
+}
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+    if (s->count >= s->max) return pdFALSE;
+    s->count++;
+    return pdTRUE;
+}
+
+#endif
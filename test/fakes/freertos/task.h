@@ -0,0 +1,130 @@
+#ifndef FAKE_FREERTOS_TASK_H
+#define FAKE_FREERTOS_TASK_H
+#include "FreeRTOS.h"
+#include <vector>
+
+typedef void (*TaskFunction_t)(void *);
+
+// Task khong chay that: xTaskCreate chi ghi lai, test goi ham task neu can
+struct sim_task_t {
+    char name[configMAX_TASK_NAME_LEN];
+    TaskFunction_t fn;
+    void *param;
+    uint32_t notifyValue;
+    bool notifyPending;
+    UBaseType_t number;
+};
+typedef sim_task_t *TaskHandle_t;
+
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+typedef enum {
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+typedef struct {
+    TaskHandle_t xHandle;
+    const char  *pcTaskName;
+    UBaseType_t  xTaskNumber;
+    eTaskState   eCurrentState;
+    UBaseType_t  uxCurrentPriority;
+    UBaseType_t  uxBasePriority;
+    uint32_t     ulRunTimeCounter;
+    uint8_t     *pxStackBase;
+    uint32_t     usStackHighWaterMark;
+    BaseType_t   xCoreID;
+} TaskStatus_t;
+
+namespace sim {
+// Bang tra ve boi uxTaskGetSystemState(), test tu dien
+inline std::vector<TaskStatus_t> systemState;
+inline uint32_t totalRuntime = 0;
+inline sim_task_t mainTask = { "main", NULL, NULL, 0, false, 1 };
+inline TaskHandle_t currentTask = &mainTask;
+inline UBaseType_t taskCount = 1;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t, void *param,
+                              UBaseType_t, TaskHandle_t *handle) {
+    TaskHandle_t t = new sim_task_t();
+    strncpy(t->name, name, sizeof(t->name) - 1);
+    t->fn = fn;
+    t->param = param;
+    t->number = ++sim::taskCount;
+    if (handle) *handle = t;
+    return pdPASS;
+}
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *param,
+                                          UBaseType_t prio, TaskHandle_t *handle, BaseType_t) {
+    return xTaskCreate(fn, name, stack, param, prio, handle);
+}
+inline void vTaskDelete(TaskHandle_t) {}
+inline void vTaskDelay(TickType_t ticks) { sim::wait_ticks(ticks); }
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return sim::currentTask; }
+inline UBaseType_t uxTaskGetNumberOfTasks() {
+    return sim::systemState.empty() ? sim::taskCount : sim::systemState.size();
+}
+// Nhu FreeRTOS: bang qua nho -> tra ve 0
+inline UBaseType_t uxTaskGetSystemState(TaskStatus_t *out, UBaseType_t size, uint32_t *totalRuntime) {
+    if (size < sim::systemState.size()) return 0;
+    for (size_t i = 0; i < sim::systemState.size(); i++) out[i] = sim::systemState[i];
+    if (totalRuntime) *totalRuntime = sim::totalRuntime;
+    return sim::systemState.size();
+}
+
+inline BaseType_t xTaskNotify(TaskHandle_t t, uint32_t value, eNotifyAction action) {
+    switch (action) {
+        case eSetBits: t->notifyValue |= value; break;
+        case eIncrement: t->notifyValue++; break;
+        case eSetValueWithOverwrite: t->notifyValue = value; break;
+        case eSetValueWithoutOverwrite:
+            if (t->notifyPending) return pdFAIL;
+            t->notifyValue = value;
+            break;
+        default: break;
+    }
+    t->notifyPending = true;
+    return pdPASS;
+}
+inline BaseType_t xTaskNotifyFromISR(TaskHandle_t t, uint32_t value, eNotifyAction action, BaseType_t *) {
+    return xTaskNotify(t, value, action);
+}
+inline BaseType_t xTaskNotifyGive(TaskHandle_t t) { return xTaskNotify(t, 0, eIncrement); }
+inline void vTaskNotifyGiveFromISR(TaskHandle_t t, BaseType_t *) { xTaskNotifyGive(t); }
+
+inline BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t *value, TickType_t ticks) {
+    TaskHandle_t t = sim::currentTask;
+    if (!t->notifyPending) {
+        t->notifyValue &= ~clearOnEntry;
+        sim::wait_ticks(ticks);
+        return pdFALSE;
+    }
+    if (value) *value = t->notifyValue;
+    t->notifyValue &= ~clearOnExit;
+    t->notifyPending = false;
+    return pdTRUE;
+}
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    TaskHandle_t t = sim::currentTask;
+    if (t->notifyValue == 0) {
+        sim::wait_ticks(ticks);
+        return 0;
+    }
+    uint32_t v = t->notifyValue;
+    t->notifyValue = clearOnExit ? 0 : v - 1;
+    t->notifyPending = false;
+    return v;
+}
+
+#endif
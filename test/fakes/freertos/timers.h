@@ -0,0 +1,70 @@
+#ifndef FAKE_FREERTOS_TIMERS_H
+#define FAKE_FREERTOS_TIMERS_H
+#include "FreeRTOS.h"
+#include <vector>
+
+struct sim_timer_t;
+typedef sim_timer_t *TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+typedef void (*PendedFunction_t)(void *, uint32_t);
+
+struct sim_timer_t {
+    const char *name;
+    TickType_t period;
+    bool autoReload;
+    void *id;
+    TimerCallbackFunction_t cb;
+    bool active;
+    uint64_t expiryMs;
+};
+
+namespace sim {
+inline std::vector<TimerHandle_t> timers;
+
+// Chay cac timer toi han cho toi `ms` (dong ho ao), theo thu tu thoi diem het han
+inline void run_timers_until(uint64_t ms) {
+    while (true) {
+        TimerHandle_t next = NULL;
+        for (TimerHandle_t t : timers) {
+            if (t->active && t->expiryMs <= ms && (!next || t->expiryMs < next->expiryMs)) next = t;
+        }
+        if (!next) break;
+        if (now_us < next->expiryMs * 1000) now_us = next->expiryMs * 1000;
+        if (next->autoReload) next->expiryMs += next->period;
+        else next->active = false;
+        next->cb(next);
+    }
+    if (now_us < ms * 1000) now_us = ms * 1000;
+}
+}
+
+inline TimerHandle_t xTimerCreate(const char *name, TickType_t period, BaseType_t autoReload, void *id,
+                                  TimerCallbackFunction_t cb) {
+    TimerHandle_t t = new sim_timer_t{ name, period, autoReload != 0, id, cb, false, 0 };
+    sim::timers.push_back(t);
+    return t;
+}
+inline BaseType_t xTimerStart(TimerHandle_t t, TickType_t) {
+    t->active = true;
+    t->expiryMs = millis() + t->period;
+    return pdPASS;
+}
+#define xTimerReset xTimerStart
+inline BaseType_t xTimerStop(TimerHandle_t t, TickType_t) {
+    t->active = false;
+    return pdPASS;
+}
+inline BaseType_t xTimerChangePeriod(TimerHandle_t t, TickType_t period, TickType_t ticks) {
+    t->period = period;
+    return xTimerStart(t, ticks);
+}
+inline BaseType_t xTimerIsTimerActive(TimerHandle_t t) { return t->active; }
+inline TickType_t xTimerGetPeriod(TimerHandle_t t) { return t->period; }
+inline void *pvTimerGetTimerID(TimerHandle_t t) { return t->id; }
+// Chay ngay tren "timer task"
+inline BaseType_t xTimerPendFunctionCall(PendedFunction_t fn, void *param, uint32_t arg, TickType_t) {
+    fn(param, arg);
+    return pdPASS;
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef SIM_CLIENT_H
+#define SIM_CLIENT_H
+#include <Arduino.h>
+#include <Client.h>
+#include <vector>
+
+namespace sim {
+
+// Client dua tren bo nho: `rx` la du lieu server gui toi, `tx` ghi lai moi byte gui di.
+// `maxAvailable` gioi han available() (0 = het) de gia lap goi TCP den tung manh.
+struct MemoryClient : Client {
+    std::vector<uint8_t> rx;
+    size_t rxPos = 0;
+    size_t maxAvailable = 0;
+    std::vector<uint8_t> tx;
+    std::vector<size_t> writeSizes;     // kich thuoc moi lan write(), moi lan ~ 1 segment TCP
+    uint32_t reads = 0;                 // so lan goi read() / read(buf, n)
+    bool open = false;
+
+    void feed(const std::vector<uint8_t> &bytes) { rx.insert(rx.end(), bytes.begin(), bytes.end()); }
+    void rewind() { rxPos = 0; }
+    void resetCounters() {
+        tx.clear();
+        writeSizes.clear();
+        reads = 0;
+    }
+
+    int connect(IPAddress, uint16_t) override { open = true; return 1; }
+    int connect(const char *, uint16_t) override { open = true; return 1; }
+    size_t write(uint8_t b) override { return write(&b, 1); }
+    size_t write(const uint8_t *buf, size_t size) override {
+        tx.insert(tx.end(), buf, buf + size);
+        writeSizes.push_back(size);
+        return size;
+    }
+    int available() override {
+        size_t n = rx.size() - rxPos;
+        return (int)(maxAvailable && n > maxAvailable ? maxAvailable : n);
+    }
+    int read() override {
+        reads++;
+        return rxPos < rx.size() ? rx[rxPos++] : -1;
+    }
+    int read(uint8_t *buf, size_t size) override {
+        reads++;
+        size_t n = rx.size() - rxPos;
+        if (n > size) n = size;
+        memcpy(buf, rx.data() + rxPos, n);
+        rxPos += n;
+        return (int)n;
+    }
+    int peek() override { return rxPos < rx.size() ? rx[rxPos] : -1; }
+    void flush() override {}
+    void stop() override { open = false; }
+    uint8_t connected() override { return open; }
+    operator bool() override { return open; }
+};
+
+// Stream chi ghi lai nhung gi nhan duoc
+struct CaptureStream : Stream {
+    std::vector<uint8_t> data;
+
+    size_t write(uint8_t b) override { data.push_back(b); return 1; }
+    size_t write(const uint8_t *buf, size_t size) override {
+        data.insert(data.end(), buf, buf + size);
+        return size;
+    }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+// Goi PUBLISH tu server (remaining length nhieu byte neu can)
+inline std::vector<uint8_t> mqtt_publish(const std::string &topic, const std::vector<uint8_t> &payload,
+                                         uint8_t qos = 0, uint16_t msgId = 1) {
+    std::vector<uint8_t> p;
+    uint32_t len = 2 + topic.size() + (qos ? 2 : 0) + payload.size();
+    p.push_back(0x30 | (qos << 1));
+    do {
+        uint8_t d = len % 128;
+        len /= 128;
+        p.push_back(len ? d | 0x80 : d);
+    } while (len);
+    p.push_back(topic.size() >> 8);
+    p.push_back(topic.size() & 0xFF);
+    p.insert(p.end(), topic.begin(), topic.end());
+    if (qos) {
+        p.push_back(msgId >> 8);
+        p.push_back(msgId & 0xFF);
+    }
+    p.insert(p.end(), payload.begin(), payload.end());
+    return p;
+}
+
+inline std::vector<uint8_t> mqtt_connack() { return { 0x20, 0x02, 0x00, 0x00 }; }
+
+}
+
+#endif
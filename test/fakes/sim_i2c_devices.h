@@ -0,0 +1,160 @@
+#ifndef SIM_I2C_DEVICES_H
+#define SIM_I2C_DEVICES_H
+// Model thiet bi cho Wire gia: DHT20 va LCD HD44780 qua PCF8574
+#include "Wire.h"
+#include <string>
+
+namespace sim {
+
+// DHT20 (AHT20): 0xAC 0x33 0x00 bat dau do, status 0x18 = da hieu chuan, 0x80 = dang do,
+// 7 byte ket qua voi CRC8 (0x31, init 0xFF). Reset thanh ghi 0x1B/0x1C/0x1E (ghi, doc,
+// ghi lai 0xBx); reset du ca 3 thanh ghi thi sensor bao da hieu chuan.
+struct Dht20 : I2cDevice {
+    uint32_t rawHumidity = 0x80000;     // 50 %RH
+    uint32_t rawTemperature = 0x66666;  // 30 C
+    uint32_t conversionUs = 80000;
+    bool calibrated = false;
+    bool corruptCrc = false;
+    int triggers = 0;
+    int registerResets = 0;
+    int statusReads = 0;
+    int dataReads = 0;
+
+    bool measuring() {
+        if (_measuring && now_us - _startUs >= conversionUs) _measuring = false;
+        return _measuring;
+    }
+    uint8_t status() { return (calibrated ? 0x18 : 0x10) | (measuring() ? 0x80 : 0); }
+
+    static uint8_t crc8(const uint8_t *p, size_t n) {
+        uint8_t crc = 0xFF;
+        while (n--) {
+            crc ^= *p++;
+            for (int i = 0; i < 8; i++) crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+        return crc;
+    }
+
+    bool write(const uint8_t *d, size_t n) override {
+        if (n == 3 && d[0] == 0xAC) {
+            _measuring = true;
+            _startUs = now_us;
+            triggers++;
+        } else if (n == 3 && (d[0] == 0x1B || d[0] == 0x1C || d[0] == 0x1E)) {
+            _resetMask |= 1 << (d[0] & 7);
+        } else if (n == 3 && (d[0] & 0xF0) == 0xB0) {
+            registerResets++;       // buoc cuoi cua reset mot thanh ghi
+            if (_resetMask == ((1 << 3) | (1 << 4) | (1 << 6))) calibrated = true;
+        }
+        return true;
+    }
+    size_t read(uint8_t *d, size_t n) override {
+        uint8_t frame[7];
+        frame[0] = status();
+        frame[1] = rawHumidity >> 12;
+        frame[2] = rawHumidity >> 4;
+        frame[3] = (uint8_t)(rawHumidity << 4) | ((rawTemperature >> 16) & 0x0F);
+        frame[4] = rawTemperature >> 8;
+        frame[5] = rawTemperature;
+        frame[6] = crc8(frame, 6) ^ (corruptCrc ? 0x01 : 0);
+        if (n < 7) statusReads++;
+        else dataReads++;
+        for (size_t i = 0; i < n; i++) d[i] = i < 7 ? frame[i] : 0;
+        return n;
+    }
+
+private:
+    bool _measuring = false;
+    uint64_t _startUs = 0;
+    uint8_t _resetMask = 0;
+};
+
+// PCF8574 (P0 RS, P1 RW, P2 EN, P3 den nen, P4-P7 D4-D7) noi HD44780.
+// Chot nibble o canh xuong EN, giai ma lai lenh / du lieu vao DDRAM va CGRAM.
+// `violations` dem canh len EN khi controller con ban (37 us, 1.52 ms cho clear/home).
+struct Hd44780 : I2cDevice {
+    uint8_t ddram[128];
+    uint8_t cgram[64];
+    uint8_t address = 0;
+    bool toCgram = false;
+    bool eightBit = true;
+    int commands = 0;
+    int data = 0;
+    int violations = 0;
+    uint8_t cols;
+
+    explicit Hd44780(uint8_t columns = 16) : cols(columns) {
+        memset(ddram, ' ', sizeof(ddram));
+        memset(cgram, 0, sizeof(cgram));
+    }
+
+    // Dong r dang hien thi (offset 0x00, 0x40, 0x14, 0x54)
+    std::string row(int r) const {
+        static const uint8_t offsets[] = { 0x00, 0x40, 0x14, 0x54 };
+        return std::string((const char *)ddram + offsets[r & 3], cols);
+    }
+    uint8_t at(int col, int r) const { return (uint8_t)row(r)[col]; }
+    bool backlight() const { return _last & 0x08; }
+
+    bool write(const uint8_t *d, size_t n) override {
+        for (size_t i = 0; i < n; i++) {
+            double t = bus.byteDoneUs(i);
+            bool enBefore = _last & 0x04, enNow = d[i] & 0x04;
+            if (!enBefore && enNow && t < _busyUntil) violations++;
+            if (enBefore && !enNow) latch(_last, t);
+            _last = d[i];
+        }
+        return true;
+    }
+    size_t read(uint8_t *, size_t) override { return 0; }
+
+private:
+    uint8_t _last = 0;
+    bool _haveHigh = false;
+    uint8_t _high = 0;
+    double _busyUntil = 0;
+
+    void latch(uint8_t pins, double t) {
+        uint8_t nibble = pins & 0xF0;
+        bool rs = pins & 0x01;
+        if (eightBit) {
+            execute(nibble, rs, t);
+            return;
+        }
+        if (!_haveHigh) {
+            _high = nibble;
+            _haveHigh = true;
+            return;
+        }
+        _haveHigh = false;
+        execute(_high | (nibble >> 4), rs, t);
+    }
+    void execute(uint8_t v, bool rs, double t) {
+        _busyUntil = t + 37;
+        if (rs) {
+            data++;
+            if (toCgram) cgram[address++ & 0x3F] = v;
+            else ddram[address++ & 0x7F] = v;
+            return;
+        }
+        commands++;
+        if (v & 0x80) {
+            address = v & 0x7F;
+            toCgram = false;
+        } else if (v & 0x40) {
+            address = v & 0x3F;
+            toCgram = true;
+        } else if (v & 0x20) {
+            eightBit = v & 0x10;
+        } else if (v <= 0x03) {
+            if (v == 0x01) memset(ddram, ' ', sizeof(ddram));
+            address = 0;
+            toCgram = false;
+            _busyUntil = t + 1520;
+        }
+    }
+};
+
+}
+
+#endif
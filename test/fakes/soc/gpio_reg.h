@@ -0,0 +1,14 @@
+#ifndef SIM_SOC_GPIO_REG_H
+#define SIM_SOC_GPIO_REG_H
+#include <stdint.h>
+
+namespace sim {
+inline uint32_t gpioRegs[4];
+}
+
+#define GPIO_OUT_W1TS_REG       (&sim::gpioRegs[0])
+#define GPIO_OUT_W1TC_REG       (&sim::gpioRegs[1])
+#define GPIO_OUT1_W1TS_REG      (&sim::gpioRegs[2])
+#define GPIO_OUT1_W1TC_REG      (&sim::gpioRegs[3])
+
+#endif
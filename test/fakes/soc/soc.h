@@ -0,0 +1,9 @@
+#ifndef SIM_SOC_H
+#define SIM_SOC_H
+#include <stdint.h>
+
+// Thanh ghi gia: moi dia chi la mot o nho tren host
+#define REG_WRITE(reg, val)     (*(volatile uint32_t *)(reg) = (val))
+#define REG_READ(reg)           (*(volatile uint32_t *)(reg))
+
+#endif
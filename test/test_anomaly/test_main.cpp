@@ -0,0 +1,202 @@
+#include <unity.h>
+#include <chrono>
+#include <random>
+#include "../../src/anomaly.cpp"
+#include "../../src/tiny_nn.cpp"
+
+// Console gia: chi giu lenh da dang ky
+static const console_cmd_t *registered = NULL;
+bool console_register(const console_cmd_t *cmd) {
+    registered = cmd;
+    return true;
+}
+void console_prompt() {}
+
+// Tham chieu doc lap: double + llround (lam tron xa 0), khong dung tiny_nn
+static int8_t ref_requant(int64_t acc, const nn_requant_t &rq) {
+    long long v = llround((double)acc * rq.mult / (double)(1LL << rq.shift));
+    return (int8_t)(v > 127 ? 127 : v < -128 ? -128 : v);
+}
+
+static void ref_quantize(const anomaly_state_t *s, int8_t in[ANOMALY_WINDOW][ANOMALY_CHANNELS]) {
+    int oldest = (s->head + ANOMALY_WINDOW - s->count) % ANOMALY_WINDOW;
+    long tSum = 0, hSum = 0;
+    for (int i = 0; i < s->count; i++) {
+        tSum += s->temp[(oldest + i) % ANOMALY_WINDOW];
+        hSum += s->humi[(oldest + i) % ANOMALY_WINDOW];
+    }
+    long tMean = tSum / s->count, hMean = hSum / s->count;
+    for (int i = 0; i < ANOMALY_WINDOW; i++) {
+        int k = i < ANOMALY_WINDOW - s->count ? 0 : i - (ANOMALY_WINDOW - s->count);
+        int idx = (oldest + k) % ANOMALY_WINDOW;
+        long long qt = llround((double)(s->temp[idx] - tMean) / ANOMALY_TEMP_LSB_CENTI);
+        long long qh = llround((double)(s->humi[idx] - hMean) / ANOMALY_HUMI_LSB_CENTI);
+        in[i][0] = (int8_t)(qt > 127 ? 127 : qt < -127 ? -127 : qt);
+        in[i][1] = (int8_t)(qh > 127 ? 127 : qh < -127 ? -127 : qh);
+    }
+}
+
+static int8_t ref_infer(const int8_t in[ANOMALY_WINDOW][ANOMALY_CHANNELS]) {
+    int8_t pooled[ANOMALY_FEATURES];
+    for (int f = 0; f < ANOMALY_FEATURES; f++) {
+        int8_t m = -128;
+        for (int t = CONV_STEPS - ANOMALY_POOL_TAIL; t < CONV_STEPS; t++) {
+            int64_t acc = 0;
+            for (int k = 0; k < ANOMALY_KERNEL; k++) {
+                for (int c = 0; c < ANOMALY_CHANNELS; c++) {
+                    acc += in[t + k][c] * convWeights[f][k][c];
+                }
+            }
+            int8_t v = ref_requant(acc, convRequant[f]);
+            if (v < 0) v = 0;
+            if (v > m) m = v;
+        }
+        pooled[f] = m;
+    }
+    int64_t acc = 0;
+    for (int f = 0; f < ANOMALY_FEATURES; f++) acc += pooled[f] * denseWeights[f];
+    int8_t score = ref_requant(acc, denseRequant);
+    return score < 0 ? 0 : score;
+}
+
+static anomaly_state_t state;
+
+void setUp(void) {
+    anomaly_init(&state);
+    Serial.output.clear();
+}
+
+void tearDown(void) {}
+
+static void test_needs_min_samples(void) {
+    for (int i = 0; i < ANOMALY_MIN_SAMPLES - 1; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, anomaly_feed(&state, 2500 + 100 * i, 6000));
+    }
+    TEST_ASSERT_EQUAL(0, state.runs);
+    anomaly_feed(&state, 2500, 6000);
+    TEST_ASSERT_EQUAL(1, state.runs);
+}
+
+static void test_flat_signal_scores_zero(void) {
+    uint8_t score = 0;
+    for (int i = 0; i < ANOMALY_WINDOW + 5; i++) score = anomaly_feed(&state, 2531, 6120);
+    TEST_ASSERT_EQUAL_UINT8(0, score);
+}
+
+// Gia tri chot: integer thuan nen phai giong het tren host va ESP32-S3
+static void test_golden_scores(void) {
+    for (int i = 0; i < ANOMALY_WINDOW - 1; i++) anomaly_feed(&state, 2500, 6000);
+    TEST_ASSERT_EQUAL_UINT8(127, anomaly_feed(&state, 2600, 6000));
+
+    anomaly_init(&state);
+    for (int i = 0; i < ANOMALY_WINDOW - 1; i++) anomaly_feed(&state, 2500, 6000);
+    TEST_ASSERT_EQUAL_UINT8(72, anomaly_feed(&state, 2500, 6200));
+
+    anomaly_init(&state);
+    for (int i = 0; i < ANOMALY_WINDOW - 1; i++) anomaly_feed(&state, 2500, 6000);
+    TEST_ASSERT_EQUAL_UINT8(72, anomaly_feed(&state, 2550, 6000));
+
+    // nhieu 0.05 °C quanh gia tri co dinh: xa nguong
+    anomaly_init(&state);
+    uint8_t maxScore = 0;
+    for (int i = 0; i < 3 * ANOMALY_WINDOW; i++) {
+        uint8_t s = anomaly_feed(&state, 2500 + (i & 1) * 5, 6000);
+        if (s > maxScore) maxScore = s;
+    }
+    TEST_ASSERT_LESS_THAN(ANOMALY_THRESHOLD / 4, maxScore);
+}
+
+static void test_matches_reference(void) {
+    std::mt19937 rng(14);
+    std::normal_distribution<float> noise(0, 0.08f);
+    std::uniform_int_distribution<int> spike(0, 40);
+    int8_t input[ANOMALY_WINDOW * ANOMALY_CHANNELS];
+    int8_t ref[ANOMALY_WINDOW][ANOMALY_CHANNELS];
+    float t = 24.0f, h = 55.0f;
+    int flagged = 0;
+
+    for (int i = 0; i < 5000; i++) {
+        t += noise(rng);
+        h += 4 * noise(rng);
+        float st = t, sh = h;
+        if (spike(rng) == 0) st += (rng() & 1 ? 1.5f : -1.5f);
+        if (spike(rng) == 0) sh += (rng() & 1 ? 6.0f : -6.0f);
+        uint8_t score = anomaly_feed(&state, (int16_t)lroundf(st * 100), (int16_t)lroundf(sh * 100));
+        if (state.count < ANOMALY_MIN_SAMPLES) continue;
+
+        anomaly_quantize(&state, input);
+        ref_quantize(&state, ref);
+        TEST_ASSERT_EQUAL_MEMORY(ref, input, sizeof(input));
+        TEST_ASSERT_EQUAL_INT8(ref_infer(ref), (int8_t)score);
+        if (score >= ANOMALY_THRESHOLD) flagged++;
+    }
+    // du lieu co gai -> duong so sanh phai di qua ca vung vuot nguong
+    TEST_ASSERT_GREATER_THAN(50, flagged);
+}
+
+// Lenh "ai" khong duoc ghi de ket qua cua mau that
+static void test_bench_keeps_last_score(void) {
+    for (int i = 0; i < ANOMALY_WINDOW; i++) anomaly_feed(&state, 2500, 6000);
+    anomaly_begin();
+    TEST_ASSERT_NOT_NULL(registered);
+    registered->handler(1, NULL);
+    TEST_ASSERT_TRUE(Serial.output.find("Last score 0 ") != std::string::npos);
+    TEST_ASSERT_TRUE(Serial.output.find("spike score 127") != std::string::npos);
+}
+
+static void test_format_json_resets(void) {
+    char json[96];
+    TEST_ASSERT_EQUAL(0, anomaly_format_json(&state, json, sizeof(json)));
+    for (int i = 0; i < ANOMALY_WINDOW - 1; i++) anomaly_feed(&state, 2500, 6000);
+    anomaly_feed(&state, 2600, 6000);
+    anomaly_feed(&state, 2600, 6000);
+    TEST_ASSERT_GREATER_THAN(0, anomaly_format_json(&state, json, sizeof(json)));
+    TEST_ASSERT_EQUAL_STRING("{\"anomaly_score\":", std::string(json).substr(0, 17).c_str());
+    TEST_ASSERT_TRUE(strstr(json, "\"anomaly_max\":127") != NULL);
+    TEST_ASSERT_EQUAL(0, state.runs);
+    TEST_ASSERT_EQUAL(0, state.maxScore);
+}
+
+template <typename F>
+static double ns_per_call(F fn, uint32_t n) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++) fn(i);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+// Microbenchmark tren host, chi in ket qua: thoi gian moi inference (quantize + model) va moi
+// anomaly_feed tren cua so day. So tuong doi; tren ESP32-S3 dung lenh "ai".
+static void test_bench(void) {
+    const uint32_t n = 20000;
+    int8_t input[ANOMALY_WINDOW * ANOMALY_CHANNELS];
+    volatile int sink = 0;
+
+    for (int i = 0; i < ANOMALY_WINDOW; i++) anomaly_feed(&state, 2500 + (i == ANOMALY_WINDOW - 1 ? 100 : 0), 6000);
+    double infer = ns_per_call([&](uint32_t i) {
+        anomaly_quantize(&state, input);
+        sink += anomaly_infer(input);
+    }, n);
+    uint16_t runs = state.runs;
+    double feed = ns_per_call([&](uint32_t i) {
+        sink += anomaly_feed(&state, 2500 + (int16_t)(i % 7), 6000 - (int16_t)(i % 5));
+    }, n);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "inference %.0f ns, anomaly_feed %.0f ns (window %d)",
+             infer, feed, ANOMALY_WINDOW);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL(n, (uint16_t)(state.runs - runs));     // moi lan feed deu chay model
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_needs_min_samples);
+    RUN_TEST(test_flat_signal_scores_zero);
+    RUN_TEST(test_golden_scores);
+    RUN_TEST(test_matches_reference);
+    RUN_TEST(test_bench_keeps_last_score);
+    RUN_TEST(test_format_json_resets);
+    RUN_TEST(test_bench);
+    return UNITY_END();
+}
@@ -0,0 +1,218 @@
+#include <unity.h>
+#include "../../src/config_store.cpp"
+
+static const console_cmd_t *registered = NULL;
+static uint32_t configEvents = 0;
+
+bool console_register(const console_cmd_t *cmd) {
+    registered = cmd;
+    return true;
+}
+void console_prompt() {}
+void event_bus_publish(event_topic_t topic, const void *data, uint8_t len) {
+    if (topic == EVT_CONFIG_CHANGED) configEvents++;
+}
+
+// Backend that (2 file LittleFS gia); sim::writeBudget cat ngang lan ghi nhu mat dien
+static std::vector<uint8_t> &slot_file(uint8_t slot) {
+    return sim::files[slotPath[slot]];
+}
+
+static const config_record_t *slot_record(uint8_t slot) {
+    return (const config_record_t *)slot_file(slot).data();
+}
+
+// Ghi mot truong qua trang Setting, tra ve ket qua luu
+static bool set_ssid(const char *ssid) {
+    char json[128];
+    int n = snprintf(json, sizeof(json), "{\"page\":\"setting\",\"value\":{\"ssid\":\"%s\"}}", ssid);
+    return config_apply_json(json, n);
+}
+
+// Reboot: nap lai tu file nhu luc bat nguon
+static bool reboot() {
+    sim::writeBudget = SIZE_MAX;
+    return config_store_begin();
+}
+
+// Chay lenh console nhu khi go tren Serial
+static void run(std::initializer_list<const char *> args) {
+    char storage[CONSOLE_MAX_ARGS][CONSOLE_LINE_MAX];
+    char *argv[CONSOLE_MAX_ARGS];
+    int argc = 0;
+    for (const char *a : args) {
+        strncpy(storage[argc], a, CONSOLE_LINE_MAX - 1);
+        storage[argc][CONSOLE_LINE_MAX - 1] = '\0';
+        argv[argc] = storage[argc];
+        argc++;
+    }
+    Serial.output.clear();
+    registered->handler(argc, argv);
+}
+
+void setUp(void) {
+    sim::files.clear();
+    sim::writeBudget = SIZE_MAX;
+    configEvents = 0;
+    TEST_ASSERT_FALSE(config_store_begin());
+    TEST_ASSERT_NOT_NULL(registered);
+}
+
+void tearDown(void) {}
+
+// Trang Setting: truong rong/thieu giu nguyen, port nhan ca chuoi
+static void test_apply_json(void) {
+    const char *msg = "{\"page\":\"setting\",\"value\":{\"ssid\":\"home\",\"password\":\"\",\"port\":\"8883\"}}";
+    TEST_ASSERT_TRUE(config_apply_json(msg, strlen(msg)));
+    TEST_ASSERT_EQUAL_STRING("home", config_wifi_ssid());
+    TEST_ASSERT_EQUAL_STRING("", config_wifi_pass());
+    TEST_ASSERT_EQUAL_STRING(CONFIG_DEFAULT_SERVER, config_iot_server());
+    TEST_ASSERT_EQUAL_UINT16(8883, config_iot_port());
+    TEST_ASSERT_EQUAL_UINT32(1, configEvents);
+
+    const char *other = "{\"page\":\"device\",\"value\":{\"ssid\":\"x\"}}";
+    TEST_ASSERT_FALSE(config_apply_json(other, strlen(other)));
+    TEST_ASSERT_EQUAL_STRING("home", config_wifi_ssid());
+}
+
+// cfg set <key> <value> di qua config_apply_json va duoc luu ben qua reboot
+static void test_console_set(void) {
+    run({ "cfg", "set", "ssid", "office" });
+    run({ "cfg", "set", "TOKEN", "abc123" });
+    run({ "cfg", "set", "port", "1884" });
+    TEST_ASSERT_EQUAL_STRING("office", config_wifi_ssid());
+    TEST_ASSERT_EQUAL_STRING("abc123", config_iot_token());
+    TEST_ASSERT_EQUAL_UINT16(1884, config_iot_port());
+    TEST_ASSERT_EQUAL_UINT32(3, config_generation());
+
+    run({ "cfg", "set", "colour", "red" });
+    TEST_ASSERT_NOT_NULL(strstr(Serial.output.c_str(), "Key:"));
+    run({ "cfg", "set", "port", "70000" });
+    TEST_ASSERT_EQUAL_UINT16(1884, config_iot_port());
+
+    TEST_ASSERT_TRUE(reboot());
+    TEST_ASSERT_EQUAL_STRING("abc123", config_iot_token());
+}
+
+static void test_console_json(void) {
+    run({ "cfg", "json", "{\"page\":\"setting\",\"value\":{\"server\":\"demo.local\"}}" });
+    TEST_ASSERT_EQUAL_STRING("demo.local", config_iot_server());
+    run({ "cfg", "json", "{\"page\":" });
+    TEST_ASSERT_NOT_NULL(strstr(Serial.output.c_str(), "Invalid setting message"));
+}
+
+// Mat khau va token khong bao gio in ra console
+static void test_secrets_masked(void) {
+    run({ "cfg", "set", "password", "hunter22" });
+    run({ "cfg", "set", "token", "s3cr3t-token" });
+    run({ "cfg" });
+    const char *out = Serial.output.c_str();
+    TEST_ASSERT_NULL(strstr(out, "hunter22"));
+    TEST_ASSERT_NULL(strstr(out, "s3cr3t-token"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "  pass:   ********\n"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "  token:  ********\n"));
+}
+
+// Slot ghi xen ke A, B, A...; boot chon generation lon nhat
+static void test_boot_picks_newest_generation(void) {
+    TEST_ASSERT_TRUE(set_ssid("one"));
+    TEST_ASSERT_TRUE(set_ssid("two"));
+    TEST_ASSERT_TRUE(set_ssid("three"));
+    TEST_ASSERT_EQUAL_UINT32(3, slot_record(0)->generation);
+    TEST_ASSERT_EQUAL_UINT32(2, slot_record(1)->generation);
+
+    TEST_ASSERT_TRUE(reboot());
+    TEST_ASSERT_EQUAL_UINT32(3, config_generation());
+    TEST_ASSERT_EQUAL_STRING("three", config_wifi_ssid());
+
+    // slot B moi hon thi B thang, khong phu thuoc thu tu
+    TEST_ASSERT_TRUE(set_ssid("four"));
+    TEST_ASSERT_TRUE(reboot());
+    TEST_ASSERT_EQUAL_UINT32(4, config_generation());
+    TEST_ASSERT_EQUAL_STRING("four", config_wifi_ssid());
+}
+
+// Mat dien giua luc ghi slot cu hon: moi diem cat deu giu duoc ban moi nhat o slot kia
+static void test_torn_write_keeps_previous(void) {
+    TEST_ASSERT_TRUE(set_ssid("one"));
+    TEST_ASSERT_TRUE(set_ssid("two"));
+    std::vector<uint8_t> slotB = slot_file(1);
+
+    for (size_t cut = 0; cut < sizeof(config_record_t); cut += 7) {
+        sim::writeBudget = cut;
+        TEST_ASSERT_FALSE(set_ssid("torn"));
+        // RAM khong doi khi ghi loi
+        TEST_ASSERT_EQUAL_STRING("two", config_wifi_ssid());
+        TEST_ASSERT_EQUAL(cut, slot_file(0).size());
+        TEST_ASSERT_TRUE(slotB == slot_file(1));
+
+        TEST_ASSERT_TRUE(reboot());
+        TEST_ASSERT_EQUAL_UINT32(2, config_generation());
+        TEST_ASSERT_EQUAL_STRING("two", config_wifi_ssid());
+    }
+
+    // het mat dien: lan ghi tiep theo van vao slot hong (A), khong dung vao B
+    TEST_ASSERT_TRUE(set_ssid("three"));
+    TEST_ASSERT_EQUAL_UINT32(3, slot_record(0)->generation);
+    TEST_ASSERT_TRUE(slotB == slot_file(1));
+}
+
+// Slot moi nhat hong CRC (bit flip) -> quay ve slot con lai
+static void test_crc_corrupt_slot_falls_back(void) {
+    TEST_ASSERT_TRUE(set_ssid("one"));
+    TEST_ASSERT_TRUE(set_ssid("two"));
+    slot_file(1)[offsetof(config_record_t, wifi_ssid)] ^= 0x01;
+
+    TEST_ASSERT_TRUE(reboot());
+    TEST_ASSERT_EQUAL_UINT32(1, config_generation());
+    TEST_ASSERT_EQUAL_STRING("one", config_wifi_ssid());
+
+    // ghi tiep de len slot hong, generation tiep tuc tu ban hop le
+    TEST_ASSERT_TRUE(set_ssid("three"));
+    TEST_ASSERT_EQUAL_UINT32(2, slot_record(1)->generation);
+    TEST_ASSERT_TRUE(reboot());
+    TEST_ASSERT_EQUAL_STRING("three", config_wifi_ssid());
+}
+
+// Ca 2 slot hong/thieu -> mac dinh, begin bao false, lan ghi dau vao slot A
+static void test_both_slots_bad_uses_defaults(void) {
+    TEST_ASSERT_TRUE(set_ssid("one"));
+    TEST_ASSERT_TRUE(set_ssid("two"));
+    slot_file(0)[offsetof(config_record_t, crc)] ^= 0xFF;
+    slot_file(1).resize(sizeof(config_record_t) / 2);
+
+    TEST_ASSERT_FALSE(reboot());
+    TEST_ASSERT_EQUAL_UINT32(0, config_generation());
+    TEST_ASSERT_EQUAL_STRING("", config_wifi_ssid());
+    TEST_ASSERT_EQUAL_STRING(CONFIG_DEFAULT_SERVER, config_iot_server());
+    TEST_ASSERT_EQUAL_UINT16(CONFIG_DEFAULT_PORT, config_iot_port());
+
+    TEST_ASSERT_TRUE(set_ssid("fresh"));
+    TEST_ASSERT_EQUAL_UINT32(1, slot_record(0)->generation);
+    TEST_ASSERT_TRUE(reboot());
+    TEST_ASSERT_EQUAL_STRING("fresh", config_wifi_ssid());
+}
+
+// Con tro getter: on dinh qua 1 lan update, lan thu 2 ghi de (dung nhu header mo ta)
+static void test_getter_lifetime(void) {
+    TEST_ASSERT_TRUE(set_ssid("one"));
+    const char *ssid = config_wifi_ssid();
+    TEST_ASSERT_TRUE(set_ssid("two"));
+    TEST_ASSERT_EQUAL_STRING("one", ssid);
+    TEST_ASSERT_TRUE(set_ssid("three"));
+    TEST_ASSERT_EQUAL_STRING("three", ssid);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_apply_json);
+    RUN_TEST(test_console_set);
+    RUN_TEST(test_console_json);
+    RUN_TEST(test_secrets_masked);
+    RUN_TEST(test_boot_picks_newest_generation);
+    RUN_TEST(test_torn_write_keeps_previous);
+    RUN_TEST(test_crc_corrupt_slot_falls_back);
+    RUN_TEST(test_both_slots_bad_uses_defaults);
+    RUN_TEST(test_getter_lifetime);
+    return UNITY_END();
+}
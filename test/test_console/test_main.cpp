@@ -0,0 +1,37 @@
+#include <unity.h>
+#include "../../src/console.cpp"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static void test_arg_u32_accepts_decimal(void) {
+    uint32_t v = 0;
+    TEST_ASSERT_TRUE(console_arg_u32("42", &v));
+    TEST_ASSERT_EQUAL_UINT32(42, v);
+    TEST_ASSERT_TRUE(console_arg_u32(" 7", &v));
+    TEST_ASSERT_EQUAL_UINT32(7, v);
+    TEST_ASSERT_TRUE(console_arg_u32("4294967295", &v));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, v);
+}
+
+// strtoul nhan "-1" thanh ULONG_MAX va ghim so qua lon -> phai tu choi, giu nguyen *out
+static void test_arg_u32_rejects_sign_and_overflow(void) {
+    uint32_t v = 5;
+    TEST_ASSERT_FALSE(console_arg_u32("-1", &v));
+    TEST_ASSERT_FALSE(console_arg_u32(" -1", &v));
+    TEST_ASSERT_FALSE(console_arg_u32("+1", &v));
+    TEST_ASSERT_FALSE(console_arg_u32("4294967296", &v));
+    TEST_ASSERT_FALSE(console_arg_u32("99999999999999999999999", &v));
+    TEST_ASSERT_FALSE(console_arg_u32("12x", &v));
+    TEST_ASSERT_FALSE(console_arg_u32("", &v));
+    TEST_ASSERT_FALSE(console_arg_u32(NULL, &v));
+    TEST_ASSERT_EQUAL_UINT32(5, v);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_arg_u32_accepts_decimal);
+    RUN_TEST(test_arg_u32_rejects_sign_and_overflow);
+    return UNITY_END();
+}
@@ -0,0 +1,142 @@
+#include <unity.h>
+#include <string>
+#include <vector>
+#include "../../src/deferred_log.cpp"
+
+bool console_register(const console_cmd_t *cmd) { return true; }
+void console_prompt() {}
+
+static char line[160];
+
+static const char *pop_line() {
+    dlog_record_t rec;
+    if (!dlog_pop(&rec)) return NULL;
+    dlog_format(&rec, line, sizeof(line));
+    return line;
+}
+
+void setUp(void) {
+    ring_init(&logRing);
+    Serial.output.clear();
+}
+
+void tearDown(void) {}
+
+static void test_format_types(void) {
+    TEST_ASSERT_TRUE(dlog("T=%.2f H=%5.1f n=%d u=%lu x=%04x", 27.314f, 61.25, -3, 42UL));
+    TEST_ASSERT_EQUAL_STRING("T=27.31 H= 61.2 n=-3 u=42 x=?", pop_line());
+    TEST_ASSERT_NULL(pop_line());
+}
+
+// Chuoi cua producer bi ghi de ngay sau dlog() -> record van giu ban sao
+static void test_string_args_are_copied(void) {
+    char buf[32];
+    strcpy(buf, "bad token");
+    dlog("Rules rejected: %s (%s)", buf, "line 3");
+    strcpy(buf, "overwritten");
+    TEST_ASSERT_EQUAL_STRING("Rules rejected: bad token (line 3)", pop_line());
+
+    dlog("null %s", (const char *)NULL);
+    TEST_ASSERT_EQUAL_STRING("null (null)", pop_line());
+}
+
+static void test_string_args_truncated(void) {
+    char big[DLOG_TEXT_MAX * 2];
+    memset(big, 'a', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+    dlog("%s|%s|%d", big, "tail", 7);
+    const char *out = pop_line();
+    TEST_ASSERT_EQUAL(DLOG_TEXT_MAX - 1 + 3, strlen(out));
+    TEST_ASSERT_EQUAL_STRING("||7", out + DLOG_TEXT_MAX - 1);
+
+    DeferredLogger::log("Connecting to broker");
+    TEST_ASSERT_EQUAL_STRING("[TB] Connecting to broker", pop_line());
+}
+
+static void test_full_ring_drops(void) {
+    for (int i = 0; i < DLOG_CAPACITY; i++) TEST_ASSERT_TRUE(dlog("n=%d", i));
+    TEST_ASSERT_FALSE(dlog("lost %d", -1));
+    TEST_ASSERT_EQUAL_UINT32(1, dlog_dropped());
+    TEST_ASSERT_EQUAL_STRING("n=0", pop_line());
+    TEST_ASSERT_TRUE(dlog("n=%d", DLOG_CAPACITY));
+}
+
+// logbench khong dung toi ring that: record dang cho giu nguyen thu tu
+static void test_logbench_uses_private_ring(void) {
+    dlog("before %u", 1u);
+    cmd_logbench(1, NULL);
+    TEST_ASSERT_TRUE(Serial.output.find("cycles/call") != std::string::npos);
+    TEST_ASSERT_EQUAL_STRING("before 1", pop_line());
+    TEST_ASSERT_NULL(pop_line());
+    TEST_ASSERT_EQUAL_UINT32(0, dlog_dropped());
+}
+
+// Cung format -> cung ID, format khac -> ID khac; record khong giu con tro
+static void test_format_ids_are_stable(void) {
+    static const char a[] = "id a %d", b[] = "id b %d";
+    dlog(a, 1);
+    dlog(b, 2);
+    dlog(a, 3);
+    dlog_record_t r1, r2, r3;
+    TEST_ASSERT_TRUE(dlog_pop(&r1) && dlog_pop(&r2) && dlog_pop(&r3));
+    TEST_ASSERT_EQUAL_UINT16(r1.fmt_id, r3.fmt_id);
+    TEST_ASSERT_NOT_EQUAL(r1.fmt_id, r2.fmt_id);
+    TEST_ASSERT_EQUAL_PTR(a, dlog_fmt_text(r1.fmt_id));
+    TEST_ASSERT_NULL(dlog_fmt_text(dlog_fmt_count()));
+}
+
+// Dump nhu ngoai thiet bi: bang format dang text + record da encode, giai ma lai
+// khong dung toi bang format / ring trong RAM
+static void test_dump_decodes_off_target(void) {
+    dlog("Humidity: %.2f%%  Temperature: %.2f°C", 61.2f, 27.31f);
+    dlog("Rules rejected: %s (%s)", "bad token", "line 3");
+    dlog("relay %u -> %s, %d us", 2u, "ON", -7);
+    DeferredLogger::log("Connecting to broker");
+
+    std::vector<uint8_t> dump;
+    std::vector<std::string> expected;
+    dlog_record_t rec;
+    uint8_t wire[DLOG_WIRE_MAX];
+    while (dlog_pop(&rec)) {
+        dlog_format(&rec, line, sizeof(line));
+        expected.push_back(line);
+        size_t n = dlog_encode(&rec, wire, sizeof(wire));
+        TEST_ASSERT_TRUE(n > 0 && n <= DLOG_WIRE_MAX);
+        dump.insert(dump.end(), wire, wire + n);
+    }
+    std::vector<std::string> formats;
+    for (uint16_t id = 0; id < dlog_fmt_count(); id++) formats.push_back(dlog_fmt_text(id));
+
+    size_t pos = 0, i = 0;
+    while (pos < dump.size()) {
+        dlog_record_t out;
+        size_t n = dlog_decode(dump.data() + pos, dump.size() - pos, &out);
+        TEST_ASSERT_TRUE(n > 0);
+        TEST_ASSERT_TRUE(out.fmt_id < formats.size());
+        dlog_format(&out, formats[out.fmt_id].c_str(), line, sizeof(line));
+        TEST_ASSERT_EQUAL_STRING(expected[i].c_str(), line);
+        pos += n;
+        i++;
+    }
+    TEST_ASSERT_EQUAL(4, i);
+    TEST_ASSERT_EQUAL_STRING("relay 2 -> ON, -7 us", expected[2].c_str());
+
+    // dump bi cat / hong -> tu choi
+    TEST_ASSERT_EQUAL(0, dlog_decode(dump.data(), 6, &rec));
+    size_t first = dlog_decode(dump.data(), dump.size(), &rec);
+    TEST_ASSERT_EQUAL(0, dlog_decode(dump.data(), first - 1, &rec));
+    dump[6] = DLOG_MAX_ARGS + 1;
+    TEST_ASSERT_EQUAL(0, dlog_decode(dump.data(), dump.size(), &rec));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_format_types);
+    RUN_TEST(test_string_args_are_copied);
+    RUN_TEST(test_string_args_truncated);
+    RUN_TEST(test_full_ring_drops);
+    RUN_TEST(test_logbench_uses_private_ring);
+    RUN_TEST(test_format_ids_are_stable);
+    RUN_TEST(test_dump_decodes_off_target);
+    return UNITY_END();
+}
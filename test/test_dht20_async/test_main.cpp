@@ -0,0 +1,164 @@
+#include <unity.h>
+#include <Wire.h>
+#include <sim_i2c_devices.h>
+#include "DHT20.h"
+
+static sim::Dht20 model;
+static DHT20 *dht;
+static int callbacks;
+static int callbackStatus;
+
+static void on_done(DHT20 *sensor, int status, void *arg) {
+    callbacks++;
+    callbackStatus = status;
+    *(DHT20 **)arg = sensor;
+}
+
+// Goi poll() moi 1 ms thoi gian ao cho toi khi het PENDING
+static int poll_until_done(uint32_t *polls = NULL) {
+    int rv;
+    uint32_t n = 0;
+    while ((rv = dht->poll()) == DHT20_PENDING) {
+        sim::advance(1000);
+        n++;
+    }
+    if (polls) *polls = n;
+    return rv;
+}
+
+void setUp(void) {
+    sim::detachAll();
+    sim::now_us = 2000000;
+    sim::bus = sim::I2cBus();
+    model = sim::Dht20();
+    sim::attach(0x38, &model);
+    static DHT20 sensor(&Wire);
+    sensor = DHT20(&Wire);
+    dht = &sensor;
+    callbacks = 0;
+    callbackStatus = 99;
+    TEST_ASSERT_TRUE(dht->begin());
+}
+
+void tearDown(void) {}
+
+static void test_poll_without_start(void) {
+    TEST_ASSERT_EQUAL(DHT20_ERROR_NOT_STARTED, dht->poll());
+    TEST_ASSERT_FALSE(dht->isPending());
+}
+
+static void test_first_measurement_resets_uncalibrated(void) {
+    DHT20 *who = NULL;
+    dht->setCallback(on_done, &who);
+    TEST_ASSERT_EQUAL(DHT20_OK, dht->startMeasurement());
+    TEST_ASSERT_EQUAL(3, model.registerResets);
+    TEST_ASSERT_TRUE(dht->isPending());
+
+    TEST_ASSERT_EQUAL(DHT20_OK, poll_until_done());
+    TEST_ASSERT_TRUE(dht->isCalibratedCached());
+    TEST_ASSERT_EQUAL(1, callbacks);
+    TEST_ASSERT_EQUAL(DHT20_OK, callbackStatus);
+    TEST_ASSERT_EQUAL_PTR(dht, who);
+    TEST_ASSERT_EQUAL_INT16(3000, dht->getTemperatureCenti());
+    TEST_ASSERT_EQUAL_INT32(5000, dht->getHumidityCenti());
+}
+
+static void test_calibrated_sensor_is_not_reset(void) {
+    model.calibrated = true;
+    TEST_ASSERT_EQUAL(DHT20_OK, dht->startMeasurement());
+    TEST_ASSERT_EQUAL(DHT20_OK, poll_until_done());
+    TEST_ASSERT_EQUAL(0, model.registerResets);
+
+    // lan sau: 1 trigger + 1 doc, khong doc status rieng, khong cho tren bus
+    dht->resetStatistics();
+    sim::bus.resetCounters();
+    uint32_t polls;
+    TEST_ASSERT_EQUAL(DHT20_OK, dht->startMeasurement());
+    TEST_ASSERT_EQUAL(DHT20_OK, poll_until_done(&polls));
+    TEST_ASSERT_EQUAL(0, model.registerResets);
+    TEST_ASSERT_EQUAL_UINT32(2, dht->getTransactions());
+    TEST_ASSERT_EQUAL_UINT32(2, sim::bus.transactions);
+    TEST_ASSERT_EQUAL_UINT32(0, dht->getWaitMicros());
+    TEST_ASSERT_GREATER_OR_EQUAL(DHT20_CONVERSION_TIME - 1, polls);
+}
+
+static void test_busy_status_keeps_pending(void) {
+    model.calibrated = true;
+    model.conversionUs = 120000;
+    TEST_ASSERT_EQUAL(DHT20_OK, dht->startMeasurement());
+    sim::bus.resetCounters();
+
+    TEST_ASSERT_EQUAL(DHT20_OK, poll_until_done());
+    // doc o 80 ms roi moi DHT20_POLL_INTERVAL cho toi 120 ms: 80, 90, 100, 110, 120(+bus)
+    TEST_ASSERT_INT_WITHIN(1, 5, model.dataReads);
+    TEST_ASSERT_EQUAL_UINT32(model.dataReads, sim::bus.transactions);
+    TEST_ASSERT_TRUE(dht->isCalibratedCached());
+}
+
+static void test_timeout_clears_calibration(void) {
+    model.calibrated = true;
+    model.conversionUs = 1000000;
+    DHT20 *who = NULL;
+    dht->setCallback(on_done, &who);
+    uint32_t start = millis();
+    TEST_ASSERT_EQUAL(DHT20_OK, dht->startMeasurement());
+    TEST_ASSERT_EQUAL(DHT20_ERROR_READ_TIMEOUT, poll_until_done());
+    TEST_ASSERT_UINT32_WITHIN(DHT20_POLL_INTERVAL, DHT20_MEASURE_TIMEOUT, millis() - start);
+    TEST_ASSERT_FALSE(dht->isCalibratedCached());
+    TEST_ASSERT_EQUAL(DHT20_ERROR_READ_TIMEOUT, callbackStatus);
+
+    // sensor chua hieu chuan lai -> lan do sau chay reset
+    model.calibrated = false;
+    model.conversionUs = 80000;
+    sim::advance(1000000);
+    TEST_ASSERT_EQUAL(DHT20_OK, dht->startMeasurement());
+    TEST_ASSERT_EQUAL(3, model.registerResets);
+    TEST_ASSERT_EQUAL(DHT20_OK, poll_until_done());
+}
+
+static void test_crc_error(void) {
+    model.calibrated = true;
+    model.corruptCrc = true;
+    TEST_ASSERT_EQUAL(DHT20_OK, dht->startMeasurement());
+    TEST_ASSERT_EQUAL(DHT20_ERROR_CHECKSUM, poll_until_done());
+    TEST_ASSERT_FALSE(dht->isPending());
+    TEST_ASSERT_FALSE(dht->isCalibratedCached());
+
+    // loi -> lan sau kiem tra status truoc, sensor van bao da hieu chuan nen khong reset
+    model.corruptCrc = false;
+    TEST_ASSERT_EQUAL(DHT20_OK, dht->startMeasurement());
+    TEST_ASSERT_EQUAL(0, model.registerResets);
+    TEST_ASSERT_EQUAL(DHT20_OK, poll_until_done());
+    TEST_ASSERT_TRUE(dht->isCalibratedCached());
+}
+
+static void test_missing_sensor(void) {
+    sim::detachAll();
+    TEST_ASSERT_EQUAL(DHT20_ERROR_CONNECT, dht->startMeasurement());
+    TEST_ASSERT_FALSE(dht->isPending());
+}
+
+static void test_blocking_read_uses_async_path(void) {
+    model.calibrated = true;
+    dht->read();
+    sim::advance(1000000);
+    dht->resetStatistics();
+    sim::bus.resetCounters();
+    TEST_ASSERT_EQUAL(DHT20_OK, dht->read());
+    TEST_ASSERT_EQUAL_UINT32(2, sim::bus.transactions);
+    // 1 s gioi han doc cua read()
+    TEST_ASSERT_EQUAL(DHT20_ERROR_LASTREAD, dht->read());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_poll_without_start);
+    RUN_TEST(test_first_measurement_resets_uncalibrated);
+    RUN_TEST(test_calibrated_sensor_is_not_reset);
+    RUN_TEST(test_busy_status_keeps_pending);
+    RUN_TEST(test_timeout_clears_calibration);
+    RUN_TEST(test_crc_error);
+    RUN_TEST(test_missing_sensor);
+    RUN_TEST(test_blocking_read_uses_async_path);
+    return UNITY_END();
+}
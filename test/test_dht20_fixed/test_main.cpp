@@ -0,0 +1,143 @@
+#include <unity.h>
+#include <chrono>
+#include <random>
+#include <Wire.h>
+#include <sim_i2c_devices.h>
+#include "DHT20.h"
+
+// Tham chieu: so huu ti chinh xac, lam tron nua len, 64 bit
+static int32_t ref_humidity_centi(uint32_t raw) {
+    return (int32_t)(((uint64_t)raw * 10000 + (1u << 19)) >> 20);
+}
+
+static int32_t ref_temperature_centi(uint32_t raw) {
+    return (int32_t)(((uint64_t)raw * 20000 + (1u << 19)) >> 20) - 5000;
+}
+
+// Thuat toan bitwise cu cua thu vien
+static uint8_t ref_crc8(const uint8_t *p, uint8_t len) {
+    uint8_t crc = 0xFF;
+    while (len--) {
+        crc ^= *p++;
+        for (uint8_t i = 8; i; i--) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+void setUp(void) {
+    sim::detachAll();
+    sim::now_us = 2000000;
+    sim::bus = sim::I2cBus();
+}
+
+void tearDown(void) {}
+
+static void test_humidity_centi_exhaustive(void) {
+    for (uint32_t raw = 0; raw < (1u << 20); raw++) {
+        int32_t got = DHT20::humidityCenti(raw);
+        if (got != ref_humidity_centi(raw)) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "raw 0x%05X", (unsigned)raw);
+            TEST_ASSERT_EQUAL_INT32_MESSAGE(ref_humidity_centi(raw), got, msg);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT32(0, DHT20::humidityCenti(0));
+    TEST_ASSERT_EQUAL_INT32(10000, DHT20::humidityCenti(0xFFFFF));
+}
+
+static void test_temperature_centi_exhaustive(void) {
+    for (uint32_t raw = 0; raw < (1u << 20); raw++) {
+        int32_t got = DHT20::temperatureCenti(raw);
+        if (got != ref_temperature_centi(raw)) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "raw 0x%05X", (unsigned)raw);
+            TEST_ASSERT_EQUAL_INT32_MESSAGE(ref_temperature_centi(raw), got, msg);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT16(-5000, DHT20::temperatureCenti(0));
+    TEST_ASSERT_EQUAL_INT16(15000, DHT20::temperatureCenti(0xFFFFF));
+}
+
+// Duong float van khop duong so nguyen trong 1 LSB
+static void test_float_matches_centi(void) {
+    for (uint32_t raw = 0; raw < (1u << 20); raw += 7) {
+        float h = raw * 9.5367431640625e-5f;
+        float t = raw * 1.9073486328125e-4f - 50;
+        TEST_ASSERT_FLOAT_WITHIN(0.0101f, h, DHT20::humidityCenti(raw) * 0.01f);
+        TEST_ASSERT_FLOAT_WITHIN(0.0101f, t, DHT20::temperatureCenti(raw) * 0.01f);
+    }
+}
+
+static void test_crc_table_matches_bitwise(void) {
+    std::mt19937 rng(20);
+    uint8_t frame[7];
+    for (int i = 0; i < 4096; i++) {
+        for (uint8_t &b : frame) b = rng();
+        uint8_t len = 1 + i % 7;
+        TEST_ASSERT_EQUAL_HEX8(ref_crc8(frame, len), DHT20::crc8(frame, len));
+    }
+}
+
+// Khung do model sinh ra (CRC bitwise) qua driver: khong loi CRC, gia tri khop tham chieu
+static void test_driver_end_to_end(void) {
+    sim::Dht20 model;
+    model.calibrated = true;
+    sim::attach(0x38, &model);
+    DHT20 dht(&Wire);
+    TEST_ASSERT_TRUE(dht.begin());
+    dht.setTempOffset(-0.5f);
+
+    std::mt19937 rng(18);
+    for (int i = 0; i < 64; i++) {
+        model.rawHumidity = rng() & 0xFFFFF;
+        model.rawTemperature = rng() & 0xFFFFF;
+        sim::advance(1000000);
+        TEST_ASSERT_EQUAL(DHT20_OK, dht.read());
+        TEST_ASSERT_EQUAL_UINT32(model.rawHumidity, dht.getRawHumidity());
+        TEST_ASSERT_EQUAL_INT32(ref_humidity_centi(model.rawHumidity), dht.getHumidityCenti());
+        TEST_ASSERT_EQUAL_INT16(ref_temperature_centi(model.rawTemperature) - 50, dht.getTemperatureCenti());
+    }
+}
+
+template <typename F>
+static double ns_per_call(F fn, uint32_t n) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++) fn(i);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+// Microbenchmark tren host, chi in ket qua (so tuong doi, khong phai so tren ESP32-S3)
+static void test_bench(void) {
+    const uint32_t n = 1u << 20;
+    volatile uint32_t sink = 0;
+    uint8_t frame[6] = { 0x1C, 0x80, 0x00, 0x06, 0x66, 0x66 };
+    char msg[128];
+
+    double crcTable = ns_per_call([&](uint32_t i) { frame[5] = i; sink += DHT20::crc8(frame, 6); }, n);
+    double crcBits = ns_per_call([&](uint32_t i) { frame[5] = i; sink += ref_crc8(frame, 6); }, n);
+    snprintf(msg, sizeof(msg), "crc8 6 byte: table %.1f ns, bitwise %.1f ns", crcTable, crcBits);
+    TEST_MESSAGE(msg);
+
+    double centi = ns_per_call([&](uint32_t i) { sink += DHT20::temperatureCenti(i & 0xFFFFF); }, n);
+    double flt = ns_per_call([&](uint32_t i) {
+        volatile float t = (i & 0xFFFFF) * 1.9073486328125e-4f - 50;
+        sink += (uint32_t)t;
+    }, n);
+    snprintf(msg, sizeof(msg), "temperature: centi %.1f ns, float %.1f ns", centi, flt);
+    TEST_MESSAGE(msg);
+    (void)sink;
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_humidity_centi_exhaustive);
+    RUN_TEST(test_temperature_centi_exhaustive);
+    RUN_TEST(test_float_matches_centi);
+    RUN_TEST(test_crc_table_matches_bitwise);
+    RUN_TEST(test_driver_end_to_end);
+    RUN_TEST(test_bench);
+    return UNITY_END();
+}
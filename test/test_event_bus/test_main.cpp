@@ -0,0 +1,186 @@
+#include <unity.h>
+#include <chrono>
+#include "../../src/event_bus.cpp"
+
+bool console_register(const console_cmd_t *cmd) { return true; }
+void console_prompt() {}
+
+// Moi test dang ky subscriber rieng; bang subscriber chi append nen xoa tay giua cac test
+void setUp(void) {
+    subCount = 0;
+    for (int i = 0; i < EVT_TOPIC_COUNT; i++) {
+        published[i] = 0;
+        dropped[i] = 0;
+    }
+}
+
+void tearDown(void) {}
+
+// Chay truoc event_bus_init(): stateGroup con NULL
+static void test_wait_state_before_init(void) {
+    TEST_ASSERT_EQUAL(0, event_bus_state());
+    TEST_ASSERT_FALSE(event_bus_wait_state(EVT_STATE_NETWORK, 10));
+    TEST_ASSERT_TRUE(event_bus_init());
+    event_bus_publish(EVT_NETWORK_UP);
+    TEST_ASSERT_TRUE(event_bus_wait_state(EVT_STATE_NETWORK, 10));
+    event_bus_publish(EVT_NETWORK_DOWN);
+    TEST_ASSERT_FALSE(event_bus_wait_state(EVT_STATE_NETWORK, 10));
+}
+
+static void test_counters_and_drops(void) {
+    QueueHandle_t q = xQueueCreate(2, sizeof(event_msg_t));
+    sim_task_t task = {};
+    TEST_ASSERT_TRUE(event_bus_subscribe_queue(EVT_BIT(EVT_NEW_SAMPLE), q));
+    TEST_ASSERT_TRUE(event_bus_subscribe_task(EVT_BIT(EVT_NEW_SAMPLE) | EVT_BIT(EVT_RELAY_CHANGED), &task));
+
+    uint32_t before = 0;
+    uint32_t seq = 7;
+    event_bus_publish(EVT_NEW_SAMPLE, &seq, sizeof(seq));
+    event_bus_publish(EVT_NEW_SAMPLE, &seq, sizeof(seq));
+    BaseType_t woken = pdFALSE;
+    event_bus_publish_from_isr(EVT_NEW_SAMPLE, &seq, sizeof(seq), &woken);
+    TEST_ASSERT_EQUAL_UINT32(before + 3, published[EVT_NEW_SAMPLE]);
+    TEST_ASSERT_EQUAL_UINT32(1, dropped[EVT_NEW_SAMPLE]);
+    TEST_ASSERT_EQUAL_UINT32(0, dropped[EVT_RELAY_CHANGED]);
+
+    event_msg_t msg;
+    TEST_ASSERT_TRUE(xQueueReceive(q, &msg, 0));
+    TEST_ASSERT_EQUAL(EVT_NEW_SAMPLE, msg.topic);
+    TEST_ASSERT_EQUAL(sizeof(seq), msg.len);
+    TEST_ASSERT_EQUAL_HEX32(EVT_BIT(EVT_NEW_SAMPLE), task.notifyValue);
+    vQueueDelete(q);
+}
+
+// Nhieu subscriber cung topic: moi queue nhan ban sao payload rieng, task nhan bit, mask loc dung
+static void test_multiple_subscribers(void) {
+    QueueHandle_t q[3];
+    sim_task_t tasks[2] = {};
+    for (int i = 0; i < 3; i++) {
+        q[i] = xQueueCreate(4, sizeof(event_msg_t));
+        TEST_ASSERT_TRUE(event_bus_subscribe_queue(i == 2 ? EVT_BIT(EVT_RELAY_CHANGED) : EVT_ALL_TOPICS, q[i]));
+    }
+    TEST_ASSERT_TRUE(event_bus_subscribe_task(EVT_BIT(EVT_CONFIG_CHANGED), &tasks[0]));
+    TEST_ASSERT_TRUE(event_bus_subscribe_task(EVT_BIT(EVT_NEW_SAMPLE) | EVT_BIT(EVT_CONFIG_CHANGED), &tasks[1]));
+
+    uint32_t gen = 41, seq = 9;
+    event_bus_publish(EVT_CONFIG_CHANGED, &gen, sizeof(gen));
+    gen = 42;   // publisher doi buffer ngay sau khi publish: subscriber van thay 41
+    event_bus_publish(EVT_NEW_SAMPLE, &seq, sizeof(seq));
+
+    for (int i = 0; i < 2; i++) {
+        event_msg_t msg;
+        uint32_t v;
+        TEST_ASSERT_EQUAL(2, uxQueueMessagesWaiting(q[i]));
+        TEST_ASSERT_TRUE(xQueueReceive(q[i], &msg, 0));
+        TEST_ASSERT_EQUAL(EVT_CONFIG_CHANGED, msg.topic);
+        memcpy(&v, msg.data, sizeof(v));
+        TEST_ASSERT_EQUAL_UINT32(41, v);
+        TEST_ASSERT_TRUE(xQueueReceive(q[i], &msg, 0));
+        TEST_ASSERT_EQUAL(EVT_NEW_SAMPLE, msg.topic);
+    }
+    TEST_ASSERT_EQUAL(0, uxQueueMessagesWaiting(q[2]));
+    TEST_ASSERT_EQUAL_HEX32(EVT_BIT(EVT_CONFIG_CHANGED), tasks[0].notifyValue);
+    TEST_ASSERT_EQUAL_HEX32(EVT_BIT(EVT_CONFIG_CHANGED) | EVT_BIT(EVT_NEW_SAMPLE), tasks[1].notifyValue);
+    TEST_ASSERT_EQUAL_UINT32(0, dropped[EVT_CONFIG_CHANGED]);
+
+    // het cho dang ky
+    sim_task_t extra[EVENT_MAX_SUBSCRIBERS] = {};
+    int added = 0;
+    while (event_bus_subscribe_task(EVT_BIT(EVT_OTA_STARTED), &extra[added])) added++;
+    TEST_ASSERT_EQUAL(EVENT_MAX_SUBSCRIBERS - 5, added);
+    for (int i = 0; i < 3; i++) vQueueDelete(q[i]);
+}
+
+// Producer khong bao gio block: queue day thi bo message (dem dropped), khong cho,
+// va subscriber phia sau van nhan duoc
+static void test_full_queue_never_blocks(void) {
+    QueueHandle_t slow = xQueueCreate(1, sizeof(event_msg_t));
+    QueueHandle_t fast = xQueueCreate(8, sizeof(event_msg_t));
+    sim_task_t task = {};
+    TEST_ASSERT_TRUE(event_bus_subscribe_queue(EVT_BIT(EVT_NEW_SAMPLE), slow));
+    TEST_ASSERT_TRUE(event_bus_subscribe_queue(EVT_BIT(EVT_NEW_SAMPLE), fast));
+    TEST_ASSERT_TRUE(event_bus_subscribe_task(EVT_BIT(EVT_NEW_SAMPLE), &task));
+
+    // fake xQueueSend cong dong ho ao khi phai cho: dong ho dung yen = khong block
+    sim::now_us = 1000;
+    for (uint32_t seq = 0; seq < 5; seq++) {
+        event_bus_publish(EVT_NEW_SAMPLE, &seq, sizeof(seq));
+    }
+    BaseType_t woken = pdFALSE;
+    uint32_t seq = 5;
+    event_bus_publish_from_isr(EVT_NEW_SAMPLE, &seq, sizeof(seq), &woken);
+    TEST_ASSERT_EQUAL_UINT32(1000, sim::now_us);
+
+    TEST_ASSERT_EQUAL_UINT32(6, published[EVT_NEW_SAMPLE]);
+    TEST_ASSERT_EQUAL_UINT32(5, dropped[EVT_NEW_SAMPLE]);
+    TEST_ASSERT_EQUAL(1, uxQueueMessagesWaiting(slow));
+    TEST_ASSERT_EQUAL(6, uxQueueMessagesWaiting(fast));
+    TEST_ASSERT_TRUE(task.notifyPending);
+
+    // message giu lai o queue cham la message dau tien, khong bi ghi de
+    event_msg_t msg;
+    uint32_t v;
+    xQueueReceive(slow, &msg, 0);
+    memcpy(&v, msg.data, sizeof(v));
+    TEST_ASSERT_EQUAL_UINT32(0, v);
+    vQueueDelete(slow);
+    vQueueDelete(fast);
+}
+
+template <typename F>
+static double ns_per_call(F fn, uint32_t n) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++) fn(i);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+// Microbenchmark tren host, mot thread, chi in ket qua: chi phi publish + lay ra theo so subscriber.
+// Queue gia cap phat heap moi message nen cot queue la can tren; so tuong doi, khong phai so tren ESP32-S3.
+// Khong do do tre danh thuc giua cac task (fake khong co scheduler/thread that).
+static void test_bench(void) {
+    const uint32_t n = 1u << 18;
+    static sim_task_t tasks[4];
+    QueueHandle_t q[4];
+    volatile uint32_t sink = 0;
+    char msg[160];
+
+    double none = ns_per_call([&](uint32_t i) { event_bus_publish(EVT_NEW_SAMPLE, &i, sizeof(i)); }, n);
+
+    for (int i = 0; i < 4; i++) event_bus_subscribe_task(EVT_BIT(EVT_NEW_SAMPLE), &tasks[i]);
+    double notify = ns_per_call([&](uint32_t i) {
+        event_bus_publish(EVT_NEW_SAMPLE, &i, sizeof(i));
+        sink += tasks[3].notifyValue;
+        tasks[3].notifyValue = 0;
+    }, n);
+
+    for (int i = 0; i < 4; i++) {
+        q[i] = xQueueCreate(4, sizeof(event_msg_t));
+        event_bus_subscribe_queue(EVT_BIT(EVT_NEW_SAMPLE), q[i]);
+    }
+    double queued = ns_per_call([&](uint32_t i) {
+        event_msg_t m;
+        event_bus_publish(EVT_NEW_SAMPLE, &i, sizeof(i));
+        for (int k = 0; k < 4; k++) {
+            xQueueReceive(q[k], &m, 0);
+            sink += m.len;
+        }
+    }, n);
+
+    snprintf(msg, sizeof(msg), "publish+dispatch: 0 subs %.1f ns, 4 notify %.1f ns, 4 notify + 4 queue %.1f ns",
+             none, notify, queued);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_UINT32(0, dropped[EVT_NEW_SAMPLE]);
+    for (int i = 0; i < 4; i++) vQueueDelete(q[i]);
+    (void)sink;
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_wait_state_before_init);
+    RUN_TEST(test_counters_and_drops);
+    RUN_TEST(test_multiple_subscribers);
+    RUN_TEST(test_full_queue_never_blocks);
+    RUN_TEST(test_bench);
+    return UNITY_END();
+}
@@ -0,0 +1,135 @@
+#include <unity.h>
+#include <Wire.h>
+#include <sim_i2c_devices.h>
+#include "LiquidCrystal_I2C.h"
+
+#define LCD_ADDR    0x27
+#define DHT20_ADDR  0x38
+
+void setUp(void) {
+    sim::detachAll();
+    sim::now_us = 0;
+    sim::bus = sim::I2cBus();
+}
+
+void tearDown(void) {}
+
+static void test_virtual_clock(void) {
+    delay(5);
+    delayMicroseconds(250);
+    TEST_ASSERT_EQUAL_UINT32(5250, micros());
+    TEST_ASSERT_EQUAL_UINT32(5, millis());
+}
+
+static void test_bus_timing_and_counters(void) {
+    sim::Hd44780 lcd;
+    sim::attach(LCD_ADDR, &lcd);
+    uint8_t buf[10] = {};
+
+    // 100 kHz: (2 + 9 + 9*10) bit = 101 bit = 1010 us
+    Wire.beginTransmission(LCD_ADDR);
+    Wire.write(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_UINT8(0, Wire.endTransmission());
+    TEST_ASSERT_EQUAL_UINT32(1010, micros());
+
+    Wire.setClock(400000);
+    sim::bus.overheadUs = 40;
+    Wire.beginTransmission(LCD_ADDR);
+    Wire.write(buf, sizeof(buf));
+    Wire.endTransmission();
+    TEST_ASSERT_EQUAL_UINT32(1010 + 253 + 40, micros());
+
+    TEST_ASSERT_EQUAL_UINT32(2, sim::bus.transactions);
+    TEST_ASSERT_EQUAL_UINT32(20, sim::bus.bytes);
+    TEST_ASSERT_EQUAL_UINT32(1010 + 293, sim::bus.busyUs);
+}
+
+static void test_missing_device_nacks(void) {
+    Wire.beginTransmission(0x10);
+    Wire.write(0);
+    TEST_ASSERT_EQUAL_UINT8(2, Wire.endTransmission());
+    TEST_ASSERT_EQUAL_UINT8(0, Wire.requestFrom((uint8_t)0x10, (uint8_t)3));
+}
+
+static void test_write_buffer_limit(void) {
+    sim::Hd44780 lcd;
+    sim::attach(LCD_ADDR, &lcd);
+    uint8_t buf[I2C_BUFFER_LENGTH + 8] = {};
+    Wire.beginTransmission(LCD_ADDR);
+    TEST_ASSERT_EQUAL(I2C_BUFFER_LENGTH, Wire.write(buf, sizeof(buf)));
+    Wire.endTransmission();
+    TEST_ASSERT_EQUAL_UINT32(I2C_BUFFER_LENGTH, sim::bus.bytes);
+}
+
+static void test_dht20_model_conversion(void) {
+    sim::Dht20 dht;
+    dht.calibrated = true;
+    sim::attach(DHT20_ADDR, &dht);
+
+    const uint8_t trigger[] = { 0xAC, 0x33, 0x00 };
+    Wire.beginTransmission(DHT20_ADDR);
+    Wire.write(trigger, sizeof(trigger));
+    TEST_ASSERT_EQUAL_UINT8(0, Wire.endTransmission());
+
+    TEST_ASSERT_EQUAL_UINT8(7, Wire.requestFrom((uint8_t)DHT20_ADDR, (uint8_t)7));
+    TEST_ASSERT_EQUAL_HEX8(0x98, Wire.read());      // dang do
+    while (Wire.available()) Wire.read();
+
+    sim::advance(dht.conversionUs);
+    uint8_t frame[7];
+    Wire.requestFrom((uint8_t)DHT20_ADDR, (uint8_t)7);
+    for (int i = 0; i < 7; i++) frame[i] = Wire.read();
+    TEST_ASSERT_EQUAL_HEX8(0x18, frame[0]);
+    TEST_ASSERT_EQUAL_HEX8(sim::Dht20::crc8(frame, 6), frame[6]);
+    uint32_t hum = ((uint32_t)frame[1] << 12) | ((uint32_t)frame[2] << 4) | (frame[3] >> 4);
+    uint32_t temp = ((uint32_t)(frame[3] & 0x0F) << 16) | ((uint32_t)frame[4] << 8) | frame[5];
+    TEST_ASSERT_EQUAL_HEX32(dht.rawHumidity, hum);
+    TEST_ASSERT_EQUAL_HEX32(dht.rawTemperature, temp);
+    TEST_ASSERT_EQUAL(1, dht.triggers);
+}
+
+static void test_lcd_model_decodes_driver(void) {
+    sim::Hd44780 model;
+    sim::attach(LCD_ADDR, &model);
+    LiquidCrystal_I2C lcd(LCD_ADDR, 16, 2);
+    lcd.begin();
+    lcd.setCursor(0, 0);
+    lcd.print("Temp 25.31 C");
+    lcd.setCursor(3, 1);
+    lcd.print("Humi 61%");
+
+    TEST_ASSERT_EQUAL_STRING("Temp 25.31 C    ", model.row(0).c_str());
+    TEST_ASSERT_EQUAL_STRING("   Humi 61%     ", model.row(1).c_str());
+    TEST_ASSERT_FALSE(model.eightBit);
+    TEST_ASSERT_TRUE(model.backlight());
+    TEST_ASSERT_EQUAL(0, model.violations);
+    // moi giao dich driver dem deu toi duoc bus
+    TEST_ASSERT_EQUAL_UINT32(sim::bus.transactions, lcd.getTransactions());
+}
+
+static void test_lcd_counts_waits(void) {
+    sim::Hd44780 model;
+    sim::attach(LCD_ADDR, &model);
+    LiquidCrystal_I2C lcd(LCD_ADDR, 16, 2);
+    lcd.begin();
+    lcd.resetStatistics();
+    sim::bus.resetCounters();
+
+    lcd.clear();
+    TEST_ASSERT_EQUAL_UINT32(2000, lcd.getWaitMicros());
+    TEST_ASSERT_EQUAL_UINT32(1, lcd.getTransactions());
+    TEST_ASSERT_EQUAL_UINT32(1, sim::bus.transactions);
+    TEST_ASSERT_EQUAL(' ', model.at(0, 0));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_virtual_clock);
+    RUN_TEST(test_bus_timing_and_counters);
+    RUN_TEST(test_missing_device_nacks);
+    RUN_TEST(test_write_buffer_limit);
+    RUN_TEST(test_dht20_model_conversion);
+    RUN_TEST(test_lcd_model_decodes_driver);
+    RUN_TEST(test_lcd_counts_waits);
+    return UNITY_END();
+}
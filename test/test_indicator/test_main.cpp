@@ -0,0 +1,169 @@
+#include <unity.h>
+#include "../../src/indicator.cpp"
+
+static indicator_state_t st;
+
+static void reset_state(const indicator_pattern_t &base) {
+    memset(&st, 0, sizeof(st));
+    st.base = base;
+    st.lastLevel = -1;
+}
+
+void setUp(void) {
+    sim::now_us = 0;
+    reset_state(indicator_solid(0, 0, 0));
+    st.base.mode = IND_OFF;
+}
+
+void tearDown(void) {}
+
+// Nen solid: ve 1 lan roi dung yen, khong hen khung
+static void test_solid_base_draws_once(void) {
+    indicator_pattern_t red = indicator_solid(255, 0, 0);
+    const indicator_pattern_t *p;
+    uint8_t level;
+    uint32_t next;
+
+    indicator_state_apply(&st, &red, false, 10);
+    TEST_ASSERT_EQUAL_UINT32(10, st.startMs);
+    TEST_ASSERT_TRUE(indicator_step(&st, 10, &p, &level, &next));
+    TEST_ASSERT_EQUAL_PTR(&st.base, p);
+    TEST_ASSERT_EQUAL_UINT8(255, level);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, next);
+    TEST_ASSERT_FALSE(indicator_step(&st, 5000, &p, &level, &next));
+}
+
+// Overlay blink chay tren nen, het thi quay ve nen va tinh lai thoi gian tu luc het
+static void test_overlay_returns_to_base(void) {
+    indicator_pattern_t green = indicator_solid(0, 255, 0);
+    indicator_pattern_t blink = indicator_blink(255, 0, 0, 100, 100, 2);
+    const indicator_pattern_t *p;
+    uint8_t level;
+    uint32_t next;
+
+    indicator_state_apply(&st, &green, false, 0);
+    indicator_step(&st, 0, &p, &level, &next);
+    indicator_state_apply(&st, &blink, true, 1000);
+    TEST_ASSERT_TRUE(st.overlayActive);
+    TEST_ASSERT_EQUAL_INT16(-1, st.lastLevel);
+
+    TEST_ASSERT_TRUE(indicator_step(&st, 1000, &p, &level, &next));
+    TEST_ASSERT_EQUAL_PTR(&st.overlay, p);
+    TEST_ASSERT_EQUAL_UINT8(255, level);
+    TEST_ASSERT_EQUAL_UINT32(100, next);
+
+    TEST_ASSERT_TRUE(indicator_step(&st, 1100, &p, &level, &next));
+    TEST_ASSERT_EQUAL_UINT8(0, level);
+    TEST_ASSERT_EQUAL_UINT32(100, next);
+
+    // thuc day som giua nua tat: khong can ghi LED, hen phan con lai
+    TEST_ASSERT_FALSE(indicator_step(&st, 1150, &p, &level, &next));
+    TEST_ASSERT_EQUAL_UINT32(50, next);
+
+    indicator_step(&st, 1200, &p, &level, &next);
+    indicator_step(&st, 1300, &p, &level, &next);
+    TEST_ASSERT_TRUE(st.overlayActive);
+
+    TEST_ASSERT_TRUE(indicator_step(&st, 1400, &p, &level, &next));
+    TEST_ASSERT_FALSE(st.overlayActive);
+    TEST_ASSERT_EQUAL_PTR(&st.base, p);
+    TEST_ASSERT_EQUAL_UINT32(1400, st.startMs);
+    TEST_ASSERT_EQUAL_UINT8(255, level);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, next);
+}
+
+// Doi nen trong luc overlay chay: khong cat overlay, nen moi hien khi overlay xong
+static void test_base_waits_for_overlay(void) {
+    indicator_pattern_t blink = indicator_blink(255, 0, 0, 100, 100, 1);
+    indicator_pattern_t blue = indicator_solid(0, 0, 255);
+    const indicator_pattern_t *p;
+    uint8_t level;
+    uint32_t next;
+
+    indicator_state_apply(&st, &blink, true, 0);
+    indicator_step(&st, 0, &p, &level, &next);
+    indicator_state_apply(&st, &blue, false, 50);
+    TEST_ASSERT_EQUAL_UINT32(0, st.startMs);
+    TEST_ASSERT_EQUAL_INT16(255, st.lastLevel);
+
+    TEST_ASSERT_TRUE(indicator_step(&st, 100, &p, &level, &next));
+    TEST_ASSERT_EQUAL_PTR(&st.overlay, p);
+    TEST_ASSERT_EQUAL_UINT8(0, level);
+
+    TEST_ASSERT_TRUE(indicator_step(&st, 200, &p, &level, &next));
+    TEST_ASSERT_EQUAL_PTR(&st.base, p);
+    TEST_ASSERT_EQUAL_UINT8(255, p->b);
+    TEST_ASSERT_EQUAL_UINT8(255, level);
+}
+
+// Overlay moi de len overlay cu: dem lai tu dau va luon ve lai du level khong doi
+static void test_new_overlay_restarts(void) {
+    indicator_pattern_t blink = indicator_blink(255, 0, 0, 100, 100, 3);
+    const indicator_pattern_t *p;
+    uint8_t level;
+    uint32_t next;
+
+    indicator_state_apply(&st, &blink, true, 0);
+    TEST_ASSERT_TRUE(indicator_step(&st, 30, &p, &level, &next));
+    TEST_ASSERT_EQUAL_UINT32(70, next);
+
+    indicator_state_apply(&st, &blink, true, 30);
+    TEST_ASSERT_EQUAL_UINT32(30, st.startMs);
+    TEST_ASSERT_TRUE(indicator_step(&st, 30, &p, &level, &next));
+    TEST_ASSERT_EQUAL_UINT8(255, level);
+    TEST_ASSERT_EQUAL_UINT32(100, next);
+}
+
+// Breathe luon hen khung INDICATOR_FRAME_MS; chi ghi LED khi level thuc su doi
+static void test_breathe_schedules_frames(void) {
+    indicator_pattern_t breathe = { IND_BREATHE, 0, 255, 0, 1000, 0, 0 };
+    const indicator_pattern_t *p;
+    uint8_t level;
+    uint32_t next;
+
+    indicator_state_apply(&st, &breathe, false, 0);
+    TEST_ASSERT_TRUE(indicator_step(&st, 500, &p, &level, &next));
+    TEST_ASSERT_EQUAL_UINT8(127, level);
+    TEST_ASSERT_EQUAL_UINT32(INDICATOR_FRAME_MS, next);
+    TEST_ASSERT_FALSE(indicator_step(&st, 501, &p, &level, &next));
+    TEST_ASSERT_EQUAL_UINT32(INDICATOR_FRAME_MS, next);
+    TEST_ASSERT_TRUE(indicator_step(&st, 1000, &p, &level, &next));
+    TEST_ASSERT_EQUAL_UINT8(255, level);
+}
+
+// Qua timer that: LED ra dung theo thoi gian, overlay xong thi timer ngu han
+static void test_render_through_timer(void) {
+    TEST_ASSERT_TRUE(indicator_init());
+    indicator_pattern_t blue = indicator_solid(0, 0, 255);
+    indicator_pattern_t blink = indicator_blink(255, 255, 255, 100, 100, 2);
+    TEST_ASSERT_TRUE(indicator_set(IND_CH_PIXEL, &blue));
+    TEST_ASSERT_TRUE(indicator_play(IND_CH_D13, &blink));
+
+    sim::run_timers_until(50);
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, strip.shown);
+    TEST_ASSERT_EQUAL_UINT32(1, sim::gpioLevel[INDICATOR_D13_PIN]);
+    TEST_ASSERT_TRUE(xTimerIsTimerActive(frameTimer));
+
+    sim::run_timers_until(150);
+    TEST_ASSERT_EQUAL_UINT32(0, sim::gpioLevel[INDICATOR_D13_PIN]);
+    sim::run_timers_until(250);
+    TEST_ASSERT_EQUAL_UINT32(1, sim::gpioLevel[INDICATOR_D13_PIN]);
+
+    uint32_t shows = strip.shows;
+    sim::run_timers_until(1000);
+    TEST_ASSERT_EQUAL_UINT32(0, sim::gpioLevel[INDICATOR_D13_PIN]);
+    TEST_ASSERT_FALSE(xTimerIsTimerActive(frameTimer));
+    // NeoPixel solid khong bi ve lai moi khung cua D13
+    TEST_ASSERT_EQUAL_UINT32(shows, strip.shows);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_solid_base_draws_once);
+    RUN_TEST(test_overlay_returns_to_base);
+    RUN_TEST(test_base_waits_for_overlay);
+    RUN_TEST(test_new_overlay_restarts);
+    RUN_TEST(test_breathe_schedules_frames);
+    RUN_TEST(test_render_through_timer);
+    return UNITY_END();
+}
@@ -0,0 +1,146 @@
+#include <unity.h>
+#include <Wire.h>
+#include <sim_i2c_devices.h>
+#include "LiquidCrystal_I2C.h"
+
+#define LCD_ADDR    0x27
+// queueNibble: data, data|En, data; 2 nibble moi byte LCD
+#define BYTES_PER_CHAR  6
+
+static sim::Hd44780 model(20);
+static LiquidCrystal_I2C *lcd;
+
+static void start(uint32_t clock) {
+    Wire.setClock(clock);
+    lcd->begin();
+    lcd->resetStatistics();
+    sim::bus.resetCounters();
+}
+
+void setUp(void) {
+    sim::detachAll();
+    sim::now_us = 0;
+    sim::bus = sim::I2cBus();
+    model = sim::Hd44780(20);
+    sim::attach(LCD_ADDR, &model);
+    lcd = new LiquidCrystal_I2C(LCD_ADDR, 20, 4);
+}
+
+void tearDown(void) {
+    delete lcd;
+    Wire.setClock(100000);
+}
+
+static void test_one_transaction_per_buffer(void) {
+    start(400000);
+    TEST_ASSERT_TRUE(lcd->getBatching());
+    const uint8_t perTx = I2C_BUFFER_LENGTH / BYTES_PER_CHAR;
+    char text[48];
+    memset(text, 'x', sizeof(text));
+
+    // vua du mot Wire buffer
+    lcd->write((const uint8_t *)text, perTx);
+    TEST_ASSERT_EQUAL_UINT32(1, lcd->getTransactions());
+    TEST_ASSERT_EQUAL_UINT32(perTx * BYTES_PER_CHAR, sim::bus.bytes);
+
+    // them 1 ky tu -> tran sang giao dich thu hai
+    lcd->resetStatistics();
+    sim::bus.resetCounters();
+    lcd->write((const uint8_t *)text, perTx + 1);
+    TEST_ASSERT_EQUAL_UINT32(2, lcd->getTransactions());
+    TEST_ASSERT_EQUAL_UINT32(2, sim::bus.transactions);
+    TEST_ASSERT_EQUAL_UINT32((perTx + 1) * BYTES_PER_CHAR, sim::bus.bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, lcd->getWaitMicros());
+    TEST_ASSERT_EQUAL(0, model.violations);
+}
+
+static void test_write_at_carries_cursor(void) {
+    start(400000);
+    // setCursor di cung giao dich voi du lieu
+    lcd->writeAt(3, 2, (const uint8_t *)"Humi", 4);
+    TEST_ASSERT_EQUAL_UINT32(1, lcd->getTransactions());
+    TEST_ASSERT_EQUAL_UINT32((1 + 4) * BYTES_PER_CHAR, sim::bus.bytes);
+    TEST_ASSERT_EQUAL_STRING("   Humi             ", model.row(2).c_str());
+
+    // lenh chiem cho cua mot ky tu
+    lcd->resetStatistics();
+    const uint8_t perTx = I2C_BUFFER_LENGTH / BYTES_PER_CHAR;
+    char text[20];
+    memset(text, 'y', sizeof(text));
+    lcd->writeAt(0, 3, (const uint8_t *)text, perTx);
+    TEST_ASSERT_EQUAL_UINT32(2, lcd->getTransactions());
+    TEST_ASSERT_EQUAL('y', model.at(19, 3));
+    TEST_ASSERT_EQUAL(0, model.violations);
+}
+
+static void test_command_and_char(void) {
+    start(400000);
+    lcd->display();
+    TEST_ASSERT_EQUAL_UINT32(1, lcd->getTransactions());
+    TEST_ASSERT_EQUAL_UINT32(BYTES_PER_CHAR, sim::bus.bytes);
+
+    uint8_t glyph[8] = { 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00, 0x1F, 0x00 };
+    lcd->resetStatistics();
+    lcd->createChar(2, glyph);
+    TEST_ASSERT_EQUAL_UINT32(1, lcd->getTransactions());
+    TEST_ASSERT_EQUAL_MEMORY(glyph, &model.cgram[2 * 8], 8);
+    TEST_ASSERT_EQUAL(0, model.violations);
+}
+
+// Batched va tung byte ra cung noi dung, batched it giao dich hon nhieu
+static void test_batched_vs_unbatched(void) {
+    start(100000);
+    lcd->setCursor(0, 1);
+    lcd->print("batched 21.5C");
+    uint32_t batched = lcd->getTransactions();
+    std::string row = model.row(1);
+
+    lcd->setBatching(false);
+    lcd->resetStatistics();
+    lcd->clear();
+    lcd->resetStatistics();
+    lcd->setCursor(0, 1);
+    lcd->print("batched 21.5C");
+    uint32_t single = lcd->getTransactions();
+
+    TEST_ASSERT_EQUAL_STRING(row.c_str(), model.row(1).c_str());
+    // setCursor + ca chuoi trong 1 giao dich
+    TEST_ASSERT_EQUAL_UINT32(1 + 1, batched);
+    TEST_ASSERT_EQUAL_UINT32((1 + 13) * 2 * 3, single);
+    TEST_ASSERT_EQUAL(0, model.violations);
+}
+
+static void test_fast_clock_disables_batching(void) {
+    start(1000000);
+    TEST_ASSERT_FALSE(lcd->getBatching());
+    lcd->setBatching(true);
+    TEST_ASSERT_FALSE(lcd->getBatching());
+    lcd->print("fast");
+    TEST_ASSERT_EQUAL_STRING("fast                ", model.row(0).c_str());
+    TEST_ASSERT_EQUAL(0, model.violations);
+
+    // ha clock -> bat lai duoc
+    Wire.setClock(LCD_BATCH_MAX_CLOCK);
+    lcd->setBatching(true);
+    TEST_ASSERT_TRUE(lcd->getBatching());
+}
+
+// Ly do cua gioi han: 1 MHz batched thi EN len khi controller con ban
+static void test_batching_above_limit_violates_timing(void) {
+    start(400000);
+    Wire.setClock(1000000);     // sau begin(), khong bi phat hien
+    TEST_ASSERT_TRUE(lcd->getBatching());
+    lcd->print("xy");
+    TEST_ASSERT_GREATER_THAN(0, model.violations);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_one_transaction_per_buffer);
+    RUN_TEST(test_write_at_carries_cursor);
+    RUN_TEST(test_command_and_char);
+    RUN_TEST(test_batched_vs_unbatched);
+    RUN_TEST(test_fast_clock_disables_batching);
+    RUN_TEST(test_batching_above_limit_violates_timing);
+    return UNITY_END();
+}
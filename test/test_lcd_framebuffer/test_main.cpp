@@ -0,0 +1,159 @@
+#include <unity.h>
+#include <Wire.h>
+#include <sim_i2c_devices.h>
+#include "LCD_Framebuffer.h"
+
+#define LCD_ADDR 0x27
+
+static sim::Hd44780 model;
+static LiquidCrystal_I2C *lcd;
+static LCD_Framebuffer *fb;
+
+// Man hinh mau: nhan tinh + so, giong lcd_display
+static void draw(const char *temp, const char *humi) {
+    fb->setCursor(0, 0);
+    fb->printf("Temp %s C", temp);
+    fb->setCursor(0, 1);
+    fb->printf("Humi %s %%", humi);
+}
+
+void setUp(void) {
+    sim::detachAll();
+    sim::now_us = 0;
+    sim::bus = sim::I2cBus();
+    model = sim::Hd44780();
+    sim::attach(LCD_ADDR, &model);
+    lcd = new LiquidCrystal_I2C(LCD_ADDR, 16, 2);
+    lcd->begin();
+    fb = new LCD_Framebuffer(*lcd, 16, 2);
+    sim::bus.resetCounters();
+}
+
+void tearDown(void) {
+    delete fb;
+    delete lcd;
+}
+
+static void test_nothing_sent_before_flush(void) {
+    draw("25.31", "61");
+    TEST_ASSERT_EQUAL_UINT32(0, sim::bus.transactions);
+    TEST_ASSERT_EQUAL('2', fb->charAt(5, 0));
+    TEST_ASSERT_EQUAL_STRING("                ", model.row(0).c_str());
+}
+
+static void test_first_frame_cost(void) {
+    draw("25.31", "61");
+    fb->flush();
+    // "Temp 25.31 C" va "Humi 61 %": cac khoang trang don le nam trong run, moi dong 1 run
+    TEST_ASSERT_EQUAL_UINT16(12 + 9, fb->lastFlushCells());
+    TEST_ASSERT_EQUAL_UINT16(2, fb->lastFlushCursorMoves());
+    TEST_ASSERT_EQUAL_UINT32(2, fb->lastFlushTransactions());
+    TEST_ASSERT_EQUAL_UINT32(2, sim::bus.transactions);
+    TEST_ASSERT_EQUAL_STRING("Temp 25.31 C    ", model.row(0).c_str());
+    TEST_ASSERT_EQUAL_STRING("Humi 61 %       ", model.row(1).c_str());
+    TEST_ASSERT_EQUAL(0, model.violations);
+}
+
+static void test_unchanged_frame_is_free(void) {
+    draw("25.31", "61");
+    fb->flush();
+    sim::bus.resetCounters();
+    fb->clear();
+    draw("25.31", "61");
+    fb->flush();
+    TEST_ASSERT_EQUAL_UINT16(0, fb->lastFlushCells());
+    TEST_ASSERT_EQUAL_UINT32(0, fb->lastFlushTransactions());
+    TEST_ASSERT_EQUAL_UINT32(0, sim::bus.transactions);
+}
+
+static void test_single_digit_change(void) {
+    draw("25.31", "61");
+    fb->flush();
+    draw("25.32", "61");
+    fb->flush();
+    TEST_ASSERT_EQUAL_UINT16(1, fb->lastFlushCells());
+    TEST_ASSERT_EQUAL_UINT16(1, fb->lastFlushCursorMoves());
+    TEST_ASSERT_EQUAL_UINT32(1, fb->lastFlushTransactions());
+    TEST_ASSERT_EQUAL_STRING("Temp 25.32 C    ", model.row(0).c_str());
+    TEST_ASSERT_EQUAL(0, model.violations);
+}
+
+static void test_gap_merge(void) {
+    fb->flush();
+    // khoang trong = LCD_FB_MERGE_GAP -> ghi de o giua, 1 setCursor
+    fb->setCursor(2, 0);
+    fb->write('a');
+    fb->setCursor(3 + LCD_FB_MERGE_GAP, 0);
+    fb->write('b');
+    fb->flush();
+    TEST_ASSERT_EQUAL_UINT16(LCD_FB_MERGE_GAP + 2, fb->lastFlushCells());
+    TEST_ASSERT_EQUAL_UINT16(1, fb->lastFlushCursorMoves());
+
+    // khoang trong lon hon -> 2 run rieng
+    fb->setCursor(2, 1);
+    fb->write('c');
+    fb->setCursor(4 + LCD_FB_MERGE_GAP, 1);
+    fb->write('d');
+    fb->flush();
+    TEST_ASSERT_EQUAL_UINT16(2, fb->lastFlushCells());
+    TEST_ASSERT_EQUAL_UINT16(2, fb->lastFlushCursorMoves());
+    TEST_ASSERT_EQUAL_UINT32(2, fb->lastFlushTransactions());
+
+    TEST_ASSERT_EQUAL('a', model.at(2, 0));
+    TEST_ASSERT_EQUAL('b', model.at(3 + LCD_FB_MERGE_GAP, 0));
+    TEST_ASSERT_EQUAL('c', model.at(2, 1));
+    TEST_ASSERT_EQUAL('d', model.at(4 + LCD_FB_MERGE_GAP, 1));
+    TEST_ASSERT_EQUAL(0, model.violations);
+}
+
+static void test_invalidate_redraws_everything(void) {
+    draw("25.31", "61");
+    fb->flush();
+    // ai do xoa man hinh truc tiep
+    lcd->clear();
+    TEST_ASSERT_EQUAL_STRING("                ", model.row(0).c_str());
+
+    fb->invalidate();
+    fb->flush();
+    TEST_ASSERT_EQUAL_UINT16(2 * 16, fb->lastFlushCells());
+    TEST_ASSERT_EQUAL_UINT16(2, fb->lastFlushCursorMoves());
+    TEST_ASSERT_EQUAL_UINT32(2, fb->lastFlushTransactions());
+    TEST_ASSERT_EQUAL_STRING("Temp 25.31 C    ", model.row(0).c_str());
+    TEST_ASSERT_EQUAL_STRING("Humi 61 %       ", model.row(1).c_str());
+
+    // da ve lai -> lan sau khong con gi
+    fb->flush();
+    TEST_ASSERT_EQUAL_UINT16(0, fb->lastFlushCells());
+}
+
+static void test_clip_and_newline(void) {
+    fb->setCursor(14, 0);
+    fb->print("xyz\nab");
+    fb->flush();
+    TEST_ASSERT_EQUAL_STRING("              xy", model.row(0).c_str());
+    TEST_ASSERT_EQUAL_STRING("ab              ", model.row(1).c_str());
+    TEST_ASSERT_EQUAL(' ', fb->charAt(16, 0));
+}
+
+static void test_unbatched_matches(void) {
+    lcd->setBatching(false);
+    draw("25.31", "61");
+    fb->flush();
+    TEST_ASSERT_EQUAL_STRING("Temp 25.31 C    ", model.row(0).c_str());
+    TEST_ASSERT_EQUAL_UINT16(2, fb->lastFlushCursorMoves());
+    // khong batch: 3 giao dich moi nibble, (21 ky tu + 2 setCursor) * 2 nibble
+    TEST_ASSERT_EQUAL_UINT32((21 + 2) * 2 * 3, fb->lastFlushTransactions());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_sent_before_flush);
+    RUN_TEST(test_first_frame_cost);
+    RUN_TEST(test_unchanged_frame_is_free);
+    RUN_TEST(test_single_digit_change);
+    RUN_TEST(test_gap_merge);
+    RUN_TEST(test_invalidate_redraws_everything);
+    RUN_TEST(test_clip_and_newline);
+    RUN_TEST(test_unbatched_matches);
+    return UNITY_END();
+}
@@ -0,0 +1,174 @@
+#include <unity.h>
+#include <Wire.h>
+#include <sim_i2c_devices.h>
+#include "LCD_GlyphCache.h"
+
+#define LCD_ADDR 0x27
+
+static sim::Hd44780 model;
+static LiquidCrystal_I2C *lcd;
+static LCD_Framebuffer *fb;
+static LCD_GlyphCache *cache;
+
+// Glyph thu n: n ma hoa vao 2 hang dau (5 bit moi hang) nen khong trung nhau
+static void make_glyph(uint8_t n, uint8_t out[LCD_GLYPH_ROWS]) {
+    for (uint8_t i = 0; i < LCD_GLYPH_ROWS; i++) {
+        out[i] = (uint8_t)(i * 3 & 0x1F);
+    }
+    out[0] = n & 0x1F;
+    out[1] = n >> 5;
+}
+
+static int8_t acquire(uint8_t n) {
+    uint8_t g[LCD_GLYPH_ROWS];
+    make_glyph(n, g);
+    return cache->acquire(g);
+}
+
+static bool cgram_holds(uint8_t code, uint8_t n) {
+    uint8_t g[LCD_GLYPH_ROWS];
+    make_glyph(n, g);
+    return memcmp(&model.cgram[code * 8], g, LCD_GLYPH_ROWS) == 0;
+}
+
+void setUp(void) {
+    sim::detachAll();
+    sim::now_us = 0;
+    sim::bus = sim::I2cBus();
+    model = sim::Hd44780();
+    sim::attach(LCD_ADDR, &model);
+    lcd = new LiquidCrystal_I2C(LCD_ADDR, 16, 2);
+    lcd->begin();
+    fb = new LCD_Framebuffer(*lcd, 16, 2);
+    cache = new LCD_GlyphCache(*lcd, fb);
+}
+
+void tearDown(void) {
+    delete cache;
+    delete fb;
+    delete lcd;
+}
+
+static void test_hit_costs_nothing(void) {
+    cache->beginFrame();
+    int8_t code = acquire(1);
+    TEST_ASSERT_EQUAL(0, code);
+    TEST_ASSERT_TRUE(cgram_holds(0, 1));
+
+    uint32_t tx = lcd->getTransactions();
+    cache->beginFrame();
+    TEST_ASSERT_EQUAL(code, acquire(1));
+    // bit 5-7 khong hien thi, khong lam khac glyph
+    uint8_t g[LCD_GLYPH_ROWS];
+    make_glyph(1, g);
+    g[0] |= 0xE0;
+    TEST_ASSERT_EQUAL(code, cache->acquire(g));
+    TEST_ASSERT_EQUAL_UINT32(tx, lcd->getTransactions());
+    TEST_ASSERT_EQUAL_UINT32(2, cache->hits());
+    TEST_ASSERT_EQUAL_UINT32(1, cache->loads());
+}
+
+static void test_free_slots_before_eviction(void) {
+    for (uint8_t n = 0; n < LCD_GLYPH_SLOTS; n++) {
+        cache->beginFrame();
+        TEST_ASSERT_EQUAL(n, acquire(n));
+    }
+    for (uint8_t n = 0; n < LCD_GLYPH_SLOTS; n++) {
+        TEST_ASSERT_TRUE(cgram_holds(n, n));
+    }
+    TEST_ASSERT_EQUAL_UINT32(LCD_GLYPH_SLOTS, cache->loads());
+    TEST_ASSERT_EQUAL_UINT32(0, cache->evictions());
+}
+
+static void test_lru_eviction(void) {
+    for (uint8_t n = 0; n < LCD_GLYPH_SLOTS; n++) {
+        cache->beginFrame();
+        acquire(n);
+    }
+    // dung lai 0 va 1 -> 2 la lau nhat
+    cache->beginFrame();
+    acquire(0);
+    acquire(1);
+
+    cache->beginFrame();
+    TEST_ASSERT_EQUAL(2, acquire(100));
+    TEST_ASSERT_TRUE(cgram_holds(2, 100));
+    TEST_ASSERT_EQUAL_UINT32(1, cache->evictions());
+    // tiep theo la 3
+    cache->beginFrame();
+    TEST_ASSERT_EQUAL(3, acquire(101));
+    // 0 van con
+    TEST_ASSERT_EQUAL(0, acquire(0));
+    TEST_ASSERT_EQUAL_UINT32(2, cache->evictions());
+}
+
+static void test_frame_pins_its_glyphs(void) {
+    cache->beginFrame();
+    for (uint8_t n = 0; n < LCD_GLYPH_SLOTS; n++) {
+        TEST_ASSERT_EQUAL(n, acquire(n));
+    }
+    uint32_t tx = lcd->getTransactions();
+    TEST_ASSERT_EQUAL(-1, acquire(50));
+    TEST_ASSERT_EQUAL_UINT32(0, cache->evictions());
+    TEST_ASSERT_EQUAL_UINT32(tx, lcd->getTransactions());
+    for (uint8_t n = 0; n < LCD_GLYPH_SLOTS; n++) {
+        TEST_ASSERT_TRUE(cgram_holds(n, n));
+    }
+
+    // frame moi thi duoc thay
+    cache->beginFrame();
+    TEST_ASSERT_EQUAL(0, acquire(50));
+}
+
+// CGRAM hien thi truc tiep: o con giu code cu phai bi xoa, khong chi ghi lai
+static void test_eviction_blanks_stale_cells(void) {
+    cache->beginFrame();
+    fb->setCursor(0, 0);
+    fb->write((uint8_t)acquire(7));
+    fb->print(" kept");
+    fb->flush();
+    TEST_ASSERT_EQUAL(0, model.at(0, 0));
+
+    // cac frame sau khong xoa framebuffer va khong dung glyph 7 nua
+    for (uint8_t n = 1; n < LCD_GLYPH_SLOTS; n++) {
+        cache->beginFrame();
+        acquire(n + 10);
+    }
+    cache->beginFrame();
+    int8_t code = acquire(99);
+    TEST_ASSERT_EQUAL(0, code);
+    TEST_ASSERT_EQUAL(' ', fb->charAt(0, 0));
+    TEST_ASSERT_EQUAL('k', fb->charAt(2, 0));
+
+    // frame moi ve glyph moi o cho khac
+    fb->setCursor(10, 1);
+    fb->write((uint8_t)code);
+    fb->flush();
+    TEST_ASSERT_EQUAL(' ', model.at(0, 0));
+    TEST_ASSERT_EQUAL(0, model.at(10, 1));
+    TEST_ASSERT_TRUE(cgram_holds(0, 99));
+    TEST_ASSERT_EQUAL(0, model.violations);
+}
+
+static void test_reset_reloads(void) {
+    cache->beginFrame();
+    acquire(5);
+    lcd->begin();
+    cache->reset();
+    memset(model.cgram, 0, sizeof(model.cgram));
+    cache->beginFrame();
+    TEST_ASSERT_EQUAL(0, acquire(5));
+    TEST_ASSERT_EQUAL_UINT32(2, cache->loads());
+    TEST_ASSERT_TRUE(cgram_holds(0, 5));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_hit_costs_nothing);
+    RUN_TEST(test_free_slots_before_eviction);
+    RUN_TEST(test_lru_eviction);
+    RUN_TEST(test_frame_pins_its_glyphs);
+    RUN_TEST(test_eviction_blanks_stale_cells);
+    RUN_TEST(test_reset_reloads);
+    return UNITY_END();
+}
@@ -0,0 +1,163 @@
+#include <unity.h>
+#include "../../src/power_governor.cpp"
+
+// Ngu gia: chi ghi lai yeu cau
+static uint32_t lightRequests = 0, lastLightMs = 0;
+static uint32_t deepRequests = 0, lastDeepSec = 0;
+uint32_t light_sleep_for(uint32_t time_ms) {
+    lightRequests++;
+    lastLightMs = time_ms;
+    sim::now_us += (uint64_t)time_ms * 1000;
+    return time_ms;
+}
+void enter_deep_sleep(uint32_t time_sec) {
+    deepRequests++;
+    lastDeepSec = time_sec;
+}
+
+static governor_job_t table[4];
+static bool vetoed = false;
+
+static bool veto() { return vetoed; }
+
+static void job(int i, uint32_t period, uint32_t last, bool deep_ok) {
+    table[i] = { "job", period, last, deep_ok, true, NULL };
+}
+
+static power_state_t decide(uint32_t now, uint32_t *gap) {
+    return power_governor_decide(table, 4, now, true, gap);
+}
+
+void setUp(void) {
+    memset(table, 0, sizeof(table));
+    memset(jobs, 0, sizeof(jobs));
+    sim::now_us = 0;
+    sim::criticalDepth = 0;
+    lightRequests = deepRequests = 0;
+    vetoed = false;
+    deepEnterUs = -1;
+    memset(residencyMs, 0, sizeof(residencyMs));
+    memset(residencyEntries, 0, sizeof(residencyEntries));
+    power_governor_set_deep_veto(NULL);
+}
+
+void tearDown(void) {}
+
+static void test_no_jobs_idles(void) {
+    uint32_t gap = 123;
+    TEST_ASSERT_EQUAL(PWR_STATE_IDLE, decide(1000, &gap));
+    TEST_ASSERT_EQUAL_UINT32(0, gap);
+}
+
+static void test_thresholds(void) {
+    uint32_t gap;
+    job(0, 5000, 0, true);
+    TEST_ASSERT_EQUAL(PWR_STATE_ACTIVE, decide(5000, &gap));
+    TEST_ASSERT_EQUAL_UINT32(0, gap);
+    TEST_ASSERT_EQUAL(PWR_STATE_ACTIVE, decide(9000, &gap));     // tre han van la 0
+    TEST_ASSERT_EQUAL(PWR_STATE_IDLE, decide(5000 - GOVERNOR_LIGHT_MIN_MS - GOVERNOR_WAKE_MARGIN_MS, &gap));
+    TEST_ASSERT_EQUAL(PWR_STATE_LIGHT_SLEEP, decide(5000 - GOVERNOR_LIGHT_MIN_MS - GOVERNOR_WAKE_MARGIN_MS - 1, &gap));
+    TEST_ASSERT_EQUAL_UINT32(GOVERNOR_LIGHT_MIN_MS + GOVERNOR_WAKE_MARGIN_MS + 1, gap);
+
+    job(0, GOVERNOR_DEEP_MIN_MS, 0, true);
+    TEST_ASSERT_EQUAL(PWR_STATE_DEEP_SLEEP, decide(0, &gap));
+    TEST_ASSERT_EQUAL(PWR_STATE_LIGHT_SLEEP, decide(1, &gap));
+}
+
+// Deadline gan nhat thang; mot job khong chiu deep -> chi light sleep
+static void test_nearest_deadline_and_deep_veto(void) {
+    uint32_t gap;
+    job(0, 600000, 0, true);
+    job(1, 120000, 10000, true);
+    table[2] = { "unused", 10, 0, false, false, NULL };
+    TEST_ASSERT_EQUAL(PWR_STATE_DEEP_SLEEP, decide(20000, &gap));
+    TEST_ASSERT_EQUAL_UINT32(110000, gap);
+
+    job(3, 300000, 0, false);
+    TEST_ASSERT_EQUAL(PWR_STATE_LIGHT_SLEEP, decide(20000, &gap));
+    TEST_ASSERT_EQUAL_UINT32(110000, gap);
+}
+
+static void test_millis_wraparound(void) {
+    uint32_t gap;
+    job(0, 1000, UINT32_MAX - 200, true);
+    TEST_ASSERT_EQUAL(PWR_STATE_LIGHT_SLEEP, decide(299, &gap));
+    TEST_ASSERT_EQUAL_UINT32(500, gap);
+}
+
+// decide() khong vao critical section; step() chi khoa luc chup bang job
+static void test_step_uses_snapshot(void) {
+    int id = power_governor_register("sensor", 1000, false);
+    TEST_ASSERT_EQUAL(0, id);
+    TEST_ASSERT_EQUAL(0, sim::criticalDepth);
+    power_governor_enable(true);
+    power_governor_step();
+    TEST_ASSERT_EQUAL(0, sim::criticalDepth);
+    TEST_ASSERT_EQUAL_UINT32(1, lightRequests);
+    TEST_ASSERT_EQUAL_UINT32(1000 - GOVERNOR_WAKE_MARGIN_MS, lastLightMs);
+
+    power_governor_set_period(id, 10 * GOVERNOR_DEEP_MIN_MS);
+    power_governor_job_ran(id, millis());
+    power_governor_step();
+    TEST_ASSERT_EQUAL_UINT32(0, deepRequests);      // job khong cho deep
+    power_governor_unregister(id);
+    power_governor_register("rtc", 10 * GOVERNOR_DEEP_MIN_MS, true);
+    power_governor_step();
+    TEST_ASSERT_EQUAL_UINT32(1, deepRequests);
+    TEST_ASSERT_EQUAL_UINT32((10 * GOVERNOR_DEEP_MIN_MS - GOVERNOR_WAKE_MARGIN_MS) / 1000, lastDeepSec);
+    power_governor_enable(false);
+}
+
+// Relay bat / rule dang chay: khong deep du moi job cho phep, chi light sleep
+static void test_deep_veto(void) {
+    uint32_t gap;
+    job(0, 10 * GOVERNOR_DEEP_MIN_MS, 0, true);
+    TEST_ASSERT_EQUAL(PWR_STATE_LIGHT_SLEEP, power_governor_decide(table, 4, 0, false, &gap));
+    TEST_ASSERT_EQUAL_UINT32(10 * GOVERNOR_DEEP_MIN_MS, gap);
+
+    power_governor_register("rtc", 10 * GOVERNOR_DEEP_MIN_MS, true);
+    power_governor_set_deep_veto(veto);
+    power_governor_enable(true);
+    vetoed = true;
+    power_governor_step();
+    TEST_ASSERT_EQUAL_UINT32(0, deepRequests);
+    TEST_ASSERT_EQUAL_UINT32(1, lightRequests);
+    TEST_ASSERT_TRUE(deepEnterUs < 0);
+
+    vetoed = false;
+    power_governor_job_ran(0, millis());
+    power_governor_step();
+    TEST_ASSERT_EQUAL_UINT32(1, deepRequests);
+    TEST_ASSERT_TRUE(deepEnterUs > 0);
+    // chua ghi residency deep truoc khi ngu
+    TEST_ASSERT_EQUAL_UINT32(0, residencyEntries[PWR_STATE_DEEP_SLEEP]);
+    power_governor_enable(false);
+}
+
+// Thuc day som (vd nut reset) chi tinh thoi gian ngu that, khong phai ca gap
+static void test_deep_residency_booked_on_boot(void) {
+    power_governor_boot();
+    TEST_ASSERT_EQUAL_UINT32(0, residencyEntries[PWR_STATE_DEEP_SLEEP]);
+
+    deepEnterUs = rtc_now_us() - 5000000;
+    power_governor_boot();
+    TEST_ASSERT_EQUAL_UINT32(1, residencyEntries[PWR_STATE_DEEP_SLEEP]);
+    TEST_ASSERT_UINT32_WITHIN(100, 5000, (uint32_t)residencyMs[PWR_STATE_DEEP_SLEEP]);
+    TEST_ASSERT_TRUE(deepEnterUs < 0);
+
+    // boot lan nua khong ghi lai
+    power_governor_boot();
+    TEST_ASSERT_EQUAL_UINT32(1, residencyEntries[PWR_STATE_DEEP_SLEEP]);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_jobs_idles);
+    RUN_TEST(test_thresholds);
+    RUN_TEST(test_nearest_deadline_and_deep_veto);
+    RUN_TEST(test_millis_wraparound);
+    RUN_TEST(test_step_uses_snapshot);
+    RUN_TEST(test_deep_veto);
+    RUN_TEST(test_deep_residency_booked_on_boot);
+    return UNITY_END();
+}
@@ -0,0 +1,110 @@
+#include <unity.h>
+#include <sim_client.h>
+#include "PubSubClient.h"
+
+#define TOPIC       "v1/devices/me/telemetry"
+#define BUFFER_SIZE 128
+
+static sim::MemoryClient client;
+static PubSubClient *mqtt;
+
+static std::vector<uint8_t> make_payload(size_t n) {
+    std::vector<uint8_t> p(n);
+    for (size_t i = 0; i < n; i++) p[i] = (uint8_t)(i * 13 + 1);
+    return p;
+}
+
+// Chia payload thanh cac segment theo kich thuoc cho truoc
+static std::vector<MQTTSegment> split(const std::vector<uint8_t> &payload, std::initializer_list<size_t> sizes) {
+    std::vector<MQTTSegment> segs;
+    size_t pos = 0;
+    for (size_t n : sizes) {
+        segs.push_back({ payload.data() + pos, n });
+        pos += n;
+    }
+    return segs;
+}
+
+void setUp(void) {
+    sim::now_us = 0;
+    client = sim::MemoryClient();
+    mqtt = new PubSubClient(client);
+    mqtt->setServer("broker", 1883);
+    mqtt->setBufferSize(BUFFER_SIZE);
+    client.feed(sim::mqtt_connack());
+    TEST_ASSERT_TRUE(mqtt->connect("test"));
+    client.resetCounters();
+}
+
+void tearDown(void) {
+    delete mqtt;
+}
+
+// Vua buffer: mot lan write, giong publish() cu
+static void test_fitting_payload_is_one_write(void) {
+    std::vector<uint8_t> payload = make_payload(40);
+    std::vector<MQTTSegment> segs = split(payload, { 10, 0, 25, 5 });
+    TEST_ASSERT_TRUE(mqtt->publishSegments(TOPIC, segs.data(), segs.size(), false));
+    TEST_ASSERT_EQUAL(1, client.writeSizes.size());
+    TEST_ASSERT_TRUE(sim::mqtt_publish(TOPIC, payload) == client.tx);
+
+    // cung byte voi publish()
+    client.resetCounters();
+    TEST_ASSERT_TRUE(mqtt->publish(TOPIC, payload.data(), payload.size()));
+    TEST_ASSERT_EQUAL(1, client.writeSizes.size());
+    TEST_ASSERT_TRUE(sim::mqtt_publish(TOPIC, payload) == client.tx);
+}
+
+static void test_exactly_full_buffer(void) {
+    // header luon duoc danh cho MQTT_MAX_HEADER_SIZE byte o dau buffer
+    size_t room = BUFFER_SIZE - MQTT_MAX_HEADER_SIZE - 2 - strlen(TOPIC);
+    std::vector<uint8_t> payload = make_payload(room);
+    MQTTSegment seg = { payload.data(), payload.size() };
+    TEST_ASSERT_TRUE(mqtt->publishSegments(TOPIC, &seg, 1, false));
+    TEST_ASSERT_EQUAL(1, client.writeSizes.size());
+    TEST_ASSERT_TRUE(sim::mqtt_publish(TOPIC, payload) == client.tx);
+
+    // them 1 byte -> 2 lan write
+    client.resetCounters();
+    payload.push_back(0x55);
+    seg.length++;
+    seg.data = payload.data();
+    TEST_ASSERT_TRUE(mqtt->publishSegments(TOPIC, &seg, 1, false));
+    TEST_ASSERT_EQUAL(2, client.writeSizes.size());
+    TEST_ASSERT_EQUAL(1, client.writeSizes[1]);
+    TEST_ASSERT_TRUE(sim::mqtt_publish(TOPIC, payload) == client.tx);
+}
+
+// Khong vua: lan write dau day buffer (khong co segment nho chi header), phan con lai di thang
+static void test_large_payload_fills_first_write(void) {
+    std::vector<uint8_t> payload = make_payload(1000);
+    std::vector<MQTTSegment> segs = split(payload, { 30, 500, 0, 470 });
+    TEST_ASSERT_TRUE(mqtt->publishSegments(TOPIC, segs.data(), segs.size(), true));
+
+    std::vector<uint8_t> expected = sim::mqtt_publish(TOPIC, payload);
+    expected[0] |= 1;   // retained
+    TEST_ASSERT_TRUE(expected == client.tx);
+    // header 3 byte (remaining length 2 byte) dat ngay truoc MQTT_MAX_HEADER_SIZE
+    TEST_ASSERT_EQUAL(BUFFER_SIZE - (MQTT_MAX_HEADER_SIZE - 3), client.writeSizes[0]);
+    // phan con lai cua segment 2, segment 4
+    TEST_ASSERT_EQUAL(3, client.writeSizes.size());
+}
+
+static void test_topic_too_long(void) {
+    char topic[BUFFER_SIZE];
+    memset(topic, 't', sizeof(topic) - 1);
+    topic[sizeof(topic) - 1] = '\0';
+    uint8_t b = 0;
+    MQTTSegment seg = { &b, 1 };
+    TEST_ASSERT_FALSE(mqtt->publishSegments(topic, &seg, 1, false));
+    TEST_ASSERT_EQUAL(0, client.tx.size());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_fitting_payload_is_one_write);
+    RUN_TEST(test_exactly_full_buffer);
+    RUN_TEST(test_large_payload_fills_first_write);
+    RUN_TEST(test_topic_too_long);
+    return UNITY_END();
+}
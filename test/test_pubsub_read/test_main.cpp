@@ -0,0 +1,186 @@
+#include <unity.h>
+#include <chrono>
+#include <string>
+#include <sim_client.h>
+#include "PubSubClient.h"
+
+#define TOPIC       "v1/devices/me/attributes/res"     // 28 byte, nhu ThingsBoard
+#define BUFFER_SIZE 256
+
+// Ket qua quan sat duoc tu ben ngoai cua mot lan nhan PUBLISH
+struct outcome_t {
+    int callbacks = 0;
+    std::string topic;
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> tx;        // PUBACK
+    uint32_t reads = 0;
+
+    bool operator==(const outcome_t &o) const {
+        return callbacks == o.callbacks && topic == o.topic && payload == o.payload &&
+               stream == o.stream && tx == o.tx;
+    }
+};
+
+static std::vector<uint8_t> make_payload(size_t n) {
+    std::vector<uint8_t> p(n);
+    for (size_t i = 0; i < n; i++) p[i] = (uint8_t)(i * 7 + 3);
+    return p;
+}
+
+// Nhan mot goi qua loop(), `cap` gioi han available() (1 = tung byte nhu cach doc cu)
+static outcome_t receive(const std::vector<uint8_t> &packet, size_t cap, bool withStream, bool raw) {
+    outcome_t out;
+    sim::MemoryClient client;
+    sim::CaptureStream stream;
+    PubSubClient mqtt(client);
+    mqtt.setServer("broker", 1883);
+    mqtt.setBufferSize(BUFFER_SIZE);
+    if (withStream) mqtt.setStream(stream);
+    if (raw) {
+        mqtt.setRawCallback([&](const char *topic, uint16_t tl, uint8_t *payload, unsigned int len) {
+            out.callbacks++;
+            out.topic.assign(topic, tl);
+            out.payload.assign(payload, payload + len);
+        });
+    } else {
+        mqtt.setCallback([&](char *topic, uint8_t *payload, unsigned int len) {
+            out.callbacks++;
+            out.topic = topic;
+            out.payload.assign(payload, payload + len);
+        });
+    }
+
+    client.feed(sim::mqtt_connack());
+    TEST_ASSERT_TRUE(mqtt.connect("test"));
+    client.resetCounters();
+    client.feed(packet);
+    client.maxAvailable = cap;
+    // loop() doc toi da 1 goi moi lan
+    while (client.available()) mqtt.loop();
+
+    out.stream = stream.data;
+    out.tx = client.tx;
+    out.reads = client.reads;
+    return out;
+}
+
+void setUp(void) {
+    sim::now_us = 0;
+}
+
+void tearDown(void) {}
+
+static void test_small_payload(void) {
+    std::vector<uint8_t> payload = make_payload(64);
+    outcome_t o = receive(sim::mqtt_publish(TOPIC, payload), 0, false, false);
+    TEST_ASSERT_EQUAL(1, o.callbacks);
+    TEST_ASSERT_EQUAL_STRING(TOPIC, o.topic.c_str());
+    TEST_ASSERT_TRUE(payload == o.payload);
+    TEST_ASSERT_TRUE(o.tx.empty());
+    // header, remaining length, 2 byte do dai topic tung byte; than goi 1 lan
+    TEST_ASSERT_EQUAL_UINT32(5, o.reads);
+}
+
+static void test_qos1_puback(void) {
+    std::vector<uint8_t> payload = make_payload(10);
+    outcome_t o = receive(sim::mqtt_publish(TOPIC, payload, 1, 0x1234), 0, false, true);
+    TEST_ASSERT_EQUAL(1, o.callbacks);
+    TEST_ASSERT_TRUE(payload == o.payload);
+    std::vector<uint8_t> puback = { 0x40, 0x02, 0x12, 0x34 };
+    TEST_ASSERT_TRUE(puback == o.tx);
+}
+
+static void test_oversized_without_stream_is_dropped(void) {
+    outcome_t o = receive(sim::mqtt_publish(TOPIC, make_payload(BUFFER_SIZE * 3), 1), 0, false, false);
+    TEST_ASSERT_EQUAL(0, o.callbacks);
+    TEST_ASSERT_TRUE(o.tx.empty());
+}
+
+static void test_oversized_goes_to_stream(void) {
+    std::vector<uint8_t> payload = make_payload(BUFFER_SIZE * 3 + 5);
+    outcome_t o = receive(sim::mqtt_publish(TOPIC, payload), 0, true, false);
+    TEST_ASSERT_TRUE(payload == o.stream);
+}
+
+// Vi sai: moi to hop phai cho cung ket qua voi doc tung byte va giua 2 kieu callback
+static void test_differential(void) {
+    const size_t sizes[] = { 0, 1, 64, BUFFER_SIZE - 40, BUFFER_SIZE, BUFFER_SIZE * 4 + 3 };
+    const size_t caps[] = { 0, 7, 1 };
+    char msg[96];
+
+    for (size_t size : sizes) {
+        for (uint8_t qos = 0; qos <= 1; qos++) {
+            for (int withStream = 0; withStream <= 1; withStream++) {
+                std::vector<uint8_t> payload = make_payload(size);
+                std::vector<uint8_t> packet = sim::mqtt_publish(TOPIC, payload, qos, 7);
+                outcome_t ref = receive(packet, 1, withStream, false);
+                snprintf(msg, sizeof(msg), "size %u qos %u stream %d", (unsigned)size, qos, withStream);
+
+                if (withStream) TEST_ASSERT_TRUE_MESSAGE(payload == ref.stream, msg);
+                if (packet.size() <= BUFFER_SIZE) {
+                    TEST_ASSERT_EQUAL_MESSAGE(1, ref.callbacks, msg);
+                    TEST_ASSERT_TRUE_MESSAGE(payload == ref.payload, msg);
+                    TEST_ASSERT_EQUAL_MESSAGE(qos ? 4 : 0, ref.tx.size(), msg);
+                }
+                for (size_t cap : caps) {
+                    for (int raw = 0; raw <= 1; raw++) {
+                        outcome_t o = receive(packet, cap, withStream, raw);
+                        TEST_ASSERT_TRUE_MESSAGE(ref == o, msg);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Benchmark tren host, Client trong bo nho, QoS0, topic 28 byte. Chi in ket qua.
+static void test_bench(void) {
+    const size_t sizes[] = { 64, 1024, 8192 };
+    char msg[128];
+
+    for (size_t size : sizes) {
+        sim::MemoryClient client;
+        PubSubClient mqtt(client);
+        volatile uint32_t sink = 0;
+        mqtt.setServer("broker", 1883);
+        mqtt.setBufferSize(size + 64);
+        mqtt.setRawCallback([&](const char *, uint16_t, uint8_t *payload, unsigned int len) {
+            sink += payload[len - 1];
+        });
+        client.feed(sim::mqtt_connack());
+        TEST_ASSERT_TRUE(mqtt.connect("bench"));
+
+        double ns[2];
+        uint32_t reads[2];
+        for (int mode = 0; mode < 2; mode++) {
+            const uint32_t n = 2000;
+            client.rx = sim::mqtt_publish(TOPIC, make_payload(size));
+            client.maxAvailable = mode ? 1 : 0;
+            client.reads = 0;
+            auto t0 = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < n; i++) {
+                client.rewind();
+                mqtt.loop();
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            ns[mode] = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+            reads[mode] = client.reads / n;
+        }
+        snprintf(msg, sizeof(msg), "%5u B: bulk %.0f ns/msg (%u reads), 1 byte available %.0f ns/msg (%u reads)",
+                 (unsigned)size, ns[0], (unsigned)reads[0], ns[1], (unsigned)reads[1]);
+        TEST_MESSAGE(msg);
+        (void)sink;
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_small_payload);
+    RUN_TEST(test_qos1_puback);
+    RUN_TEST(test_oversized_without_stream_is_dropped);
+    RUN_TEST(test_oversized_goes_to_stream);
+    RUN_TEST(test_differential);
+    RUN_TEST(test_bench);
+    return UNITY_END();
+}
@@ -0,0 +1,221 @@
+#include <unity.h>
+#include "../../src/relay_manager.cpp"
+
+// Cong tac gia: console va event bus
+static const console_cmd_t *registered = NULL;
+static int published = 0;
+bool console_register(const console_cmd_t *cmd) {
+    registered = cmd;
+    return true;
+}
+void console_prompt() {}
+bool console_arg_u32(const char *arg, uint32_t *out) {
+    char *end;
+    *out = strtoul(arg, &end, 10);
+    return *arg && *end == '\0';
+}
+void event_bus_publish(event_topic_t topic, const void *data, uint8_t len) {
+    published++;
+}
+
+// HAL ghi lai trang thai chan GPIO0..63 va thoi diem ghi thanh ghi
+static uint64_t pins = 0;
+static int writes = 0;
+static uint64_t writeAtUs = 0;
+static uint32_t outputCostUs = 0;   // thoi gian cau hinh mot chan output
+static void sim_output(uint8_t gpio) {
+    pins &= ~(1ULL << gpio);
+    sim::advance(outputCostUs);
+}
+static void sim_write(uint32_t set_lo, uint32_t clr_lo, uint32_t set_hi, uint32_t clr_hi) {
+    uint64_t set = set_lo | ((uint64_t)set_hi << 32);
+    uint64_t clr = clr_lo | ((uint64_t)clr_hi << 32);
+    pins = (pins & ~clr) | set;
+    writes++;
+    writeAtUs = sim::now_us;
+}
+static const relay_hal_t simHal = { sim_output, sim_write };
+
+// Chay lenh console nhu khi go tu Serial (token tro vao buffer co the sua)
+static void run(const char *cmdline) {
+    static char buf[CONSOLE_LINE_MAX];
+    char *argv[CONSOLE_MAX_ARGS];
+    int argc = 0;
+    strncpy(buf, cmdline, sizeof(buf) - 1);
+    for (char *tok = strtok(buf, " "); tok && argc < CONSOLE_MAX_ARGS; tok = strtok(NULL, " ")) {
+        argv[argc++] = tok;
+    }
+    registered->handler(argc, argv);
+}
+
+static bool apply(const char *json) {
+    static char buf[RELAY_JSON_DOC];
+    strcpy(buf, json);
+    return relay_apply_json(buf, strlen(buf));
+}
+
+void setUp(void) {
+    memset(relays, 0, sizeof(relays));
+    memset(scenes, 0, sizeof(scenes));
+    relayCount = 0;
+    relayState = 0;
+    pins = 0;
+    writes = 0;
+    writeAtUs = 0;
+    outputCostUs = 0;
+    published = 0;
+    Serial.output.clear();
+    relay_manager_begin(&simHal);
+}
+
+void tearDown(void) {}
+
+static void test_device_message_registers_and_switches(void) {
+    TEST_ASSERT_TRUE(apply("{\"page\":\"device\",\"value\":[{\"name\":\"fan\",\"status\":\"ON\",\"gpio\":\"5\"},"
+                           "{\"name\":\"pump\",\"status\":\"off\",\"gpio\":40}]}"));
+    TEST_ASSERT_EQUAL(2, relay_count());
+    TEST_ASSERT_EQUAL_HEX32(0x1, relay_state());
+    TEST_ASSERT_TRUE(pins == (1ULL << 5));
+    TEST_ASSERT_EQUAL(1, writes);    // ca khoi trong mot lan ghi
+
+    TEST_ASSERT_TRUE(apply("{\"page\":\"device\",\"value\":{\"name\":\"pump\",\"status\":1}}"));
+    TEST_ASSERT_TRUE(pins == ((1ULL << 5) | (1ULL << 40)));
+}
+
+static void test_device_message_rejects_bad_status(void) {
+    relay_register("fan", 5);
+    TEST_ASSERT_FALSE(apply("{\"page\":\"device\",\"value\":{\"name\":\"fan\",\"status\":\"yes\"}}"));
+    TEST_ASSERT_FALSE(apply("{\"page\":\"device\",\"value\":{\"name\":\"fan\"}}"));
+    TEST_ASSERT_EQUAL_HEX32(0, relay_state());
+    TEST_ASSERT_EQUAL(0, writes);
+    // gpio bi cam (strapping) -> khong dang ky
+    TEST_ASSERT_FALSE(apply("{\"page\":\"device\",\"value\":{\"name\":\"x\",\"status\":\"ON\",\"gpio\":0}}"));
+    TEST_ASSERT_EQUAL(1, relay_count());
+}
+
+static void test_scene_save_and_apply(void) {
+    relay_register("fan", 5);
+    relay_register("pump", 6);
+    TEST_ASSERT_TRUE(apply("{\"page\":\"scene\",\"value\":{\"name\":\"night\",\"relays\":"
+                           "[{\"name\":\"fan\",\"status\":\"OFF\"},{\"name\":\"pump\",\"status\":\"ON\"}]}}"));
+    TEST_ASSERT_EQUAL(0, writes);
+    relay_set("fan", true);
+    TEST_ASSERT_TRUE(apply("{\"page\":\"scene\",\"value\":{\"name\":\"NIGHT\"}}"));
+    TEST_ASSERT_EQUAL_HEX32(0x2, relay_state());
+    TEST_ASSERT_FALSE(apply("{\"page\":\"scene\",\"value\":{\"name\":\"day\"}}"));
+    TEST_ASSERT_FALSE(apply("{\"page\":\"setting\",\"value\":{}}"));
+}
+
+static void test_console_json(void) {
+    run("relay json {\"page\":\"device\",\"value\":{\"name\":\"fan\",\"status\":\"ON\",\"gpio\":\"5\"}}");
+    TEST_ASSERT_EQUAL_HEX32(0x1, relay_state());
+    TEST_ASSERT_TRUE(Serial.output.find("{\"page\":\"device\",\"value\":[{\"name\":\"fan\",\"status\":\"ON\",\"gpio\":5}]}")
+                     != std::string::npos);
+
+    Serial.output.clear();
+    run("relay json {not-json");
+    TEST_ASSERT_TRUE(Serial.output.find("Invalid relay message") != std::string::npos);
+}
+
+static void test_console_state_is_strict(void) {
+    relay_register("fan", 5);
+    run("relay fan on");
+    TEST_ASSERT_EQUAL_HEX32(0x1, relay_state());
+    run("relay fan 0");
+    TEST_ASSERT_EQUAL_HEX32(0x0, relay_state());
+    run("relay fan 1");
+    TEST_ASSERT_EQUAL_HEX32(0x1, relay_state());
+
+    // truoc day moi tu khac "on" deu la tat
+    Serial.output.clear();
+    run("relay fan of");
+    TEST_ASSERT_EQUAL_HEX32(0x1, relay_state());
+    TEST_ASSERT_TRUE(Serial.output.find("State must be on/off/1/0") != std::string::npos);
+    run("relay fan OFF");
+    TEST_ASSERT_EQUAL_HEX32(0x0, relay_state());
+}
+
+// Mot entry sai (status la, chan bi cam, relay moi thieu gpio) -> khong dong gi ca,
+// ke ca entry hop le dung truoc va doi chan
+static void test_bad_entry_rejects_whole_batch(void) {
+    relay_register("fan", 5);
+    relay_set("fan", true);
+    int before = writes;
+
+    TEST_ASSERT_FALSE(apply("{\"page\":\"device\",\"value\":[{\"name\":\"fan\",\"status\":\"ON\",\"gpio\":6},"
+                            "{\"name\":\"pump\",\"status\":\"ON\",\"gpio\":40},"
+                            "{\"name\":\"heater\",\"status\":\"yes\",\"gpio\":7}]}"));
+    TEST_ASSERT_FALSE(apply("{\"page\":\"device\",\"value\":[{\"name\":\"fan\",\"status\":\"OFF\"},"
+                            "{\"name\":\"pump\",\"status\":\"ON\",\"gpio\":0}]}"));
+    TEST_ASSERT_FALSE(apply("{\"page\":\"device\",\"value\":[{\"name\":\"fan\",\"status\":\"OFF\"},"
+                            "{\"name\":\"pump\",\"status\":\"ON\"}]}"));
+    TEST_ASSERT_FALSE(apply("{\"page\":\"scene\",\"value\":{\"name\":\"night\",\"relays\":"
+                            "[{\"name\":\"fan\",\"status\":\"OFF\",\"gpio\":6},{\"name\":\"pump\",\"status\":2.5}]}}"));
+
+    TEST_ASSERT_EQUAL(1, relay_count());
+    TEST_ASSERT_EQUAL(5, relays[0].gpio);
+    TEST_ASSERT_EQUAL_HEX32(0x1, relay_state());
+    TEST_ASSERT_TRUE(pins == (1ULL << 5));
+    TEST_ASSERT_EQUAL(before, writes);
+
+    // qua RELAY_MAX relay moi -> bo ca khoi
+    TEST_ASSERT_FALSE(apply("{\"page\":\"device\",\"value\":[{\"name\":\"a\",\"status\":1,\"gpio\":1},"
+                            "{\"name\":\"b\",\"status\":1,\"gpio\":2},{\"name\":\"c\",\"status\":1,\"gpio\":4},"
+                            "{\"name\":\"d\",\"status\":1,\"gpio\":6},{\"name\":\"e\",\"status\":1,\"gpio\":7},"
+                            "{\"name\":\"f\",\"status\":1,\"gpio\":8},{\"name\":\"g\",\"status\":1,\"gpio\":9},"
+                            "{\"name\":\"h\",\"status\":1,\"gpio\":10}]}"));
+    TEST_ASSERT_EQUAL(1, relay_count());
+}
+
+// Doi chan khi dang ON: chan cu tat va chan moi bat trong cung mot lan ghi
+static void test_repin_in_one_write(void) {
+    relay_register("fan", 5);
+    relay_set("fan", true);
+    int before = writes;
+
+    TEST_ASSERT_TRUE(apply("{\"page\":\"device\",\"value\":[{\"name\":\"fan\",\"status\":\"ON\",\"gpio\":6},"
+                           "{\"name\":\"pump\",\"status\":\"ON\",\"gpio\":40}]}"));
+    TEST_ASSERT_EQUAL(before + 1, writes);
+    TEST_ASSERT_TRUE(pins == ((1ULL << 6) | (1ULL << 40)));
+    TEST_ASSERT_EQUAL_HEX32(0x3, relay_state());
+}
+
+// Do tre lenh -> chan: moc thoi gian tai lan ghi HAL, so voi lastLatencyUs
+static void test_command_to_pin_latency(void) {
+    outputCostUs = 25;
+    sim::now_us = 1000;
+    uint64_t cmdAt = sim::now_us;
+
+    TEST_ASSERT_TRUE(apply("{\"page\":\"device\",\"value\":[{\"name\":\"fan\",\"status\":\"ON\",\"gpio\":5},"
+                           "{\"name\":\"pump\",\"status\":\"ON\",\"gpio\":6},"
+                           "{\"name\":\"heater\",\"status\":\"OFF\",\"gpio\":40}]}"));
+    TEST_ASSERT_EQUAL(1, writes);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(writeAtUs - cmdAt), lastLatencyUs);
+    TEST_ASSERT_EQUAL_UINT32(3 * outputCostUs, lastLatencyUs);     // cau hinh 3 chan moi
+    char msg[64];
+    snprintf(msg, sizeof(msg), "register + apply 3 relays: %lu us (sim)", (unsigned long)lastLatencyUs);
+    TEST_MESSAGE(msg);
+
+    // relay da co: khong cau hinh lai chan, ghi ngay
+    cmdAt = sim::now_us;
+    TEST_ASSERT_TRUE(apply("{\"page\":\"device\",\"value\":[{\"name\":\"fan\",\"status\":\"OFF\"},"
+                           "{\"name\":\"heater\",\"status\":\"ON\"}]}"));
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(writeAtUs - cmdAt), lastLatencyUs);
+    TEST_ASSERT_EQUAL_UINT32(0, lastLatencyUs);
+
+    run("relay");
+    TEST_ASSERT_TRUE(Serial.output.find("Last apply: 0 us") != std::string::npos);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_device_message_registers_and_switches);
+    RUN_TEST(test_device_message_rejects_bad_status);
+    RUN_TEST(test_scene_save_and_apply);
+    RUN_TEST(test_console_json);
+    RUN_TEST(test_console_state_is_strict);
+    RUN_TEST(test_bad_entry_rejects_whole_batch);
+    RUN_TEST(test_repin_in_one_write);
+    RUN_TEST(test_command_to_pin_latency);
+    return UNITY_END();
+}
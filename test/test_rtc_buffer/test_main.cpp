@@ -0,0 +1,77 @@
+#include <unity.h>
+#include "../../src/rtc_sample_buffer.cpp"
+
+#define FLUSH_EVERY 6
+
+static void fill(uint16_t n) {
+    for (uint16_t i = 0; i < n; i++) rtc_buffer_append(1000 + i, 2500, 6000);
+}
+
+void setUp(void) {
+    memset(&rtcBuf, 0, sizeof(rtcBuf));
+    rtc_buffer_begin();
+}
+
+void tearDown(void) {}
+
+static void test_flush_every_n_wakes(void) {
+    rtc_buffer_note_wake();
+    TEST_ASSERT_FALSE(rtc_buffer_should_flush(FLUSH_EVERY));   // buffer rong
+    fill(1);
+    for (int i = 1; i < FLUSH_EVERY; i++) {
+        TEST_ASSERT_FALSE(rtc_buffer_should_flush(FLUSH_EVERY));
+        rtc_buffer_note_wake();
+    }
+    TEST_ASSERT_TRUE(rtc_buffer_should_flush(FLUSH_EVERY));
+}
+
+static void test_full_buffer_flushes_early(void) {
+    fill(RTC_SAMPLE_CAPACITY);
+    TEST_ASSERT_TRUE(rtc_buffer_should_flush(FLUSH_EVERY));
+}
+
+// Mang hong va buffer day: khong bat radio moi lan thuc day, chi moi N lan
+static void test_full_buffer_backs_off_after_failure(void) {
+    fill(RTC_SAMPLE_CAPACITY);
+    rtc_buffer_defer_flush();
+    int flushes = 0;
+    for (int wake = 0; wake < 4 * FLUSH_EVERY; wake++) {
+        rtc_buffer_note_wake();
+        rtc_buffer_append(5000 + wake, 2600, 6100);
+        if (rtc_buffer_should_flush(FLUSH_EVERY)) {
+            flushes++;
+            rtc_buffer_defer_flush();
+        }
+    }
+    TEST_ASSERT_EQUAL(4, flushes);
+    TEST_ASSERT_EQUAL(RTC_SAMPLE_CAPACITY, rtc_buffer_count());
+    TEST_ASSERT_EQUAL(4 * FLUSH_EVERY, rtc_buffer_dropped());
+
+    // flush thanh cong -> lai duoc flush som khi day
+    rtc_buffer_clear();
+    fill(RTC_SAMPLE_CAPACITY);
+    TEST_ASSERT_TRUE(rtc_buffer_should_flush(FLUSH_EVERY));
+}
+
+static void test_drop_oldest_and_format(void) {
+    fill(RTC_SAMPLE_CAPACITY + 2);
+    TEST_ASSERT_EQUAL(2, rtc_buffer_dropped());
+    rtc_buffer_clear();
+    rtc_buffer_append(1700000000, -512, 4507);
+    rtc_buffer_append(1700000060, 5, 10000);
+    char json[160];
+    TEST_ASSERT_GREATER_THAN(0, rtc_buffer_format_json(json, sizeof(json)));
+    TEST_ASSERT_EQUAL_STRING("[{\"ts\":1700000000000,\"values\":{\"temperature\":-5.12,\"humidity\":45.07}},"
+                             "{\"ts\":1700000060000,\"values\":{\"temperature\":0.05,\"humidity\":100.00}}]",
+                             json);
+    TEST_ASSERT_EQUAL(0, rtc_buffer_format_json(json, 40));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_flush_every_n_wakes);
+    RUN_TEST(test_full_buffer_flushes_early);
+    RUN_TEST(test_full_buffer_backs_off_after_failure);
+    RUN_TEST(test_drop_oldest_and_format);
+    return UNITY_END();
+}
@@ -0,0 +1,306 @@
+#include <unity.h>
+#include <chrono>
+#include <string>
+#include "../../src/rule_engine.cpp"
+#include "../../src/relay_manager.cpp"
+
+// Cong tac gia
+static const console_cmd_t *rulesCmd = NULL;
+bool console_register(const console_cmd_t *cmd) {
+    if (strcmp(cmd->name, "rules") == 0) rulesCmd = cmd;
+    return true;
+}
+void console_prompt() {}
+bool console_arg_u32(const char *arg, uint32_t *out) { return false; }
+void event_bus_publish(event_topic_t topic, const void *data, uint8_t len) {}
+bool dlog_write(const char *fmt, uint8_t nargs, const uint8_t *types, const dlog_word_t *args) { return true; }
+static int ledSets = 0;
+bool indicator_set(indicator_channel_t ch, const indicator_pattern_t *p) {
+    ledSets++;
+    return true;
+}
+static float watchLo, watchHi;
+void temp_humi_set_watch(float lo, float hi) {
+    watchLo = lo;
+    watchHi = hi;
+}
+
+static void sim_output(uint8_t gpio) {}
+static void sim_write(uint32_t set_lo, uint32_t clr_lo, uint32_t set_hi, uint32_t clr_hi) {}
+static const relay_hal_t simHal = { sim_output, sim_write };
+
+static rule_program_t prog;
+static uint8_t runLatch[RULES_SLOTS_MAX];
+static uint8_t runState[RULES_MAX];
+static rule_effects_t fx;
+static StaticJsonDocument<RULES_JSON_DOC> doc;
+
+static const char *compile_str(const char *json) {
+    const char *err = NULL;
+    // nesting limit cao hon mac dinh de toi duoc kiem tra do sau cua compiler
+    TEST_ASSERT_TRUE(deserializeJson(doc, json, DeserializationOption::NestingLimit(32)) == DeserializationError::Ok);
+    if (rules_compile(doc.as<JsonVariantConst>(), &prog, &err)) return NULL;
+    return err ? err : "?";
+}
+
+static void reset_run() {
+    memset(runLatch, 0, sizeof(runLatch));
+    memset(runState, 0xFF, sizeof(runState));
+}
+
+static uint8_t run(float t, float h, float a) {
+    float inputs[RULE_IN_COUNT] = { t, h, a };
+    TEST_ASSERT_TRUE(rules_run(&prog, runLatch, runState, inputs, &fx));
+    return runState[0];
+}
+
+void setUp(void) {
+    memset(relays, 0, sizeof(relays));
+    relayCount = 0;
+    relayState = 0;
+    relay_manager_begin(&simHal);
+    memset(programs, 0, sizeof(programs));
+    activeProgram = 0;
+    sim::files.clear();
+    rules_begin();      // chua co /rules.json -> chi dang ky lenh
+    ledSets = 0;
+    reset_run();
+}
+
+void tearDown(void) {}
+
+static void test_hysteresis(void) {
+    TEST_ASSERT_NULL(compile_str("[{\"when\":{\"input\":\"temperature\",\"op\":\">\",\"value\":30,\"hyst\":1},"
+                                 "\"then\":{\"led\":\"alarm\"},\"else\":{\"led\":\"normal\"}}]"));
+    TEST_ASSERT_EQUAL(30.0f, prog.watchHi);
+    TEST_ASSERT_TRUE(isnan(prog.watchLo));
+
+    TEST_ASSERT_EQUAL(0, run(29.9f, 50, 0));
+    TEST_ASSERT_EQUAL(RULE_LED_NORMAL, fx.led);     // lan dau luon tac dong
+    TEST_ASSERT_EQUAL(1, run(30.5f, 50, 0));
+    TEST_ASSERT_EQUAL(RULE_LED_ALARM, fx.led);
+    TEST_ASSERT_EQUAL(1, run(29.5f, 50, 0));        // trong vung hysteresis
+    TEST_ASSERT_EQUAL(0, fx.fired);
+    TEST_ASSERT_EQUAL(-1, fx.led);
+    TEST_ASSERT_EQUAL(0, run(28.9f, 50, 0));
+    TEST_ASSERT_EQUAL(1, fx.fired);
+    TEST_ASSERT_EQUAL(0, run(29.9f, 50, 0));        // chua vuot nguong goc
+    TEST_ASSERT_EQUAL(1, run(30.1f, 50, 0));
+
+    // nguong duoi: latch giu toi value + hyst
+    TEST_ASSERT_NULL(compile_str("[{\"when\":{\"input\":\"humidity\",\"op\":\"<\",\"value\":40,\"hyst\":-2},"
+                                 "\"then\":{\"led\":\"warn\"}}]"));
+    reset_run();
+    TEST_ASSERT_EQUAL(1, run(25, 39, 0));
+    TEST_ASSERT_EQUAL(1, run(25, 41.9f, 0));        // hyst lay tri tuyet doi
+    TEST_ASSERT_EQUAL(0, run(25, 42.1f, 0));
+}
+
+// all:[T > 30, any:[H > 80, not:{anomaly > 100}]] so voi bieu thuc C
+static void test_and_or_not(void) {
+    TEST_ASSERT_NULL(compile_str("[{\"when\":{\"all\":[{\"input\":\"temperature\",\"op\":\">\",\"value\":30},"
+                                 "{\"any\":[{\"input\":\"humidity\",\"op\":\">\",\"value\":80},"
+                                 "{\"not\":{\"input\":\"anomaly\",\"op\":\">\",\"value\":100}}]}]},"
+                                 "\"then\":{\"led\":\"alarm\"}}]"));
+    for (int mask = 0; mask < 8; mask++) {
+        bool t = mask & 1, h = mask & 2, a = mask & 4;
+        reset_run();
+        uint8_t got = run(t ? 31 : 29, h ? 81 : 79, a ? 101 : 99);
+        TEST_ASSERT_EQUAL_MESSAGE(t && (h || !a), got, std::to_string(mask).c_str());
+    }
+}
+
+static std::string nested(int depth) {
+    std::string leaf = "{\"input\":\"temperature\",\"op\":\">\",\"value\":1}";
+    std::string cond = leaf;
+    for (int i = 0; i < depth; i++) cond = "{\"any\":[" + leaf + "," + cond + "]}";
+    return "[{\"when\":" + cond + ",\"then\":{\"led\":\"warn\"}}]";
+}
+
+// Do sau stack lon nhat cua bytecode, phai <= RULES_STACK_MAX
+static int max_stack(const rule_program_t *p) {
+    int sp = 0, peak = 0;
+    for (uint16_t pc = 0; pc < p->codeLen; ) {
+        switch (p->code[pc]) {
+        case OP_LOAD: case OP_CONST: sp++; pc += 2; break;
+        case OP_GT: case OP_LT: sp--; pc += 3; break;
+        case OP_AND: case OP_OR: sp--; pc += 1; break;
+        case OP_NOT: pc += 1; break;
+        case OP_RULE: sp--; pc += 4; break;
+        default: return -1;
+        }
+        if (sp > peak) peak = sp;
+        if (sp < 0) return -1;
+    }
+    return sp == 0 ? peak : -1;
+}
+
+static void test_depth_and_stack_limits(void) {
+    TEST_ASSERT_NULL(compile_str(nested(RULE_MAX_DEPTH).c_str()));
+    int peak = max_stack(&prog);
+    TEST_ASSERT_GREATER_THAN(0, peak);
+    TEST_ASSERT_LESS_OR_EQUAL(RULES_STACK_MAX, peak);
+    TEST_ASSERT_EQUAL(1, run(2, 0, 0));
+
+    TEST_ASSERT_EQUAL_STRING("condition nested too deep", compile_str(nested(RULE_MAX_DEPTH + 1).c_str()));
+    std::string nots = "{\"input\":\"humidity\",\"op\":\"<\",\"value\":1}";
+    for (int i = 0; i <= RULE_MAX_DEPTH; i++) nots = "{\"not\":" + nots + "}";
+    TEST_ASSERT_EQUAL_STRING("condition nested too deep",
+                             compile_str(("[{\"when\":" + nots + ",\"then\":{\"led\":\"off\"}}]").c_str()));
+}
+
+static void test_compile_errors(void) {
+    TEST_ASSERT_EQUAL_STRING("rules must be an array", compile_str("{\"when\":{}}"));
+    TEST_ASSERT_EQUAL_STRING("unknown input",
+                             compile_str("[{\"when\":{\"input\":\"pressure\",\"op\":\">\",\"value\":1}}]"));
+    TEST_ASSERT_EQUAL_STRING("op must be > or <",
+                             compile_str("[{\"when\":{\"input\":\"humidity\",\"op\":\"=\",\"value\":1}}]"));
+    TEST_ASSERT_EQUAL_STRING("empty all/any", compile_str("[{\"when\":{\"all\":[]}}]"));
+    TEST_ASSERT_EQUAL_STRING("unknown led pattern",
+                             compile_str("[{\"when\":{\"input\":\"humidity\",\"op\":\">\",\"value\":1},"
+                                         "\"then\":{\"led\":\"disco\"}}]"));
+    TEST_ASSERT_EQUAL_STRING("relay gpio not allowed",
+                             compile_str("[{\"when\":{\"input\":\"humidity\",\"op\":\">\",\"value\":1},"
+                                         "\"then\":{\"relay\":\"Fan\",\"status\":\"ON\",\"gpio\":0}}]"));
+    std::string many = "[";
+    for (int i = 0; i <= RULES_MAX; i++) {
+        many += std::string(i ? "," : "") + "{\"when\":{\"input\":\"humidity\",\"op\":\">\",\"value\":" +
+                std::to_string(i) + "}}";
+    }
+    TEST_ASSERT_EQUAL_STRING("too many rules", compile_str((many + "]").c_str()));
+
+    // bytecode hong -> interpreter dung lai
+    TEST_ASSERT_NULL(compile_str("[{\"when\":{\"input\":\"humidity\",\"op\":\">\",\"value\":1}}]"));
+    prog.code[0] = 0xEE;
+    float inputs[RULE_IN_COUNT] = { 0, 0, 0 };
+    TEST_ASSERT_FALSE(rules_run(&prog, runLatch, runState, inputs, &fx));
+}
+
+#define FAN_RULE "[{\"when\":{\"input\":\"temperature\",\"op\":\">\",\"value\":30,\"hyst\":2}," \
+                 "\"then\":{\"relay\":\"Fan\",\"status\":\"ON\",\"gpio\":5},\"else\":{\"relay\":\"Fan\",\"status\":\"OFF\"}}]"
+
+// Doi chuong trinh / clear: latch va state cu phai bi xoa
+static void test_swap_and_clear_reset_state(void) {
+    TEST_ASSERT_TRUE(rules_apply_json(FAN_RULE, strlen(FAN_RULE)));
+    TEST_ASSERT_TRUE(sim::files.count(RULES_PATH));
+    TEST_ASSERT_EQUAL(30.0f, watchHi);
+    rules_evaluate(31, 50, 0);
+    TEST_ASSERT_EQUAL_HEX32(0x1, relay_state());
+    TEST_ASSERT_EQUAL(1, latch[0]);
+    TEST_ASSERT_EQUAL(1, ruleState[0]);
+
+    // cung rule nap lai: latch khong con giu -> 29 la false, else tat quat
+    TEST_ASSERT_TRUE(rules_apply_json(FAN_RULE, strlen(FAN_RULE)));
+    TEST_ASSERT_EQUAL(0, latch[0]);
+    TEST_ASSERT_EQUAL(0xFF, ruleState[0]);
+    rules_evaluate(29, 50, 0);
+    TEST_ASSERT_EQUAL_HEX32(0x0, relay_state());
+    rules_evaluate(31, 50, 0);
+    TEST_ASSERT_EQUAL(1, latch[0]);
+
+    char clear[] = "clear";
+    char name[] = "rules";
+    char *argv[] = { name, clear };
+    rulesCmd->handler(2, argv);
+    TEST_ASSERT_EQUAL(0, programs[activeProgram].ruleCount);
+    TEST_ASSERT_EQUAL(0, latch[0]);
+    TEST_ASSERT_EQUAL(0xFF, ruleState[0]);
+    TEST_ASSERT_TRUE(isnan(watchLo) && isnan(watchHi));
+    TEST_ASSERT_FALSE(sim::files.count(RULES_PATH));
+
+    // rule bi loi khong dong den chuong trinh dang chay
+    TEST_ASSERT_TRUE(rules_apply_json(FAN_RULE, strlen(FAN_RULE)));
+    rules_evaluate(31, 50, 0);
+    TEST_ASSERT_FALSE(rules_apply_json("[{\"when\":{}}]", 13));
+    TEST_ASSERT_EQUAL(1, latch[0]);
+    TEST_ASSERT_EQUAL(1, programs[activeProgram].ruleCount);
+}
+
+static std::string temp_rule(const char *op, int value) {
+    return std::string("{\"when\":{\"input\":\"temperature\",\"op\":\"") + op + "\",\"value\":" +
+           std::to_string(value) + "},\"then\":{\"led\":\"warn\"}}";
+}
+
+// Nhieu nguong nhiet do: giu thap nhat / cao nhat, khong chi nguong cuoi cung
+static void test_watch_keeps_min_max(void) {
+    TEST_ASSERT_NULL(compile_str(("[" + temp_rule("<", 18) + "]").c_str()));
+    TEST_ASSERT_EQUAL(18.0f, prog.watchLo);
+    TEST_ASSERT_TRUE(isnan(prog.watchHi));
+
+    TEST_ASSERT_NULL(compile_str(("[" + temp_rule(">", 30) + "," + temp_rule(">", 35) + "," +
+                                  temp_rule(">", 32) + "]").c_str()));
+    TEST_ASSERT_EQUAL(30.0f, prog.watchLo);
+    TEST_ASSERT_EQUAL(35.0f, prog.watchHi);
+
+    TEST_ASSERT_NULL(compile_str(("[" + temp_rule("<", 18) + "," + temp_rule("<", 10) + "," +
+                                  temp_rule(">", 25) + "]").c_str()));
+    TEST_ASSERT_EQUAL(10.0f, prog.watchLo);
+    TEST_ASSERT_EQUAL(25.0f, prog.watchHi);
+}
+
+// Che do active: console `rules json` nap rule nhu trang Rules, bao loi khi sai
+static void test_console_json(void) {
+    char name[] = "rules", sub[] = "json";
+    char msg[] = "{\"page\":\"rules\",\"value\":[{\"when\":{\"input\":\"humidity\",\"op\":\">\",\"value\":80},"
+                 "\"then\":{\"led\":\"alarm\"}}]}";
+    char *argv[] = { name, sub, msg };
+    TEST_ASSERT_LESS_THAN(CONSOLE_LINE_MAX, strlen(msg) + 11);
+    Serial.output.clear();
+    rulesCmd->handler(3, argv);
+    TEST_ASSERT_EQUAL(1, rules_count());
+    TEST_ASSERT_TRUE(sim::files.count(RULES_PATH));
+    TEST_ASSERT_NULL(strstr(Serial.output.c_str(), "Invalid"));
+
+    char bad[] = "{\"page\":\"rules\",\"value\":[{\"when\":{}}]}";
+    argv[2] = bad;
+    rulesCmd->handler(3, argv);
+    TEST_ASSERT_NOT_NULL(strstr(Serial.output.c_str(), "Invalid rules message"));
+    TEST_ASSERT_EQUAL(1, rules_count());
+}
+
+// Microbenchmark tren host, chi in ket qua: so lan danh gia/giay cua chuong trinh RULES_MAX rule
+// co hysteresis (so tuong doi; tren ESP32-S3 dung `rules bench`)
+static void test_bench(void) {
+    std::string src = "[";
+    for (int i = 0; i < RULES_MAX; i++) {
+        src += std::string(i ? "," : "") +
+               "{\"when\":{\"input\":\"" + (i & 1 ? "humidity" : "temperature") + "\",\"op\":\">\",\"value\":" +
+               std::to_string(20 + 5 * i) + ",\"hyst\":0.5},\"then\":{\"led\":\"warn\"}}";
+    }
+    // slot JSON tren host 64-bit lon gap doi ESP32 -> doc rieng lon hon RULES_JSON_DOC
+    static StaticJsonDocument<RULES_JSON_DOC * 2> big;
+    const char *err = NULL;
+    TEST_ASSERT_TRUE(deserializeJson(big, src + "]") == DeserializationError::Ok);
+    TEST_ASSERT_TRUE_MESSAGE(rules_compile(big.as<JsonVariantConst>(), &prog, &err), err);
+    TEST_ASSERT_EQUAL(RULES_MAX, prog.ruleCount);
+
+    const uint32_t n = 1u << 18;
+    volatile uint32_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++) {
+        float inputs[RULE_IN_COUNT] = { 20.0f + (i % 200) * 0.1f, 40.0f + (i % 500) * 0.1f, (float)(i % 128) };
+        rules_run(&prog, runLatch, runState, inputs, &fx);
+        sink += fx.fired;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%u rules, %u bytecode bytes: %.1f ns/eval, %.2f M evals/s",
+             (unsigned)prog.ruleCount, (unsigned)prog.codeLen, ns, 1000.0 / ns);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_GREATER_THAN(0, sink);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_hysteresis);
+    RUN_TEST(test_and_or_not);
+    RUN_TEST(test_depth_and_stack_limits);
+    RUN_TEST(test_compile_errors);
+    RUN_TEST(test_swap_and_clear_reset_state);
+    RUN_TEST(test_watch_keeps_min_max);
+    RUN_TEST(test_console_json);
+    RUN_TEST(test_bench);
+    return UNITY_END();
+}
@@ -0,0 +1,140 @@
+#include <unity.h>
+#include "../../src/sample_rate.cpp"
+#include "temp_humi_monitor.h"
+#include "traces.h"
+
+// Ket qua phat lai mot vet: so mau (~ nang luong, moi mau mot lan do DHT20) va sai so
+// khoi phuc giu-mau (sample-and-hold) so voi vet day du
+typedef struct {
+    uint32_t samples;
+    float    tempMax;
+    float    tempRms;
+    float    humiMax;
+    uint32_t staleMs;       // doan dai nhat sai so nhiet do > RATE_TEMP_RESOLUTION
+    float    watchMax;      // sai so nhiet do lon nhat khi vet cach nguong < RATE_WATCH_MARGIN
+} replay_t;
+
+typedef struct {
+    const char     *name;
+    const int16_t  *temp;
+    const uint16_t *humi;
+} trace_t;
+
+static const trace_t flat = { "flat", trace_flat_temp, trace_flat_humi };
+static const trace_t step = { "step", trace_step_temp, trace_step_humi };
+static const trace_t ramp = { "ramp", trace_ramp_temp, trace_ramp_humi };
+
+// adaptive = false: chu ky co dinh SENSOR_SAMPLE_PERIOD_MS nhu truoc khi co controller
+static replay_t replay(const trace_t *tr, bool adaptive, float watchHi) {
+    rate_ctrl_t c;
+    rate_ctrl_init(&c, RATE_MIN_PERIOD_MS, RATE_MAX_PERIOD_MS, SENSOR_SAMPLE_PERIOD_MS);
+    rate_ctrl_set_watch(&c, NAN, watchHi);
+
+    replay_t r = { 0, 0, 0, 0, 0, 0 };
+    double sq = 0;
+    uint32_t next = 0, staleStart = 0;
+    bool stale = false;
+    int16_t heldT = 0;
+    uint16_t heldH = 0;
+    for (uint32_t i = 0; i < TRACE_LEN; i++) {
+        uint32_t now = i * TRACE_STEP_MS;
+        // moi mau den han trong buoc nay deu doc gia tri hien tai cua vet
+        while (next < now + TRACE_STEP_MS) {
+            heldT = tr->temp[i];
+            heldH = tr->humi[i];
+            uint32_t period = adaptive ? rate_ctrl_update(&c, heldT * 0.01f, heldH * 0.01f, next)
+                                       : SENSOR_SAMPLE_PERIOD_MS;
+            next += period;
+            r.samples++;
+        }
+        float et = fabsf((tr->temp[i] - heldT) * 0.01f);
+        float eh = fabsf((tr->humi[i] - heldH) * 0.01f);
+        if (et > r.tempMax) r.tempMax = et;
+        if (eh > r.humiMax) r.humiMax = eh;
+        sq += (double)et * et;
+
+        if (et > RATE_TEMP_RESOLUTION + 0.001f) {
+            if (!stale) staleStart = now;
+            stale = true;
+            if (now + TRACE_STEP_MS - staleStart > r.staleMs) r.staleMs = now + TRACE_STEP_MS - staleStart;
+        } else {
+            stale = false;
+        }
+        if (!isnan(watchHi) && fabsf(tr->temp[i] * 0.01f - watchHi) < RATE_WATCH_MARGIN && et > r.watchMax) {
+            r.watchMax = et;
+        }
+    }
+    r.tempRms = (float)sqrt(sq / TRACE_LEN);
+    return r;
+}
+
+static void report(const char *name, const replay_t &fixed, const replay_t &adapt) {
+    char msg[256];
+    snprintf(msg, sizeof(msg),
+             "%-10s fixed %3u samples, T max %.2f rms %.3f, H max %.2f | "
+             "adaptive %4u samples (%3u%%), T max %.2f rms %.3f, H max %.2f, stale %lu s",
+             name, (unsigned)fixed.samples, fixed.tempMax, fixed.tempRms, fixed.humiMax,
+             (unsigned)adapt.samples, (unsigned)(adapt.samples * 100 / fixed.samples),
+             adapt.tempMax, adapt.tempRms, adapt.humiMax, (unsigned long)(adapt.staleMs / 1000));
+    TEST_MESSAGE(msg);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// Phong on dinh: gian ra toi RATE_MAX_PERIOD_MS, sai so van trong do phan giai
+static void test_flat_trace(void) {
+    replay_t fixed = replay(&flat, false, NAN);
+    replay_t adapt = replay(&flat, true, NAN);
+    report(flat.name, fixed, adapt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(fixed.samples / 10, adapt.samples);
+    TEST_ASSERT_TRUE(adapt.tempMax <= RATE_TEMP_RESOLUTION);
+    TEST_ASSERT_TRUE(adapt.humiMax <= RATE_HUMI_RESOLUTION);
+    TEST_ASSERT_EQUAL_UINT32(0, adapt.staleMs);
+}
+
+// Doi gia cua chu ky dai: buoc nhay sau mot doan phang chi thay duoc o mau ke tiep,
+// tre toi da RATE_MAX_PERIOD_MS; sau do controller rut chu ky ngay va bam kip
+static void test_step_trace(void) {
+    replay_t fixed = replay(&step, false, NAN);
+    replay_t adapt = replay(&step, true, NAN);
+    report(step.name, fixed, adapt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(fixed.samples / 10, adapt.samples);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(RATE_MAX_PERIOD_MS + TRACE_STEP_MS, adapt.staleMs);
+    TEST_ASSERT_TRUE(adapt.tempRms < 1.0f);
+}
+
+// Doc deu: chu ky theo do doc, sai so toi da khoang 1-2 lan do phan giai
+static void test_ramp_trace(void) {
+    replay_t fixed = replay(&ramp, false, NAN);
+    replay_t adapt = replay(&ramp, true, NAN);
+    report(ramp.name, fixed, adapt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(fixed.samples / 4, adapt.samples);
+    TEST_ASSERT_TRUE(adapt.tempMax <= 2 * RATE_TEMP_RESOLUTION);
+    TEST_ASSERT_TRUE(adapt.tempRms <= RATE_TEMP_RESOLUTION);
+}
+
+// Gan nguong canh bao: lay mau 1 s, chinh xac hon chu ky co dinh dung luc can.
+// Doi lai ton nhieu mau hon baseline trong ca doan 2 °C quanh nguong.
+static void test_ramp_near_watch(void) {
+    replay_t fixed = replay(&ramp, false, 30.0f);
+    replay_t adapt = replay(&ramp, true, 30.0f);
+    report("ramp+watch", fixed, adapt);
+    char msg[96];
+    snprintf(msg, sizeof(msg), "ramp+watch within %.1f C of 30 C: fixed T max %.2f, adaptive T max %.2f",
+             RATE_WATCH_MARGIN, fixed.watchMax, adapt.watchMax);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(adapt.watchMax <= fixed.watchMax);
+    TEST_ASSERT_TRUE(adapt.watchMax <= 0.05f);
+    TEST_ASSERT_GREATER_THAN_UINT32(replay(&ramp, true, NAN).samples, adapt.samples);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_flat_trace);
+    RUN_TEST(test_step_trace);
+    RUN_TEST(test_ramp_trace);
+    RUN_TEST(test_ramp_near_watch);
+    return UNITY_END();
+}
@@ -0,0 +1,568 @@
+// Vet DHT20 tong hop (khong phai ban ghi that): 2 s/mau, 45 phut, don vi 0.01.
+// Sinh mot lan bang script ngau nhien co seed co dinh roi check in, de test tai lap duoc.
+//   flat: phong on dinh, troi cham + nhieu luong tu hoa
+//   step: nhu flat, phut 30 bat may suoi: +2.5 °C / -6 %RH, hang so thoi gian 30 s
+//   ramp: 28 -> 33 °C deu trong 45 phut, cat nguong canh bao 30 °C
+#ifndef TRACES_H
+#define TRACES_H
+#include <stdint.h>
+
+#define TRACE_STEP_MS   2000
+#define TRACE_LEN       1350
+
+static const int16_t trace_flat_temp[TRACE_LEN] = {
+    2731, 2730, 2729, 2730, 2729, 2730, 2729, 2731, 2728, 2727, 2728, 2729, 2730, 2729, 2730,
+    2730, 2730, 2728, 2727, 2729, 2730, 2728, 2729, 2730, 2728, 2730, 2729, 2729, 2728, 2729,
+    2729, 2728, 2728, 2729, 2729, 2730, 2727, 2728, 2729, 2728, 2728, 2727, 2729, 2727, 2727,
+    2727, 2726, 2728, 2727, 2729, 2729, 2728, 2729, 2727, 2728, 2729, 2728, 2727, 2728, 2727,
+    2728, 2727, 2729, 2729, 2728, 2728, 2728, 2727, 2729, 2728, 2728, 2729, 2728, 2728, 2728,
+    2727, 2728, 2727, 2727, 2727, 2725, 2728, 2727, 2726, 2726, 2726, 2728, 2725, 2727, 2726,
+    2726, 2727, 2726, 2727, 2726, 2727, 2727, 2726, 2728, 2729, 2727, 2728, 2727, 2727, 2729,
+    2728, 2728, 2728, 2727, 2728, 2728, 2727, 2727, 2727, 2727, 2728, 2728, 2729, 2728, 2729,
+    2729, 2728, 2730, 2730, 2730, 2730, 2728, 2730, 2730, 2730, 2730, 2730, 2731, 2730, 2729,
+    2730, 2729, 2730, 2729, 2730, 2729, 2731, 2729, 2731, 2730, 2730, 2727, 2728, 2729, 2728,
+    2728, 2729, 2729, 2728, 2729, 2730, 2729, 2728, 2729, 2729, 2728, 2728, 2728, 2729, 2730,
+    2730, 2729, 2729, 2728, 2730, 2729, 2729, 2729, 2728, 2728, 2728, 2729, 2729, 2729, 2727,
+    2728, 2729, 2728, 2730, 2728, 2728, 2728, 2727, 2728, 2730, 2728, 2729, 2729, 2729, 2728,
+    2730, 2729, 2728, 2730, 2731, 2728, 2729, 2729, 2731, 2728, 2730, 2729, 2729, 2729, 2729,
+    2729, 2729, 2728, 2729, 2730, 2730, 2730, 2731, 2728, 2730, 2728, 2728, 2728, 2731, 2728,
+    2729, 2729, 2728, 2729, 2729, 2728, 2729, 2728, 2728, 2729, 2728, 2727, 2728, 2728, 2729,
+    2729, 2728, 2729, 2729, 2729, 2729, 2730, 2729, 2730, 2727, 2730, 2729, 2729, 2730, 2728,
+    2728, 2728, 2727, 2729, 2727, 2728, 2728, 2728, 2728, 2728, 2730, 2727, 2729, 2727, 2727,
+    2729, 2727, 2729, 2728, 2730, 2729, 2729, 2728, 2728, 2729, 2727, 2727, 2727, 2728, 2728,
+    2728, 2729, 2728, 2729, 2729, 2731, 2728, 2729, 2728, 2730, 2730, 2727, 2729, 2727, 2728,
+    2729, 2728, 2727, 2729, 2728, 2728, 2727, 2728, 2726, 2727, 2728, 2728, 2729, 2729, 2728,
+    2727, 2728, 2728, 2730, 2729, 2728, 2729, 2728, 2728, 2728, 2727, 2728, 2727, 2728, 2728,
+    2727, 2726, 2727, 2728, 2727, 2727, 2726, 2727, 2729, 2726, 2728, 2728, 2726, 2728, 2727,
+    2729, 2727, 2727, 2728, 2726, 2728, 2727, 2728, 2728, 2728, 2727, 2727, 2727, 2729, 2727,
+    2729, 2728, 2728, 2729, 2728, 2729, 2728, 2728, 2729, 2729, 2728, 2727, 2728, 2730, 2729,
+    2728, 2728, 2728, 2728, 2728, 2728, 2728, 2727, 2728, 2727, 2728, 2728, 2730, 2728, 2730,
+    2730, 2728, 2728, 2727, 2729, 2729, 2730, 2731, 2731, 2729, 2729, 2730, 2730, 2731, 2730,
+    2729, 2729, 2730, 2730, 2730, 2731, 2730, 2731, 2730, 2729, 2729, 2730, 2729, 2729, 2729,
+    2729, 2729, 2728, 2729, 2729, 2729, 2729, 2729, 2729, 2730, 2728, 2729, 2728, 2729, 2728,
+    2729, 2730, 2728, 2729, 2728, 2728, 2728, 2728, 2731, 2727, 2729, 2729, 2728, 2727, 2730,
+    2729, 2728, 2730, 2728, 2728, 2729, 2728, 2727, 2728, 2728, 2728, 2727, 2728, 2728, 2726,
+    2728, 2727, 2728, 2728, 2726, 2726, 2728, 2729, 2727, 2728, 2726, 2728, 2728, 2726, 2728,
+    2727, 2728, 2727, 2729, 2727, 2728, 2729, 2729, 2729, 2727, 2728, 2729, 2728, 2728, 2728,
+    2729, 2728, 2728, 2728, 2730, 2727, 2728, 2729, 2731, 2729, 2729, 2727, 2729, 2728, 2730,
+    2729, 2729, 2727, 2729, 2727, 2728, 2728, 2728, 2729, 2728, 2729, 2728, 2728, 2730, 2728,
+    2728, 2728, 2728, 2728, 2727, 2725, 2727, 2727, 2728, 2728, 2729, 2727, 2728, 2728, 2727,
+    2726, 2728, 2727, 2727, 2726, 2727, 2728, 2728, 2728, 2726, 2728, 2727, 2726, 2727, 2725,
+    2726, 2728, 2728, 2727, 2727, 2727, 2728, 2726, 2726, 2728, 2727, 2727, 2730, 2729, 2727,
+    2728, 2727, 2729, 2727, 2730, 2728, 2727, 2728, 2728, 2728, 2727, 2728, 2728, 2728, 2728,
+    2727, 2728, 2729, 2727, 2728, 2727, 2728, 2727, 2728, 2730, 2728, 2728, 2728, 2727, 2729,
+    2728, 2728, 2728, 2727, 2728, 2727, 2727, 2727, 2725, 2726, 2727, 2728, 2726, 2728, 2726,
+    2726, 2728, 2727, 2727, 2727, 2726, 2725, 2726, 2727, 2726, 2727, 2727, 2726, 2727, 2726,
+    2727, 2726, 2727, 2725, 2725, 2727, 2727, 2726, 2727, 2728, 2727, 2726, 2727, 2728, 2727,
+    2727, 2727, 2727, 2727, 2727, 2727, 2728, 2726, 2726, 2730, 2728, 2728, 2728, 2727, 2729,
+    2728, 2727, 2728, 2728, 2728, 2728, 2728, 2729, 2729, 2728, 2727, 2728, 2728, 2727, 2727,
+    2728, 2727, 2728, 2728, 2729, 2726, 2727, 2727, 2726, 2727, 2728, 2728, 2727, 2728, 2728,
+    2727, 2725, 2727, 2726, 2727, 2728, 2728, 2727, 2728, 2728, 2727, 2727, 2727, 2726, 2728,
+    2727, 2727, 2728, 2728, 2728, 2727, 2729, 2727, 2729, 2727, 2727, 2728, 2728, 2729, 2727,
+    2727, 2727, 2728, 2726, 2726, 2728, 2727, 2728, 2727, 2728, 2727, 2728, 2727, 2729, 2727,
+    2727, 2729, 2728, 2728, 2727, 2727, 2726, 2727, 2729, 2728, 2727, 2728, 2728, 2727, 2729,
+    2728, 2729, 2728, 2728, 2729, 2729, 2730, 2728, 2730, 2729, 2728, 2728, 2727, 2726, 2728,
+    2729, 2727, 2727, 2727, 2727, 2728, 2727, 2729, 2728, 2727, 2728, 2727, 2728, 2728, 2728,
+    2729, 2730, 2728, 2728, 2728, 2728, 2730, 2729, 2727, 2728, 2729, 2729, 2728, 2728, 2728,
+    2729, 2727, 2729, 2729, 2728, 2728, 2727, 2729, 2727, 2728, 2728, 2729, 2729, 2730, 2727,
+    2729, 2730, 2730, 2730, 2728, 2730, 2731, 2729, 2731, 2731, 2730, 2731, 2730, 2730, 2731,
+    2731, 2730, 2731, 2731, 2730, 2733, 2732, 2730, 2730, 2731, 2731, 2733, 2733, 2731, 2731,
+    2730, 2731, 2731, 2732, 2731, 2730, 2730, 2731, 2730, 2731, 2729, 2732, 2731, 2731, 2730,
+    2729, 2730, 2729, 2729, 2729, 2727, 2728, 2728, 2729, 2729, 2729, 2729, 2728, 2726, 2727,
+    2728, 2728, 2729, 2728, 2729, 2728, 2727, 2729, 2727, 2729, 2727, 2728, 2726, 2729, 2728,
+    2729, 2727, 2728, 2728, 2728, 2728, 2728, 2727, 2726, 2728, 2726, 2727, 2726, 2729, 2729,
+    2728, 2727, 2727, 2726, 2729, 2727, 2728, 2727, 2727, 2727, 2727, 2727, 2726, 2727, 2727,
+    2728, 2727, 2725, 2728, 2728, 2729, 2727, 2728, 2727, 2727, 2729, 2726, 2727, 2729, 2728,
+    2728, 2727, 2728, 2727, 2728, 2729, 2728, 2728, 2728, 2728, 2728, 2730, 2728, 2729, 2729,
+    2727, 2728, 2727, 2727, 2725, 2727, 2727, 2726, 2727, 2726, 2725, 2727, 2727, 2727, 2726,
+    2727, 2726, 2727, 2727, 2728, 2728, 2726, 2728, 2727, 2727, 2729, 2729, 2727, 2727, 2730,
+    2729, 2729, 2729, 2730, 2729, 2728, 2729, 2729, 2730, 2729, 2730, 2730, 2729, 2729, 2730,
+    2729, 2730, 2729, 2731, 2730, 2729, 2729, 2729, 2730, 2729, 2730, 2730, 2728, 2730, 2729,
+    2730, 2728, 2729, 2730, 2727, 2729, 2729, 2729, 2729, 2727, 2728, 2730, 2728, 2730, 2728,
+    2728, 2729, 2730, 2728, 2730, 2729, 2731, 2729, 2728, 2729, 2728, 2728, 2729, 2728, 2729,
+    2729, 2728, 2729, 2728, 2729, 2731, 2731, 2729, 2728, 2730, 2730, 2731, 2729, 2730, 2730,
+    2731, 2732, 2731, 2730, 2731, 2730, 2730, 2730, 2729, 2730, 2730, 2730, 2730, 2731, 2729,
+    2731, 2729, 2731, 2730, 2729, 2731, 2730, 2730, 2729, 2730, 2731, 2729, 2729, 2731, 2728,
+    2728, 2730, 2729, 2728, 2730, 2729, 2728, 2728, 2729, 2730, 2729, 2728, 2728, 2728, 2726,
+    2727, 2728, 2728, 2728, 2729, 2727, 2729, 2728, 2727, 2729, 2728, 2728, 2727, 2727, 2727,
+    2728, 2728, 2727, 2729, 2729, 2727, 2727, 2727, 2726, 2728, 2728, 2729, 2727, 2727, 2728,
+    2727, 2728, 2729, 2729, 2729, 2729, 2728, 2728, 2728, 2726, 2728, 2727, 2728, 2728, 2727,
+    2727, 2727, 2728, 2727, 2728, 2727, 2726, 2727, 2727, 2726, 2726, 2727, 2728, 2727, 2728,
+    2727, 2727, 2727, 2726, 2728, 2726, 2726, 2727, 2727, 2726, 2728, 2727, 2725, 2727, 2726,
+    2727, 2728, 2727, 2727, 2726, 2727, 2727, 2727, 2727, 2728, 2727, 2729, 2727, 2727, 2727,
+    2727, 2728, 2727, 2728, 2728, 2727, 2728, 2728, 2730, 2729, 2728, 2729, 2729, 2727, 2729,
+    2729, 2730, 2728, 2729, 2729, 2728, 2728, 2727, 2729, 2728, 2729, 2729, 2727, 2729, 2729,
+    2729, 2729, 2728, 2727, 2729, 2729, 2730, 2727, 2728, 2729, 2728, 2729, 2729, 2728, 2729,
+    2729, 2729, 2729, 2728, 2728, 2727, 2728, 2725, 2727, 2725, 2726, 2726, 2726, 2727, 2727,
+    2726, 2727, 2728, 2726, 2725, 2726, 2726, 2725, 2726, 2726, 2726, 2725, 2726, 2725, 2726,
+    2725, 2724, 2726, 2728, 2727, 2725, 2727, 2729, 2726, 2727, 2727, 2727, 2728, 2727, 2728,
+    2725, 2727, 2728, 2725, 2726, 2727, 2727, 2727, 2727, 2726, 2726, 2727, 2726, 2726, 2727,
+    2725, 2727, 2726, 2727, 2727, 2728, 2726, 2725, 2726, 2725, 2727, 2727, 2727, 2725, 2727,
+    2726, 2725, 2727, 2727, 2726, 2726, 2727, 2724, 2725, 2726, 2725, 2725, 2724, 2724, 2724,
+    2724, 2725, 2725, 2725, 2724, 2724, 2723, 2724, 2723, 2724, 2724, 2724, 2723, 2722, 2723,
+    2722, 2722, 2721, 2722, 2722, 2722, 2721, 2723, 2723, 2723, 2722, 2723, 2722, 2722, 2722,
+};
+static const uint16_t trace_flat_humi[TRACE_LEN] = {
+    6198, 6192, 6198, 6210, 6208, 6205, 6203, 6202, 6202, 6203, 6201, 6206, 6195, 6193, 6202,
+    6210, 6201, 6204, 6205, 6199, 6204, 6197, 6208, 6204, 6208, 6200, 6208, 6205, 6208, 6208,
+    6200, 6207, 6201, 6208, 6210, 6207, 6212, 6206, 6201, 6208, 6203, 6208, 6213, 6205, 6213,
+    6207, 6206, 6202, 6202, 6203, 6212, 6207, 6201, 6208, 6202, 6202, 6203, 6204, 6206, 6209,
+    6208, 6209, 6202, 6202, 6204, 6212, 6208, 6208, 6212, 6200, 6210, 6200, 6208, 6207, 6208,
+    6203, 6199, 6210, 6212, 6211, 6212, 6215, 6208, 6213, 6209, 6212, 6203, 6207, 6215, 6212,
+    6208, 6206, 6207, 6212, 6207, 6209, 6214, 6210, 6207, 6213, 6215, 6210, 6201, 6209, 6203,
+    6205, 6206, 6203, 6208, 6198, 6208, 6206, 6209, 6209, 6203, 6204, 6199, 6198, 6200, 6205,
+    6201, 6202, 6203, 6201, 6202, 6211, 6201, 6209, 6203, 6196, 6194, 6204, 6197, 6194, 6201,
+    6200, 6199, 6204, 6197, 6200, 6196, 6199, 6205, 6196, 6202, 6210, 6209, 6202, 6204, 6209,
+    6209, 6205, 6198, 6202, 6202, 6201, 6199, 6200, 6201, 6211, 6205, 6202, 6203, 6193, 6203,
+    6198, 6202, 6199, 6200, 6202, 6198, 6208, 6208, 6213, 6200, 6209, 6205, 6203, 6210, 6205,
+    6206, 6208, 6210, 6202, 6209, 6205, 6206, 6198, 6209, 6204, 6199, 6205, 6196, 6205, 6206,
+    6201, 6200, 6207, 6208, 6199, 6206, 6205, 6204, 6198, 6205, 6207, 6198, 6202, 6199, 6206,
+    6202, 6192, 6207, 6200, 6204, 6200, 6205, 6209, 6207, 6200, 6196, 6198, 6203, 6202, 6202,
+    6202, 6203, 6200, 6206, 6205, 6202, 6211, 6200, 6213, 6202, 6203, 6211, 6202, 6196, 6206,
+    6203, 6206, 6205, 6209, 6207, 6205, 6197, 6206, 6201, 6205, 6206, 6208, 6202, 6206, 6202,
+    6206, 6213, 6206, 6203, 6210, 6208, 6203, 6207, 6203, 6206, 6204, 6208, 6210, 6211, 6209,
+    6203, 6205, 6209, 6203, 6207, 6208, 6206, 6204, 6207, 6210, 6201, 6201, 6203, 6205, 6203,
+    6211, 6205, 6205, 6203, 6207, 6197, 6208, 6205, 6210, 6194, 6202, 6210, 6203, 6200, 6200,
+    6207, 6205, 6205, 6208, 6203, 6211, 6207, 6210, 6203, 6207, 6201, 6211, 6201, 6205, 6208,
+    6210, 6201, 6204, 6214, 6199, 6210, 6205, 6207, 6204, 6206, 6209, 6207, 6206, 6207, 6212,
+    6203, 6204, 6198, 6206, 6211, 6206, 6196, 6208, 6214, 6212, 6205, 6203, 6209, 6205, 6205,
+    6200, 6209, 6209, 6205, 6214, 6215, 6206, 6207, 6205, 6210, 6207, 6213, 6202, 6210, 6204,
+    6205, 6203, 6205, 6202, 6204, 6204, 6205, 6210, 6201, 6194, 6207, 6199, 6205, 6207, 6201,
+    6207, 6193, 6199, 6206, 6200, 6215, 6207, 6199, 6212, 6205, 6207, 6202, 6207, 6203, 6201,
+    6201, 6209, 6209, 6204, 6195, 6206, 6196, 6198, 6207, 6201, 6198, 6192, 6202, 6201, 6200,
+    6205, 6204, 6197, 6207, 6201, 6204, 6201, 6201, 6206, 6205, 6204, 6202, 6199, 6201, 6206,
+    6201, 6205, 6202, 6199, 6206, 6205, 6206, 6200, 6200, 6204, 6200, 6206, 6201, 6205, 6201,
+    6204, 6207, 6208, 6208, 6209, 6200, 6198, 6201, 6199, 6205, 6208, 6211, 6199, 6197, 6200,
+    6202, 6201, 6206, 6210, 6190, 6202, 6207, 6206, 6203, 6213, 6210, 6207, 6199, 6210, 6203,
+    6209, 6210, 6205, 6209, 6208, 6211, 6207, 6209, 6207, 6219, 6210, 6211, 6213, 6204, 6200,
+    6204, 6208, 6209, 6207, 6206, 6214, 6208, 6209, 6199, 6205, 6203, 6198, 6200, 6203, 6203,
+    6208, 6203, 6208, 6209, 6207, 6195, 6201, 6208, 6208, 6205, 6210, 6203, 6208, 6208, 6206,
+    6213, 6207, 6206, 6199, 6199, 6201, 6206, 6207, 6203, 6207, 6203, 6212, 6203, 6212, 6202,
+    6201, 6207, 6205, 6206, 6211, 6204, 6200, 6206, 6208, 6212, 6201, 6204, 6210, 6208, 6205,
+    6205, 6205, 6207, 6205, 6213, 6208, 6210, 6206, 6203, 6204, 6211, 6210, 6214, 6214, 6214,
+    6205, 6204, 6205, 6204, 6208, 6213, 6209, 6208, 6212, 6208, 6207, 6205, 6206, 6208, 6198,
+    6195, 6206, 6203, 6203, 6206, 6210, 6207, 6213, 6210, 6199, 6205, 6204, 6216, 6202, 6205,
+    6205, 6200, 6199, 6203, 6205, 6205, 6208, 6211, 6208, 6205, 6211, 6213, 6206, 6211, 6206,
+    6208, 6204, 6208, 6207, 6210, 6206, 6214, 6215, 6209, 6206, 6206, 6208, 6211, 6208, 6209,
+    6212, 6215, 6212, 6211, 6218, 6218, 6211, 6213, 6202, 6213, 6203, 6215, 6213, 6219, 6218,
+    6214, 6212, 6211, 6210, 6204, 6212, 6212, 6213, 6211, 6207, 6205, 6206, 6202, 6209, 6207,
+    6208, 6207, 6203, 6205, 6212, 6206, 6212, 6209, 6203, 6207, 6200, 6208, 6209, 6201, 6206,
+    6217, 6201, 6208, 6204, 6217, 6203, 6209, 6210, 6208, 6205, 6210, 6205, 6207, 6212, 6213,
+    6207, 6203, 6208, 6207, 6205, 6213, 6211, 6216, 6213, 6210, 6212, 6212, 6208, 6211, 6211,
+    6212, 6206, 6207, 6205, 6213, 6211, 6205, 6212, 6205, 6205, 6214, 6207, 6212, 6208, 6209,
+    6210, 6204, 6207, 6214, 6202, 6203, 6212, 6209, 6210, 6209, 6204, 6207, 6204, 6208, 6211,
+    6207, 6208, 6209, 6207, 6205, 6208, 6206, 6211, 6208, 6208, 6209, 6209, 6210, 6206, 6213,
+    6208, 6204, 6216, 6204, 6210, 6210, 6195, 6213, 6210, 6206, 6208, 6207, 6208, 6212, 6213,
+    6200, 6204, 6205, 6201, 6208, 6205, 6214, 6206, 6207, 6206, 6203, 6206, 6209, 6204, 6199,
+    6206, 6208, 6211, 6208, 6206, 6206, 6214, 6202, 6206, 6217, 6207, 6206, 6211, 6206, 6209,
+    6209, 6204, 6207, 6206, 6205, 6198, 6204, 6204, 6204, 6204, 6208, 6211, 6208, 6204, 6210,
+    6205, 6209, 6201, 6210, 6208, 6208, 6205, 6208, 6200, 6202, 6203, 6200, 6207, 6211, 6205,
+    6199, 6198, 6202, 6195, 6201, 6205, 6205, 6196, 6202, 6200, 6202, 6201, 6205, 6201, 6203,
+    6201, 6201, 6200, 6197, 6195, 6203, 6196, 6200, 6201, 6198, 6193, 6202, 6197, 6202, 6194,
+    6193, 6190, 6199, 6201, 6197, 6199, 6195, 6199, 6192, 6197, 6199, 6199, 6201, 6207, 6205,
+    6211, 6211, 6200, 6200, 6204, 6202, 6203, 6206, 6204, 6200, 6202, 6208, 6199, 6211, 6204,
+    6210, 6208, 6206, 6211, 6206, 6205, 6213, 6198, 6207, 6206, 6204, 6207, 6202, 6206, 6208,
+    6203, 6204, 6197, 6203, 6204, 6201, 6211, 6204, 6209, 6205, 6203, 6215, 6209, 6213, 6212,
+    6203, 6211, 6210, 6208, 6201, 6209, 6208, 6211, 6205, 6212, 6210, 6213, 6211, 6202, 6207,
+    6218, 6208, 6211, 6212, 6211, 6211, 6207, 6205, 6212, 6197, 6212, 6208, 6205, 6208, 6206,
+    6209, 6203, 6210, 6214, 6211, 6210, 6206, 6219, 6204, 6205, 6207, 6206, 6204, 6212, 6201,
+    6209, 6210, 6210, 6208, 6205, 6210, 6216, 6207, 6209, 6204, 6211, 6211, 6208, 6212, 6210,
+    6206, 6208, 6206, 6209, 6213, 6205, 6209, 6210, 6203, 6201, 6200, 6206, 6208, 6207, 6204,
+    6205, 6213, 6204, 6204, 6202, 6206, 6200, 6199, 6203, 6206, 6200, 6200, 6197, 6205, 6202,
+    6203, 6203, 6212, 6200, 6194, 6199, 6201, 6199, 6205, 6200, 6202, 6208, 6205, 6199, 6205,
+    6201, 6204, 6202, 6208, 6201, 6206, 6197, 6203, 6205, 6200, 6205, 6209, 6203, 6204, 6204,
+    6203, 6211, 6202, 6204, 6207, 6199, 6193, 6202, 6197, 6211, 6192, 6201, 6200, 6209, 6203,
+    6206, 6204, 6197, 6203, 6201, 6199, 6195, 6206, 6206, 6197, 6197, 6204, 6199, 6198, 6200,
+    6200, 6200, 6198, 6197, 6197, 6202, 6198, 6196, 6201, 6205, 6207, 6199, 6204, 6200, 6201,
+    6199, 6198, 6200, 6206, 6201, 6196, 6196, 6201, 6203, 6210, 6202, 6202, 6202, 6199, 6202,
+    6207, 6202, 6206, 6202, 6206, 6206, 6202, 6207, 6207, 6204, 6205, 6205, 6205, 6207, 6210,
+    6201, 6204, 6203, 6206, 6207, 6209, 6216, 6209, 6209, 6205, 6202, 6203, 6204, 6199, 6204,
+    6199, 6211, 6206, 6209, 6204, 6205, 6207, 6200, 6209, 6214, 6215, 6211, 6205, 6200, 6206,
+    6204, 6210, 6204, 6204, 6202, 6202, 6207, 6201, 6203, 6206, 6205, 6210, 6212, 6211, 6209,
+    6209, 6217, 6210, 6201, 6219, 6211, 6213, 6208, 6212, 6215, 6207, 6208, 6206, 6214, 6216,
+    6203, 6210, 6206, 6210, 6213, 6210, 6211, 6205, 6205, 6212, 6226, 6211, 6215, 6217, 6203,
+    6200, 6206, 6207, 6208, 6212, 6205, 6206, 6210, 6203, 6211, 6208, 6203, 6207, 6210, 6206,
+    6207, 6207, 6198, 6214, 6205, 6204, 6203, 6208, 6210, 6207, 6207, 6203, 6201, 6206, 6208,
+    6210, 6203, 6211, 6203, 6211, 6201, 6208, 6208, 6202, 6198, 6207, 6208, 6207, 6209, 6204,
+    6204, 6203, 6199, 6205, 6207, 6207, 6202, 6203, 6198, 6211, 6204, 6209, 6201, 6208, 6205,
+    6204, 6211, 6194, 6206, 6205, 6208, 6205, 6208, 6215, 6214, 6211, 6210, 6201, 6207, 6208,
+    6213, 6216, 6215, 6212, 6213, 6214, 6214, 6218, 6212, 6212, 6213, 6209, 6217, 6219, 6218,
+    6210, 6211, 6212, 6207, 6213, 6208, 6210, 6208, 6210, 6214, 6214, 6205, 6211, 6207, 6207,
+    6214, 6214, 6214, 6208, 6212, 6209, 6215, 6220, 6205, 6214, 6213, 6214, 6215, 6216, 6207,
+    6209, 6210, 6205, 6209, 6205, 6209, 6213, 6221, 6209, 6213, 6218, 6216, 6202, 6208, 6214,
+    6212, 6216, 6217, 6219, 6212, 6220, 6211, 6216, 6215, 6216, 6209, 6223, 6213, 6219, 6222,
+    6223, 6213, 6221, 6216, 6222, 6228, 6224, 6222, 6220, 6222, 6221, 6217, 6227, 6225, 6216,
+    6222, 6216, 6221, 6227, 6221, 6225, 6217, 6224, 6221, 6226, 6223, 6223, 6221, 6225, 6226,
+};
+
+static const int16_t trace_step_temp[TRACE_LEN] = {
+    2731, 2730, 2730, 2729, 2729, 2729, 2729, 2729, 2728, 2728, 2728, 2729, 2728, 2728, 2728,
+    2729, 2727, 2727, 2727, 2727, 2727, 2727, 2727, 2728, 2727, 2729, 2728, 2728, 2727, 2729,
+    2727, 2728, 2728, 2727, 2726, 2728, 2727, 2726, 2729, 2729, 2729, 2728, 2729, 2729, 2729,
+    2729, 2729, 2728, 2729, 2727, 2728, 2728, 2727, 2727, 2726, 2728, 2728, 2728, 2728, 2728,
+    2727, 2727, 2728, 2728, 2727, 2727, 2727, 2727, 2726, 2727, 2726, 2727, 2727, 2726, 2725,
+    2726, 2726, 2724, 2725, 2727, 2727, 2726, 2727, 2727, 2726, 2727, 2727, 2728, 2725, 2727,
+    2726, 2727, 2726, 2728, 2727, 2727, 2727, 2726, 2728, 2726, 2728, 2726, 2728, 2726, 2728,
+    2727, 2727, 2728, 2726, 2727, 2728, 2728, 2727, 2728, 2728, 2728, 2728, 2727, 2728, 2729,
+    2728, 2728, 2728, 2726, 2729, 2730, 2728, 2728, 2729, 2727, 2728, 2727, 2729, 2728, 2728,
+    2728, 2729, 2729, 2727, 2727, 2728, 2727, 2726, 2728, 2728, 2727, 2726, 2729, 2728, 2727,
+    2726, 2728, 2728, 2726, 2728, 2726, 2727, 2728, 2726, 2726, 2729, 2725, 2728, 2728, 2727,
+    2727, 2728, 2727, 2726, 2726, 2726, 2726, 2726, 2725, 2725, 2724, 2725, 2726, 2726, 2725,
+    2725, 2728, 2726, 2726, 2726, 2725, 2726, 2727, 2726, 2726, 2726, 2728, 2726, 2727, 2728,
+    2726, 2727, 2725, 2726, 2726, 2727, 2725, 2725, 2725, 2725, 2725, 2726, 2725, 2725, 2724,
+    2725, 2726, 2725, 2726, 2726, 2724, 2725, 2724, 2726, 2726, 2725, 2725, 2725, 2725, 2727,
+    2726, 2726, 2724, 2725, 2726, 2726, 2724, 2725, 2724, 2725, 2724, 2725, 2724, 2723, 2722,
+    2724, 2724, 2724, 2722, 2723, 2723, 2723, 2723, 2724, 2723, 2724, 2725, 2725, 2724, 2723,
+    2724, 2724, 2724, 2723, 2724, 2724, 2725, 2724, 2726, 2725, 2724, 2723, 2724, 2724, 2724,
+    2722, 2725, 2725, 2724, 2724, 2724, 2725, 2724, 2724, 2723, 2725, 2724, 2725, 2725, 2725,
+    2724, 2723, 2724, 2724, 2724, 2723, 2724, 2725, 2723, 2725, 2725, 2724, 2724, 2725, 2723,
+    2723, 2724, 2725, 2723, 2723, 2722, 2724, 2723, 2724, 2723, 2724, 2724, 2724, 2724, 2724,
+    2725, 2723, 2723, 2725, 2725, 2722, 2723, 2723, 2724, 2724, 2724, 2724, 2724, 2724, 2725,
+    2724, 2725, 2726, 2724, 2723, 2723, 2725, 2724, 2725, 2725, 2724, 2724, 2724, 2724, 2726,
+    2726, 2726, 2724, 2724, 2725, 2725, 2726, 2725, 2726, 2724, 2724, 2725, 2724, 2725, 2725,
+    2724, 2725, 2725, 2725, 2723, 2724, 2725, 2725, 2724, 2725, 2725, 2726, 2726, 2724, 2724,
+    2724, 2725, 2725, 2724, 2724, 2725, 2726, 2725, 2724, 2725, 2725, 2726, 2726, 2725, 2726,
+    2726, 2725, 2724, 2725, 2726, 2724, 2725, 2726, 2726, 2725, 2725, 2725, 2726, 2725, 2726,
+    2726, 2725, 2726, 2727, 2725, 2726, 2725, 2726, 2726, 2726, 2727, 2727, 2726, 2727, 2727,
+    2725, 2725, 2725, 2724, 2724, 2726, 2726, 2726, 2724, 2725, 2725, 2728, 2726, 2728, 2726,
+    2726, 2726, 2725, 2727, 2727, 2727, 2725, 2727, 2727, 2727, 2727, 2725, 2727, 2729, 2728,
+    2728, 2729, 2728, 2728, 2726, 2728, 2726, 2729, 2729, 2728, 2728, 2728, 2728, 2726, 2729,
+    2728, 2728, 2729, 2727, 2726, 2728, 2728, 2728, 2728, 2728, 2728, 2726, 2727, 2727, 2729,
+    2728, 2728, 2728, 2729, 2727, 2726, 2728, 2729, 2728, 2727, 2727, 2728, 2728, 2728, 2727,
+    2728, 2727, 2726, 2727, 2727, 2726, 2728, 2729, 2725, 2726, 2727, 2727, 2727, 2726, 2728,
+    2726, 2727, 2726, 2727, 2726, 2726, 2727, 2725, 2727, 2726, 2726, 2727, 2725, 2726, 2724,
+    2724, 2724, 2726, 2725, 2725, 2725, 2725, 2726, 2725, 2726, 2724, 2724, 2726, 2725, 2724,
+    2725, 2724, 2725, 2724, 2726, 2726, 2724, 2724, 2725, 2725, 2725, 2727, 2726, 2725, 2725,
+    2725, 2726, 2727, 2726, 2726, 2725, 2726, 2726, 2724, 2726, 2727, 2725, 2725, 2725, 2726,
+    2725, 2726, 2726, 2727, 2725, 2725, 2726, 2726, 2727, 2727, 2727, 2726, 2726, 2726, 2727,
+    2727, 2725, 2726, 2727, 2727, 2727, 2728, 2728, 2727, 2727, 2728, 2728, 2729, 2728, 2728,
+    2728, 2727, 2727, 2728, 2727, 2727, 2728, 2727, 2728, 2727, 2728, 2729, 2729, 2726, 2727,
+    2728, 2727, 2726, 2728, 2727, 2726, 2727, 2725, 2726, 2725, 2725, 2726, 2728, 2726, 2727,
+    2726, 2728, 2725, 2726, 2726, 2725, 2727, 2725, 2725, 2724, 2724, 2726, 2725, 2724, 2726,
+    2725, 2725, 2724, 2726, 2724, 2723, 2723, 2724, 2725, 2723, 2723, 2723, 2722, 2722, 2725,
+    2725, 2724, 2724, 2725, 2723, 2724, 2723, 2724, 2724, 2725, 2723, 2722, 2723, 2724, 2725,
+    2724, 2723, 2725, 2723, 2724, 2722, 2725, 2724, 2721, 2723, 2723, 2722, 2722, 2725, 2726,
+    2723, 2723, 2723, 2724, 2724, 2723, 2722, 2721, 2722, 2723, 2722, 2721, 2722, 2722, 2723,
+    2722, 2721, 2722, 2722, 2722, 2723, 2723, 2723, 2723, 2725, 2724, 2725, 2724, 2722, 2722,
+    2723, 2724, 2724, 2724, 2723, 2723, 2723, 2723, 2724, 2723, 2724, 2723, 2725, 2724, 2725,
+    2724, 2725, 2726, 2725, 2724, 2725, 2726, 2726, 2724, 2725, 2725, 2726, 2725, 2726, 2725,
+    2725, 2724, 2725, 2725, 2726, 2727, 2726, 2724, 2724, 2725, 2726, 2725, 2726, 2725, 2724,
+    2724, 2725, 2722, 2723, 2727, 2725, 2725, 2725, 2724, 2725, 2723, 2724, 2724, 2724, 2725,
+    2725, 2726, 2725, 2725, 2725, 2724, 2726, 2724, 2725, 2726, 2726, 2725, 2726, 2724, 2725,
+    2726, 2726, 2725, 2726, 2726, 2726, 2726, 2726, 2725, 2726, 2726, 2728, 2726, 2727, 2725,
+    2727, 2724, 2725, 2726, 2726, 2727, 2725, 2727, 2725, 2727, 2726, 2727, 2727, 2725, 2726,
+    2728, 2728, 2727, 2727, 2726, 2727, 2725, 2726, 2728, 2726, 2729, 2728, 2727, 2728, 2729,
+    2728, 2727, 2727, 2729, 2727, 2728, 2728, 2728, 2728, 2729, 2727, 2728, 2727, 2728, 2727,
+    2728, 2727, 2726, 2726, 2727, 2726, 2726, 2726, 2726, 2726, 2727, 2726, 2726, 2727, 2724,
+    2725, 2726, 2726, 2725, 2726, 2726, 2725, 2725, 2726, 2725, 2725, 2729, 2728, 2727, 2727,
+    2725, 2725, 2726, 2725, 2726, 2726, 2726, 2725, 2725, 2727, 2726, 2727, 2724, 2727, 2727,
+    2724, 2742, 2759, 2773, 2784, 2797, 2807, 2820, 2829, 2839, 2848, 2856, 2863, 2872, 2877,
+    2883, 2890, 2896, 2900, 2906, 2910, 2914, 2919, 2922, 2926, 2930, 2931, 2934, 2937, 2938,
+    2942, 2945, 2945, 2947, 2950, 2951, 2953, 2953, 2955, 2955, 2956, 2958, 2960, 2960, 2961,
+    2961, 2962, 2963, 2963, 2965, 2964, 2966, 2968, 2967, 2968, 2967, 2969, 2969, 2971, 2969,
+    2971, 2971, 2973, 2973, 2971, 2973, 2971, 2973, 2972, 2973, 2973, 2972, 2974, 2972, 2973,
+    2973, 2974, 2973, 2974, 2974, 2974, 2973, 2973, 2975, 2973, 2973, 2971, 2975, 2974, 2975,
+    2973, 2973, 2974, 2975, 2975, 2975, 2975, 2974, 2975, 2974, 2975, 2975, 2975, 2975, 2974,
+    2975, 2974, 2976, 2974, 2974, 2975, 2976, 2975, 2975, 2977, 2976, 2976, 2975, 2976, 2976,
+    2977, 2976, 2977, 2976, 2975, 2977, 2975, 2975, 2975, 2976, 2977, 2975, 2977, 2976, 2974,
+    2976, 2975, 2976, 2974, 2976, 2974, 2974, 2973, 2974, 2975, 2975, 2974, 2974, 2974, 2974,
+    2974, 2975, 2974, 2972, 2976, 2975, 2974, 2974, 2975, 2975, 2976, 2976, 2974, 2975, 2974,
+    2975, 2974, 2976, 2975, 2976, 2976, 2975, 2974, 2974, 2976, 2976, 2977, 2975, 2976, 2975,
+    2976, 2973, 2975, 2975, 2976, 2975, 2974, 2974, 2975, 2976, 2974, 2974, 2975, 2974, 2975,
+    2976, 2975, 2975, 2974, 2975, 2975, 2973, 2974, 2974, 2975, 2974, 2974, 2974, 2976, 2975,
+    2976, 2974, 2975, 2975, 2975, 2977, 2974, 2976, 2976, 2976, 2975, 2974, 2976, 2976, 2975,
+    2975, 2974, 2975, 2976, 2975, 2975, 2975, 2975, 2975, 2974, 2975, 2975, 2974, 2973, 2974,
+    2973, 2973, 2974, 2973, 2973, 2975, 2974, 2973, 2973, 2974, 2973, 2975, 2973, 2975, 2975,
+    2974, 2974, 2973, 2975, 2974, 2974, 2973, 2973, 2974, 2975, 2974, 2973, 2974, 2972, 2974,
+    2973, 2974, 2975, 2974, 2975, 2975, 2974, 2973, 2975, 2975, 2976, 2973, 2974, 2974, 2975,
+    2975, 2976, 2974, 2976, 2974, 2974, 2975, 2976, 2973, 2975, 2975, 2974, 2974, 2973, 2974,
+    2973, 2973, 2974, 2973, 2974, 2972, 2972, 2972, 2975, 2975, 2974, 2974, 2976, 2974, 2976,
+    2975, 2974, 2975, 2976, 2976, 2975, 2974, 2976, 2975, 2975, 2975, 2976, 2974, 2975, 2973,
+    2975, 2974, 2975, 2972, 2976, 2974, 2975, 2975, 2975, 2974, 2975, 2974, 2974, 2975, 2975,
+    2975, 2975, 2975, 2973, 2973, 2976, 2974, 2973, 2974, 2975, 2974, 2974, 2975, 2974, 2975,
+    2975, 2975, 2976, 2976, 2976, 2976, 2975, 2975, 2976, 2975, 2974, 2975, 2976, 2975, 2975,
+    2975, 2976, 2976, 2976, 2974, 2975, 2976, 2975, 2976, 2976, 2976, 2976, 2976, 2975, 2976,
+    2975, 2977, 2976, 2976, 2975, 2975, 2975, 2974, 2975, 2976, 2976, 2975, 2974, 2974, 2975,
+    2975, 2973, 2975, 2975, 2975, 2976, 2977, 2974, 2975, 2975, 2976, 2976, 2978, 2977, 2977,
+    2976, 2976, 2975, 2977, 2977, 2977, 2977, 2976, 2976, 2976, 2976, 2976, 2977, 2976, 2977,
+    2976, 2977, 2976, 2975, 2976, 2976, 2977, 2978, 2977, 2975, 2977, 2976, 2978, 2976, 2978,
+};
+static const uint16_t trace_step_humi[TRACE_LEN] = {
+    6206, 6201, 6205, 6207, 6199, 6201, 6204, 6212, 6211, 6199, 6202, 6205, 6208, 6208, 6212,
+    6205, 6203, 6199, 6203, 6208, 6204, 6211, 6203, 6213, 6206, 6207, 6206, 6208, 6206, 6210,
+    6204, 6201, 6213, 6206, 6208, 6204, 6213, 6204, 6208, 6203, 6205, 6206, 6207, 6211, 6207,
+    6205, 6212, 6212, 6213, 6208, 6207, 6211, 6209, 6212, 6208, 6216, 6206, 6209, 6207, 6210,
+    6206, 6208, 6211, 6209, 6207, 6210, 6210, 6209, 6209, 6211, 6213, 6214, 6213, 6212, 6212,
+    6217, 6216, 6210, 6215, 6214, 6210, 6215, 6216, 6210, 6208, 6213, 6206, 6211, 6216, 6211,
+    6212, 6210, 6203, 6211, 6207, 6202, 6216, 6207, 6207, 6206, 6212, 6201, 6204, 6205, 6204,
+    6207, 6207, 6205, 6204, 6208, 6209, 6215, 6212, 6210, 6206, 6207, 6206, 6208, 6201, 6205,
+    6209, 6206, 6202, 6200, 6199, 6205, 6210, 6209, 6206, 6205, 6211, 6203, 6211, 6209, 6202,
+    6202, 6206, 6209, 6209, 6208, 6210, 6201, 6206, 6205, 6214, 6204, 6207, 6206, 6216, 6209,
+    6210, 6205, 6213, 6213, 6211, 6203, 6204, 6207, 6208, 6201, 6217, 6211, 6210, 6210, 6209,
+    6212, 6204, 6207, 6216, 6214, 6206, 6208, 6211, 6211, 6213, 6206, 6205, 6208, 6211, 6212,
+    6216, 6211, 6204, 6218, 6213, 6214, 6213, 6210, 6210, 6214, 6209, 6211, 6210, 6210, 6210,
+    6215, 6212, 6212, 6216, 6211, 6209, 6215, 6211, 6219, 6210, 6217, 6211, 6218, 6214, 6210,
+    6218, 6209, 6220, 6213, 6214, 6212, 6204, 6217, 6219, 6219, 6218, 6208, 6211, 6218, 6217,
+    6213, 6214, 6221, 6213, 6219, 6219, 6215, 6220, 6216, 6218, 6212, 6219, 6214, 6221, 6218,
+    6219, 6221, 6217, 6217, 6215, 6211, 6212, 6219, 6221, 6221, 6221, 6213, 6218, 6219, 6218,
+    6218, 6225, 6218, 6204, 6220, 6213, 6220, 6208, 6218, 6210, 6218, 6226, 6214, 6216, 6217,
+    6218, 6221, 6213, 6221, 6219, 6223, 6226, 6217, 6222, 6218, 6221, 6218, 6216, 6221, 6216,
+    6218, 6225, 6222, 6220, 6217, 6219, 6215, 6212, 6213, 6214, 6213, 6218, 6221, 6212, 6213,
+    6222, 6220, 6218, 6217, 6219, 6219, 6220, 6222, 6221, 6218, 6207, 6211, 6220, 6217, 6223,
+    6216, 6217, 6219, 6219, 6223, 6219, 6219, 6220, 6224, 6208, 6214, 6213, 6222, 6213, 6212,
+    6207, 6214, 6215, 6222, 6220, 6220, 6221, 6215, 6221, 6215, 6217, 6214, 6217, 6215, 6220,
+    6218, 6218, 6217, 6214, 6214, 6210, 6207, 6219, 6217, 6209, 6213, 6212, 6214, 6216, 6210,
+    6223, 6217, 6215, 6214, 6215, 6219, 6216, 6212, 6212, 6219, 6210, 6213, 6224, 6221, 6211,
+    6209, 6214, 6214, 6222, 6214, 6218, 6212, 6216, 6215, 6220, 6216, 6211, 6219, 6215, 6214,
+    6216, 6220, 6217, 6216, 6216, 6213, 6217, 6212, 6219, 6215, 6218, 6221, 6212, 6216, 6214,
+    6205, 6212, 6211, 6204, 6212, 6211, 6215, 6212, 6217, 6210, 6208, 6210, 6206, 6213, 6209,
+    6215, 6213, 6214, 6210, 6213, 6219, 6211, 6219, 6217, 6215, 6219, 6205, 6207, 6215, 6208,
+    6215, 6209, 6206, 6211, 6203, 6206, 6210, 6208, 6213, 6207, 6209, 6209, 6211, 6204, 6205,
+    6209, 6206, 6208, 6210, 6207, 6204, 6208, 6208, 6203, 6209, 6211, 6204, 6205, 6206, 6208,
+    6206, 6205, 6210, 6211, 6213, 6211, 6212, 6212, 6208, 6204, 6215, 6208, 6215, 6207, 6199,
+    6203, 6203, 6201, 6209, 6209, 6205, 6208, 6204, 6209, 6212, 6206, 6207, 6204, 6203, 6211,
+    6213, 6211, 6214, 6211, 6204, 6211, 6210, 6211, 6206, 6215, 6211, 6211, 6207, 6207, 6209,
+    6215, 6210, 6211, 6211, 6208, 6207, 6215, 6215, 6210, 6215, 6209, 6221, 6212, 6212, 6212,
+    6212, 6214, 6213, 6223, 6218, 6219, 6213, 6216, 6218, 6220, 6212, 6216, 6215, 6218, 6207,
+    6207, 6217, 6210, 6208, 6206, 6209, 6217, 6214, 6215, 6215, 6215, 6208, 6220, 6215, 6218,
+    6217, 6217, 6213, 6214, 6216, 6210, 6215, 6218, 6210, 6207, 6212, 6208, 6210, 6207, 6202,
+    6211, 6208, 6211, 6208, 6211, 6217, 6214, 6207, 6210, 6212, 6214, 6214, 6215, 6209, 6211,
+    6206, 6213, 6207, 6210, 6208, 6213, 6220, 6206, 6208, 6212, 6198, 6208, 6207, 6209, 6216,
+    6208, 6197, 6206, 6202, 6211, 6210, 6216, 6211, 6206, 6209, 6211, 6201, 6214, 6215, 6204,
+    6204, 6198, 6212, 6208, 6207, 6217, 6213, 6204, 6211, 6213, 6216, 6210, 6212, 6215, 6214,
+    6214, 6209, 6208, 6208, 6215, 6212, 6224, 6219, 6212, 6219, 6209, 6212, 6212, 6210, 6215,
+    6211, 6213, 6216, 6216, 6218, 6211, 6211, 6222, 6217, 6216, 6222, 6214, 6216, 6218, 6216,
+    6223, 6214, 6216, 6217, 6225, 6220, 6219, 6216, 6225, 6219, 6221, 6222, 6218, 6222, 6219,
+    6226, 6218, 6221, 6219, 6211, 6216, 6218, 6219, 6218, 6222, 6219, 6218, 6221, 6220, 6224,
+    6218, 6233, 6217, 6230, 6220, 6221, 6212, 6219, 6222, 6229, 6228, 6220, 6223, 6224, 6225,
+    6216, 6220, 6226, 6219, 6218, 6224, 6220, 6222, 6228, 6227, 6211, 6219, 6223, 6216, 6221,
+    6215, 6215, 6223, 6219, 6222, 6221, 6227, 6218, 6220, 6219, 6216, 6220, 6212, 6219, 6213,
+    6218, 6212, 6218, 6217, 6213, 6218, 6215, 6216, 6214, 6223, 6220, 6223, 6209, 6217, 6219,
+    6214, 6213, 6215, 6220, 6213, 6214, 6216, 6211, 6217, 6216, 6218, 6213, 6212, 6216, 6218,
+    6211, 6220, 6216, 6223, 6219, 6217, 6221, 6215, 6215, 6214, 6215, 6217, 6212, 6211, 6216,
+    6214, 6221, 6218, 6215, 6225, 6213, 6205, 6211, 6214, 6222, 6211, 6218, 6211, 6217, 6216,
+    6210, 6215, 6213, 6220, 6213, 6219, 6212, 6208, 6216, 6212, 6208, 6207, 6205, 6219, 6212,
+    6214, 6208, 6208, 6209, 6213, 6220, 6219, 6212, 6209, 6212, 6208, 6218, 6217, 6207, 6216,
+    6217, 6207, 6211, 6210, 6207, 6209, 6206, 6215, 6202, 6213, 6202, 6206, 6218, 6205, 6217,
+    6210, 6208, 6215, 6212, 6206, 6203, 6208, 6206, 6206, 6207, 6211, 6207, 6209, 6213, 6212,
+    6211, 6210, 6215, 6209, 6207, 6212, 6198, 6209, 6209, 6217, 6204, 6214, 6211, 6217, 6209,
+    6210, 6215, 6219, 6210, 6222, 6212, 6214, 6210, 6208, 6211, 6216, 6208, 6207, 6210, 6208,
+    6217, 6211, 6216, 6212, 6211, 6212, 6209, 6208, 6215, 6210, 6211, 6218, 6210, 6216, 6211,
+    6206, 6173, 6135, 6105, 6066, 6043, 6015, 5993, 5961, 5937, 5921, 5898, 5880, 5866, 5848,
+    5830, 5822, 5809, 5791, 5777, 5770, 5754, 5752, 5737, 5726, 5726, 5708, 5701, 5703, 5695,
+    5693, 5689, 5685, 5687, 5678, 5672, 5671, 5663, 5664, 5663, 5653, 5656, 5661, 5648, 5651,
+    5645, 5649, 5642, 5641, 5641, 5640, 5645, 5640, 5636, 5629, 5640, 5632, 5631, 5630, 5624,
+    5631, 5618, 5627, 5628, 5621, 5625, 5619, 5618, 5625, 5627, 5619, 5621, 5612, 5621, 5619,
+    5625, 5619, 5612, 5620, 5619, 5615, 5618, 5614, 5619, 5620, 5620, 5623, 5619, 5625, 5624,
+    5617, 5625, 5622, 5620, 5613, 5613, 5619, 5611, 5622, 5616, 5606, 5611, 5617, 5616, 5613,
+    5611, 5615, 5610, 5621, 5613, 5609, 5616, 5612, 5611, 5610, 5614, 5616, 5618, 5611, 5610,
+    5618, 5619, 5610, 5609, 5615, 5617, 5619, 5612, 5611, 5618, 5613, 5608, 5617, 5611, 5622,
+    5614, 5613, 5611, 5616, 5617, 5613, 5619, 5617, 5612, 5615, 5610, 5619, 5627, 5618, 5620,
+    5617, 5622, 5614, 5622, 5621, 5612, 5620, 5611, 5614, 5606, 5613, 5612, 5608, 5616, 5607,
+    5611, 5618, 5621, 5615, 5618, 5617, 5620, 5617, 5611, 5611, 5609, 5611, 5612, 5609, 5617,
+    5622, 5613, 5617, 5614, 5613, 5624, 5619, 5617, 5617, 5621, 5624, 5612, 5612, 5608, 5616,
+    5620, 5614, 5612, 5614, 5617, 5617, 5620, 5617, 5617, 5620, 5623, 5614, 5612, 5617, 5619,
+    5620, 5616, 5621, 5612, 5619, 5616, 5617, 5615, 5619, 5620, 5612, 5607, 5608, 5617, 5615,
+    5621, 5617, 5615, 5614, 5614, 5617, 5616, 5615, 5620, 5624, 5615, 5617, 5614, 5619, 5617,
+    5620, 5617, 5616, 5626, 5616, 5623, 5620, 5613, 5619, 5617, 5628, 5623, 5621, 5615, 5621,
+    5615, 5623, 5625, 5616, 5618, 5618, 5625, 5617, 5619, 5615, 5617, 5627, 5616, 5620, 5625,
+    5617, 5618, 5616, 5620, 5618, 5619, 5621, 5612, 5619, 5611, 5617, 5620, 5616, 5605, 5614,
+    5616, 5613, 5611, 5612, 5617, 5611, 5610, 5615, 5615, 5614, 5618, 5618, 5627, 5630, 5624,
+    5614, 5624, 5620, 5620, 5630, 5615, 5618, 5612, 5616, 5612, 5615, 5616, 5625, 5615, 5617,
+    5612, 5608, 5611, 5616, 5614, 5621, 5616, 5613, 5612, 5620, 5616, 5618, 5620, 5619, 5616,
+    5616, 5618, 5612, 5617, 5621, 5617, 5624, 5611, 5615, 5611, 5613, 5616, 5616, 5623, 5613,
+    5617, 5621, 5617, 5622, 5621, 5612, 5615, 5607, 5616, 5609, 5609, 5616, 5606, 5614, 5614,
+    5619, 5614, 5612, 5609, 5613, 5611, 5615, 5621, 5614, 5614, 5620, 5611, 5613, 5617, 5609,
+    5616, 5609, 5606, 5612, 5608, 5611, 5610, 5619, 5611, 5605, 5613, 5610, 5613, 5606, 5605,
+    5617, 5621, 5607, 5616, 5607, 5615, 5618, 5613, 5606, 5610, 5623, 5612, 5609, 5611, 5613,
+    5613, 5609, 5606, 5617, 5615, 5613, 5619, 5613, 5609, 5610, 5618, 5612, 5602, 5605, 5614,
+    5614, 5608, 5610, 5605, 5617, 5609, 5610, 5610, 5605, 5615, 5613, 5611, 5611, 5610, 5606,
+    5610, 5603, 5603, 5602, 5607, 5612, 5610, 5612, 5611, 5610, 5619, 5618, 5611, 5612, 5607,
+};
+
+static const int16_t trace_ramp_temp[TRACE_LEN] = {
+    2800, 2800, 2800, 2801, 2800, 2800, 2800, 2803, 2803, 2803, 2805, 2805, 2805, 2806, 2807,
+    2805, 2807, 2808, 2806, 2808, 2808, 2808, 2807, 2809, 2810, 2810, 2809, 2811, 2810, 2811,
+    2811, 2813, 2812, 2813, 2813, 2814, 2813, 2813, 2815, 2815, 2814, 2814, 2815, 2816, 2815,
+    2816, 2818, 2816, 2817, 2817, 2818, 2817, 2817, 2819, 2818, 2819, 2818, 2819, 2820, 2820,
+    2821, 2822, 2820, 2822, 2822, 2823, 2824, 2825, 2824, 2826, 2826, 2825, 2827, 2828, 2827,
+    2827, 2826, 2826, 2826, 2828, 2827, 2827, 2827, 2829, 2827, 2829, 2829, 2830, 2832, 2831,
+    2831, 2831, 2832, 2833, 2833, 2834, 2835, 2834, 2836, 2836, 2837, 2837, 2836, 2839, 2837,
+    2838, 2838, 2840, 2840, 2839, 2840, 2839, 2840, 2841, 2841, 2842, 2841, 2842, 2842, 2844,
+    2843, 2842, 2843, 2843, 2845, 2844, 2843, 2845, 2845, 2845, 2845, 2848, 2846, 2846, 2846,
+    2847, 2849, 2848, 2849, 2847, 2850, 2849, 2850, 2850, 2851, 2853, 2852, 2854, 2853, 2852,
+    2854, 2855, 2855, 2856, 2856, 2858, 2857, 2857, 2857, 2857, 2857, 2858, 2858, 2858, 2859,
+    2858, 2860, 2860, 2860, 2861, 2862, 2861, 2861, 2862, 2861, 2861, 2863, 2864, 2862, 2862,
+    2864, 2863, 2864, 2865, 2866, 2864, 2865, 2867, 2867, 2865, 2866, 2868, 2869, 2869, 2867,
+    2868, 2868, 2867, 2868, 2869, 2869, 2870, 2869, 2870, 2871, 2871, 2871, 2872, 2872, 2872,
+    2875, 2875, 2874, 2876, 2877, 2877, 2878, 2877, 2877, 2879, 2879, 2879, 2881, 2881, 2881,
+    2883, 2884, 2883, 2884, 2884, 2884, 2884, 2884, 2884, 2886, 2885, 2886, 2886, 2886, 2886,
+    2886, 2887, 2888, 2887, 2888, 2889, 2888, 2888, 2888, 2889, 2889, 2889, 2888, 2891, 2889,
+    2891, 2892, 2893, 2892, 2893, 2892, 2893, 2893, 2894, 2895, 2895, 2895, 2896, 2896, 2898,
+    2898, 2897, 2897, 2898, 2899, 2899, 2898, 2899, 2898, 2899, 2899, 2899, 2901, 2900, 2902,
+    2902, 2902, 2903, 2903, 2903, 2904, 2906, 2907, 2907, 2907, 2908, 2907, 2907, 2908, 2909,
+    2909, 2909, 2910, 2911, 2911, 2912, 2911, 2913, 2913, 2913, 2913, 2913, 2916, 2914, 2915,
+    2916, 2916, 2915, 2915, 2918, 2916, 2917, 2919, 2919, 2919, 2920, 2921, 2920, 2921, 2922,
+    2922, 2922, 2922, 2923, 2922, 2926, 2924, 2925, 2926, 2926, 2926, 2929, 2926, 2927, 2927,
+    2928, 2928, 2929, 2928, 2929, 2930, 2930, 2929, 2931, 2929, 2932, 2932, 2931, 2932, 2933,
+    2933, 2934, 2934, 2935, 2934, 2935, 2936, 2938, 2938, 2936, 2937, 2936, 2938, 2939, 2939,
+    2941, 2942, 2941, 2941, 2941, 2941, 2942, 2942, 2942, 2944, 2944, 2944, 2943, 2945, 2946,
+    2945, 2946, 2946, 2947, 2947, 2948, 2947, 2948, 2948, 2949, 2948, 2950, 2949, 2949, 2951,
+    2950, 2950, 2953, 2952, 2952, 2953, 2952, 2953, 2953, 2953, 2953, 2955, 2954, 2955, 2955,
+    2955, 2956, 2957, 2957, 2956, 2957, 2958, 2959, 2959, 2961, 2959, 2960, 2961, 2961, 2960,
+    2961, 2961, 2960, 2961, 2961, 2964, 2963, 2964, 2963, 2966, 2965, 2966, 2966, 2966, 2966,
+    2967, 2968, 2968, 2969, 2969, 2970, 2970, 2971, 2971, 2971, 2971, 2971, 2972, 2973, 2973,
+    2973, 2973, 2973, 2974, 2974, 2975, 2973, 2975, 2975, 2976, 2976, 2976, 2977, 2979, 2979,
+    2980, 2978, 2980, 2980, 2980, 2980, 2981, 2981, 2981, 2983, 2984, 2982, 2984, 2984, 2984,
+    2985, 2984, 2986, 2986, 2987, 2986, 2986, 2987, 2987, 2988, 2989, 2988, 2990, 2989, 2989,
+    2989, 2989, 2990, 2991, 2989, 2991, 2992, 2991, 2992, 2992, 2992, 2993, 2993, 2992, 2993,
+    2993, 2995, 2995, 2995, 2996, 2995, 2998, 2997, 2997, 2995, 2996, 2998, 2998, 3000, 2998,
+    2999, 3001, 3000, 3000, 3003, 3002, 3002, 3001, 3004, 3004, 3003, 3004, 3004, 3005, 3007,
+    3006, 3007, 3007, 3007, 3007, 3008, 3008, 3008, 3008, 3010, 3009, 3011, 3011, 3013, 3013,
+    3013, 3013, 3015, 3014, 3014, 3015, 3014, 3015, 3016, 3017, 3016, 3018, 3016, 3017, 3016,
+    3018, 3020, 3019, 3019, 3020, 3019, 3020, 3023, 3021, 3023, 3023, 3023, 3022, 3024, 3023,
+    3024, 3025, 3025, 3026, 3027, 3025, 3027, 3028, 3028, 3028, 3027, 3029, 3029, 3031, 3029,
+    3031, 3030, 3032, 3034, 3032, 3033, 3032, 3035, 3033, 3034, 3036, 3033, 3035, 3036, 3037,
+    3037, 3038, 3038, 3037, 3037, 3037, 3039, 3039, 3039, 3040, 3039, 3040, 3040, 3039, 3039,
+    3039, 3041, 3042, 3042, 3041, 3042, 3042, 3042, 3043, 3042, 3042, 3045, 3044, 3044, 3044,
+    3045, 3044, 3046, 3045, 3046, 3045, 3046, 3048, 3048, 3049, 3050, 3049, 3047, 3049, 3050,
+    3050, 3051, 3052, 3052, 3052, 3053, 3053, 3052, 3053, 3053, 3054, 3054, 3056, 3054, 3056,
+    3055, 3057, 3056, 3056, 3058, 3060, 3059, 3060, 3058, 3060, 3059, 3059, 3061, 3060, 3060,
+    3062, 3061, 3062, 3064, 3063, 3064, 3062, 3063, 3065, 3065, 3065, 3065, 3066, 3066, 3066,
+    3065, 3067, 3065, 3068, 3067, 3068, 3067, 3069, 3069, 3070, 3071, 3072, 3070, 3070, 3070,
+    3071, 3071, 3074, 3072, 3073, 3073, 3072, 3074, 3074, 3075, 3075, 3075, 3076, 3076, 3077,
+    3077, 3077, 3078, 3077, 3078, 3079, 3079, 3079, 3080, 3080, 3080, 3080, 3080, 3081, 3082,
+    3080, 3082, 3082, 3082, 3083, 3084, 3084, 3084, 3085, 3086, 3086, 3084, 3086, 3087, 3085,
+    3086, 3088, 3087, 3086, 3088, 3087, 3089, 3090, 3090, 3092, 3093, 3092, 3092, 3091, 3093,
+    3094, 3094, 3093, 3094, 3094, 3094, 3095, 3095, 3097, 3096, 3097, 3097, 3097, 3098, 3098,
+    3098, 3099, 3100, 3100, 3101, 3100, 3100, 3099, 3101, 3102, 3102, 3100, 3101, 3103, 3101,
+    3102, 3102, 3103, 3105, 3104, 3103, 3105, 3106, 3107, 3106, 3107, 3106, 3108, 3106, 3107,
+    3108, 3107, 3110, 3109, 3109, 3109, 3109, 3109, 3111, 3109, 3110, 3111, 3111, 3113, 3113,
+    3112, 3113, 3114, 3114, 3114, 3115, 3115, 3115, 3116, 3117, 3115, 3117, 3117, 3117, 3117,
+    3118, 3120, 3119, 3119, 3121, 3121, 3122, 3121, 3122, 3124, 3124, 3122, 3123, 3125, 3124,
+    3123, 3126, 3123, 3125, 3127, 3125, 3127, 3127, 3128, 3127, 3128, 3128, 3129, 3130, 3129,
+    3130, 3131, 3133, 3133, 3132, 3132, 3133, 3133, 3133, 3135, 3134, 3134, 3136, 3136, 3136,
+    3136, 3136, 3136, 3138, 3136, 3136, 3139, 3138, 3139, 3138, 3139, 3140, 3138, 3140, 3142,
+    3142, 3142, 3142, 3142, 3143, 3144, 3144, 3145, 3144, 3147, 3146, 3145, 3145, 3146, 3147,
+    3147, 3147, 3147, 3149, 3149, 3149, 3149, 3150, 3151, 3151, 3151, 3150, 3150, 3151, 3152,
+    3154, 3152, 3153, 3153, 3151, 3153, 3156, 3154, 3156, 3155, 3154, 3154, 3155, 3155, 3156,
+    3156, 3157, 3159, 3157, 3159, 3159, 3158, 3159, 3160, 3159, 3161, 3160, 3160, 3161, 3160,
+    3161, 3162, 3161, 3162, 3162, 3164, 3162, 3164, 3163, 3164, 3163, 3164, 3166, 3164, 3166,
+    3166, 3167, 3168, 3167, 3166, 3167, 3168, 3169, 3169, 3168, 3170, 3172, 3171, 3170, 3171,
+    3171, 3171, 3173, 3172, 3173, 3173, 3174, 3174, 3175, 3175, 3175, 3176, 3177, 3176, 3176,
+    3179, 3178, 3180, 3178, 3179, 3178, 3178, 3180, 3181, 3181, 3180, 3179, 3181, 3182, 3181,
+    3183, 3185, 3183, 3184, 3186, 3185, 3186, 3185, 3185, 3187, 3189, 3187, 3188, 3188, 3188,
+    3190, 3189, 3189, 3190, 3191, 3193, 3192, 3192, 3194, 3193, 3194, 3193, 3193, 3196, 3193,
+    3196, 3195, 3196, 3197, 3196, 3198, 3198, 3199, 3200, 3199, 3199, 3201, 3200, 3201, 3202,
+    3202, 3202, 3201, 3203, 3204, 3204, 3204, 3204, 3202, 3204, 3206, 3204, 3204, 3206, 3207,
+    3207, 3208, 3209, 3207, 3208, 3208, 3208, 3209, 3211, 3210, 3209, 3211, 3213, 3213, 3212,
+    3212, 3214, 3213, 3214, 3213, 3214, 3215, 3215, 3216, 3217, 3216, 3216, 3219, 3218, 3218,
+    3216, 3218, 3219, 3220, 3221, 3221, 3220, 3222, 3220, 3222, 3222, 3223, 3224, 3225, 3224,
+    3225, 3226, 3225, 3227, 3227, 3226, 3229, 3229, 3227, 3229, 3228, 3230, 3230, 3229, 3232,
+    3230, 3232, 3233, 3233, 3234, 3231, 3232, 3233, 3236, 3234, 3236, 3236, 3235, 3236, 3237,
+    3238, 3240, 3238, 3238, 3238, 3238, 3238, 3241, 3240, 3239, 3240, 3240, 3241, 3240, 3241,
+    3242, 3241, 3242, 3242, 3241, 3241, 3243, 3244, 3244, 3244, 3244, 3246, 3245, 3246, 3247,
+    3248, 3246, 3246, 3248, 3249, 3247, 3247, 3249, 3248, 3249, 3251, 3250, 3251, 3251, 3253,
+    3252, 3252, 3253, 3254, 3253, 3253, 3256, 3255, 3257, 3256, 3256, 3255, 3257, 3257, 3257,
+    3258, 3259, 3259, 3259, 3259, 3262, 3260, 3262, 3261, 3262, 3260, 3263, 3264, 3263, 3262,
+    3264, 3264, 3265, 3263, 3265, 3265, 3265, 3267, 3266, 3266, 3267, 3266, 3269, 3268, 3268,
+    3270, 3270, 3270, 3269, 3270, 3270, 3272, 3272, 3272, 3272, 3273, 3273, 3272, 3274, 3275,
+    3274, 3275, 3276, 3275, 3275, 3276, 3277, 3278, 3278, 3278, 3281, 3280, 3280, 3281, 3280,
+    3282, 3282, 3282, 3283, 3283, 3284, 3283, 3283, 3284, 3282, 3282, 3285, 3285, 3284, 3285,
+    3287, 3286, 3286, 3287, 3285, 3288, 3288, 3288, 3288, 3289, 3289, 3290, 3291, 3291, 3292,
+    3292, 3292, 3292, 3292, 3293, 3295, 3293, 3295, 3294, 3295, 3295, 3295, 3295, 3296, 3297,
+};
+static const uint16_t trace_ramp_humi[TRACE_LEN] = {
+    6503, 6496, 6498, 6499, 6498, 6500, 6498, 6498, 6506, 6496, 6493, 6499, 6495, 6505, 6504,
+    6499, 6504, 6499, 6491, 6497, 6497, 6498, 6497, 6490, 6488, 6489, 6489, 6493, 6487, 6489,
+    6487, 6486, 6487, 6490, 6485, 6488, 6484, 6496, 6491, 6486, 6489, 6489, 6488, 6495, 6484,
+    6488, 6492, 6488, 6491, 6483, 6490, 6481, 6491, 6479, 6486, 6481, 6487, 6482, 6479, 6480,
+    6478, 6477, 6485, 6484, 6480, 6481, 6477, 6476, 6480, 6484, 6473, 6477, 6478, 6481, 6474,
+    6480, 6472, 6480, 6483, 6476, 6474, 6475, 6475, 6476, 6466, 6480, 6474, 6476, 6471, 6470,
+    6468, 6475, 6470, 6475, 6474, 6474, 6467, 6481, 6463, 6462, 6466, 6463, 6470, 6470, 6467,
+    6465, 6463, 6470, 6466, 6468, 6473, 6471, 6467, 6472, 6468, 6469, 6465, 6463, 6470, 6471,
+    6464, 6456, 6464, 6464, 6461, 6460, 6461, 6466, 6462, 6470, 6454, 6460, 6462, 6455, 6457,
+    6459, 6460, 6460, 6457, 6463, 6461, 6458, 6454, 6454, 6454, 6463, 6450, 6456, 6453, 6457,
+    6453, 6454, 6457, 6453, 6453, 6452, 6455, 6457, 6450, 6453, 6451, 6452, 6459, 6447, 6449,
+    6450, 6452, 6453, 6451, 6448, 6446, 6445, 6453, 6444, 6448, 6447, 6444, 6447, 6447, 6449,
+    6454, 6450, 6446, 6451, 6444, 6447, 6451, 6450, 6446, 6446, 6448, 6444, 6445, 6437, 6446,
+    6439, 6439, 6438, 6449, 6440, 6442, 6439, 6439, 6440, 6441, 6435, 6442, 6435, 6444, 6438,
+    6436, 6441, 6439, 6443, 6435, 6437, 6436, 6438, 6438, 6437, 6436, 6438, 6430, 6432, 6433,
+    6428, 6429, 6431, 6430, 6433, 6432, 6429, 6428, 6430, 6424, 6424, 6431, 6432, 6421, 6436,
+    6428, 6426, 6437, 6433, 6434, 6425, 6424, 6432, 6421, 6426, 6435, 6428, 6423, 6431, 6422,
+    6419, 6433, 6432, 6421, 6421, 6424, 6423, 6421, 6423, 6418, 6422, 6421, 6421, 6424, 6419,
+    6419, 6422, 6415, 6423, 6411, 6421, 6415, 6417, 6415, 6424, 6419, 6416, 6417, 6413, 6421,
+    6419, 6413, 6415, 6419, 6421, 6409, 6418, 6414, 6419, 6407, 6412, 6415, 6415, 6418, 6415,
+    6413, 6407, 6413, 6411, 6418, 6412, 6415, 6411, 6411, 6403, 6419, 6412, 6406, 6408, 6407,
+    6403, 6408, 6410, 6403, 6404, 6400, 6413, 6406, 6398, 6406, 6401, 6404, 6404, 6394, 6397,
+    6399, 6405, 6405, 6405, 6400, 6399, 6402, 6405, 6403, 6400, 6390, 6392, 6399, 6400, 6393,
+    6401, 6398, 6399, 6395, 6399, 6397, 6398, 6395, 6396, 6398, 6395, 6390, 6393, 6391, 6391,
+    6391, 6389, 6390, 6390, 6387, 6386, 6384, 6390, 6387, 6389, 6391, 6391, 6391, 6395, 6394,
+    6385, 6386, 6385, 6386, 6390, 6394, 6382, 6390, 6378, 6382, 6386, 6388, 6385, 6385, 6394,
+    6386, 6379, 6384, 6390, 6383, 6383, 6382, 6389, 6383, 6380, 6381, 6383, 6376, 6384, 6382,
+    6372, 6384, 6372, 6379, 6376, 6375, 6380, 6378, 6376, 6380, 6375, 6377, 6380, 6375, 6382,
+    6382, 6379, 6376, 6372, 6378, 6374, 6372, 6368, 6373, 6381, 6373, 6371, 6369, 6373, 6369,
+    6376, 6368, 6374, 6372, 6378, 6377, 6366, 6370, 6369, 6370, 6363, 6371, 6372, 6373, 6374,
+    6367, 6366, 6366, 6365, 6366, 6370, 6369, 6362, 6358, 6365, 6364, 6364, 6356, 6372, 6364,
+    6368, 6363, 6355, 6363, 6362, 6364, 6360, 6362, 6358, 6358, 6354, 6357, 6358, 6358, 6356,
+    6351, 6361, 6362, 6355, 6349, 6358, 6359, 6349, 6354, 6358, 6356, 6355, 6356, 6357, 6354,
+    6357, 6355, 6357, 6352, 6347, 6351, 6347, 6347, 6349, 6348, 6345, 6343, 6353, 6353, 6350,
+    6346, 6346, 6351, 6354, 6342, 6354, 6340, 6352, 6349, 6348, 6346, 6345, 6347, 6348, 6336,
+    6339, 6339, 6343, 6341, 6340, 6344, 6348, 6341, 6348, 6341, 6339, 6345, 6340, 6337, 6340,
+    6331, 6335, 6340, 6339, 6342, 6336, 6338, 6331, 6338, 6338, 6340, 6337, 6341, 6341, 6339,
+    6332, 6336, 6338, 6338, 6332, 6332, 6331, 6338, 6328, 6337, 6334, 6329, 6334, 6331, 6326,
+    6332, 6336, 6325, 6330, 6332, 6331, 6330, 6329, 6322, 6330, 6336, 6323, 6328, 6333, 6325,
+    6318, 6325, 6318, 6330, 6326, 6321, 6323, 6327, 6327, 6321, 6320, 6324, 6324, 6330, 6321,
+    6315, 6327, 6320, 6326, 6322, 6325, 6314, 6323, 6319, 6311, 6322, 6315, 6319, 6315, 6312,
+    6318, 6318, 6317, 6312, 6313, 6311, 6312, 6313, 6310, 6314, 6319, 6317, 6307, 6310, 6317,
+    6314, 6315, 6317, 6317, 6307, 6304, 6315, 6312, 6303, 6318, 6306, 6313, 6309, 6306, 6310,
+    6308, 6311, 6312, 6309, 6305, 6305, 6312, 6305, 6304, 6309, 6305, 6298, 6303, 6305, 6300,
+    6311, 6302, 6302, 6303, 6302, 6302, 6305, 6295, 6305, 6296, 6301, 6305, 6300, 6304, 6307,
+    6306, 6302, 6293, 6298, 6299, 6294, 6304, 6297, 6295, 6294, 6291, 6298, 6293, 6289, 6294,
+    6300, 6293, 6287, 6291, 6294, 6296, 6297, 6287, 6301, 6297, 6293, 6290, 6292, 6298, 6295,
+    6277, 6296, 6289, 6291, 6286, 6288, 6294, 6288, 6293, 6291, 6291, 6288, 6279, 6288, 6282,
+    6281, 6289, 6276, 6280, 6286, 6276, 6282, 6286, 6287, 6286, 6285, 6279, 6281, 6287, 6284,
+    6286, 6279, 6284, 6290, 6284, 6283, 6283, 6278, 6283, 6280, 6281, 6280, 6279, 6280, 6279,
+    6277, 6271, 6282, 6280, 6273, 6283, 6275, 6278, 6282, 6281, 6277, 6275, 6273, 6268, 6274,
+    6274, 6268, 6276, 6274, 6271, 6270, 6266, 6271, 6271, 6272, 6266, 6269, 6271, 6265, 6270,
+    6268, 6271, 6268, 6267, 6274, 6265, 6262, 6261, 6263, 6274, 6273, 6264, 6264, 6262, 6266,
+    6266, 6266, 6258, 6270, 6261, 6260, 6255, 6264, 6262, 6262, 6261, 6257, 6263, 6261, 6267,
+    6263, 6254, 6254, 6255, 6258, 6261, 6252, 6257, 6256, 6252, 6254, 6259, 6255, 6256, 6255,
+    6252, 6255, 6251, 6264, 6256, 6246, 6249, 6256, 6250, 6256, 6255, 6246, 6253, 6253, 6260,
+    6248, 6252, 6250, 6252, 6251, 6245, 6249, 6248, 6248, 6250, 6244, 6256, 6246, 6246, 6250,
+    6242, 6246, 6247, 6249, 6239, 6255, 6250, 6244, 6249, 6243, 6246, 6237, 6243, 6236, 6241,
+    6242, 6243, 6245, 6242, 6237, 6240, 6239, 6241, 6241, 6242, 6235, 6233, 6234, 6242, 6239,
+    6238, 6239, 6232, 6233, 6236, 6235, 6242, 6235, 6234, 6235, 6231, 6234, 6229, 6231, 6231,
+    6236, 6233, 6234, 6226, 6229, 6229, 6236, 6227, 6233, 6232, 6231, 6229, 6224, 6227, 6221,
+    6234, 6224, 6233, 6229, 6227, 6230, 6220, 6227, 6234, 6219, 6229, 6228, 6218, 6221, 6224,
+    6226, 6224, 6227, 6227, 6222, 6223, 6217, 6223, 6220, 6221, 6222, 6224, 6223, 6221, 6218,
+    6216, 6221, 6218, 6222, 6217, 6219, 6216, 6223, 6216, 6218, 6223, 6215, 6216, 6212, 6205,
+    6211, 6215, 6215, 6215, 6218, 6217, 6211, 6214, 6215, 6216, 6208, 6208, 6213, 6211, 6221,
+    6212, 6209, 6209, 6217, 6211, 6207, 6209, 6212, 6209, 6211, 6207, 6213, 6212, 6204, 6203,
+    6208, 6208, 6210, 6202, 6203, 6210, 6212, 6210, 6210, 6210, 6202, 6209, 6205, 6199, 6197,
+    6204, 6206, 6200, 6200, 6198, 6204, 6200, 6201, 6194, 6197, 6197, 6195, 6200, 6203, 6198,
+    6192, 6199, 6201, 6200, 6193, 6199, 6197, 6195, 6189, 6195, 6195, 6197, 6198, 6190, 6185,
+    6191, 6183, 6182, 6195, 6192, 6186, 6187, 6182, 6193, 6190, 6195, 6190, 6193, 6187, 6187,
+    6190, 6180, 6183, 6192, 6191, 6192, 6188, 6183, 6185, 6183, 6184, 6187, 6185, 6183, 6179,
+    6184, 6179, 6185, 6184, 6187, 6179, 6188, 6184, 6189, 6184, 6185, 6185, 6181, 6180, 6181,
+    6179, 6179, 6178, 6180, 6177, 6174, 6178, 6179, 6177, 6181, 6179, 6179, 6179, 6180, 6178,
+    6176, 6177, 6172, 6175, 6166, 6176, 6170, 6173, 6175, 6173, 6169, 6172, 6174, 6172, 6171,
+    6168, 6172, 6175, 6169, 6173, 6169, 6170, 6167, 6164, 6171, 6167, 6167, 6169, 6165, 6169,
+    6168, 6170, 6172, 6171, 6161, 6166, 6160, 6170, 6166, 6165, 6161, 6166, 6164, 6161, 6160,
+    6160, 6165, 6169, 6160, 6157, 6153, 6162, 6167, 6155, 6156, 6163, 6163, 6159, 6161, 6153,
+    6152, 6165, 6153, 6155, 6159, 6152, 6159, 6156, 6144, 6154, 6158, 6156, 6155, 6156, 6157,
+    6152, 6149, 6151, 6155, 6159, 6145, 6158, 6159, 6149, 6151, 6154, 6151, 6150, 6142, 6145,
+    6143, 6148, 6151, 6151, 6147, 6151, 6147, 6146, 6148, 6140, 6149, 6141, 6147, 6143, 6145,
+    6146, 6143, 6144, 6146, 6145, 6141, 6145, 6140, 6143, 6150, 6138, 6139, 6132, 6145, 6141,
+    6140, 6135, 6133, 6139, 6142, 6135, 6143, 6136, 6137, 6134, 6129, 6130, 6138, 6129, 6136,
+    6131, 6136, 6134, 6127, 6135, 6131, 6133, 6137, 6132, 6131, 6136, 6138, 6132, 6139, 6135,
+    6135, 6128, 6132, 6129, 6121, 6130, 6125, 6129, 6128, 6132, 6121, 6120, 6125, 6128, 6126,
+    6130, 6126, 6119, 6126, 6135, 6134, 6129, 6125, 6119, 6127, 6122, 6122, 6119, 6117, 6116,
+    6125, 6125, 6119, 6123, 6123, 6123, 6122, 6119, 6120, 6120, 6119, 6125, 6114, 6113, 6127,
+    6121, 6120, 6114, 6112, 6115, 6123, 6108, 6111, 6119, 6109, 6117, 6114, 6113, 6118, 6116,
+    6121, 6108, 6109, 6117, 6112, 6112, 6111, 6119, 6116, 6114, 6106, 6107, 6117, 6102, 6112,
+    6114, 6110, 6112, 6108, 6112, 6107, 6112, 6109, 6107, 6104, 6106, 6107, 6100, 6109, 6114,
+    6108, 6105, 6104, 6096, 6094, 6104, 6103, 6107, 6102, 6107, 6100, 6106, 6106, 6103, 6105,
+};
+
+#endif
@@ -0,0 +1,211 @@
+#include <unity.h>
+#include <chrono>
+#include "../../src/sensor_stats.cpp"
+
+static sensor_stats_t stats;
+
+static sensor_sample_t sample(int16_t temp_centi, uint16_t humi_centi, int status = DHT20_OK) {
+    sensor_sample_t s = { temp_centi, humi_centi, 0, status };
+    return s;
+}
+
+// Tham chieu hai lan duyet, double
+static void ref_stats(const int32_t *x, uint16_t n, double *mean, double *stddev) {
+    double sum = 0, sq = 0;
+    for (uint16_t i = 0; i < n; i++) sum += x[i];
+    *mean = sum / n;
+    for (uint16_t i = 0; i < n; i++) sq += (x[i] - *mean) * (x[i] - *mean);
+    *stddev = sqrt(sq / n);
+}
+
+void setUp(void) {
+    sensor_stats_init(&stats);
+}
+
+void tearDown(void) {}
+
+// Welford mot lan duyet khop tham chieu hai lan duyet, ca khi gia tri lon va lech nho
+static void test_welford_matches_two_pass(void) {
+    const stats_channel_cfg_t cfg = { 0, 0, 64, 0.2f };
+    stats_channel_t c;
+    stats_aggregate_t agg;
+    int32_t x[64];
+    uint32_t rng = 12345;
+
+    stats_channel_init(&c, &cfg);
+    for (uint16_t i = 0; i < 64; i++) {
+        rng = rng * 1103515245u + 12345u;
+        x[i] = 2500 + (int32_t)((rng >> 16) % 301) - 150;
+        uint8_t r = stats_channel_update(&c, x[i], i, &agg);
+        TEST_ASSERT_EQUAL(i == 63 ? STATS_WINDOW : 0, r & STATS_WINDOW);
+    }
+
+    double mean, stddev;
+    int32_t lo = x[0], hi = x[0];
+    for (uint16_t i = 1; i < 64; i++) {
+        if (x[i] < lo) lo = x[i];
+        if (x[i] > hi) hi = x[i];
+    }
+    ref_stats(x, 64, &mean, &stddev);
+    TEST_ASSERT_EQUAL_UINT16(64, agg.count);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, lo * 0.01f, agg.min);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, hi * 0.01f, agg.max);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, (float)(mean * 0.01), agg.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, (float)(stddev * 0.01), agg.stddev);
+}
+
+// EWMA: mau dau lay nguyen gia tri, sau do ewma += alpha * (x - ewma); khong reset theo cua so
+static void test_ewma(void) {
+    const stats_channel_cfg_t cfg = { 0, 0, 2, 0.2f };
+    stats_channel_t c;
+    stats_aggregate_t agg;
+
+    stats_channel_init(&c, &cfg);
+    stats_channel_update(&c, 1000, 0, &agg);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1000, c.ewma);
+    stats_channel_update(&c, 2000, 0, &agg);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1200, c.ewma);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 12.0f, agg.ewma);
+    // cua so moi van tiep tuc tu ewma cu
+    stats_channel_update(&c, 2000, 0, &agg);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1360, c.ewma);
+}
+
+// Deadband so voi gia tri da gui: troi cham van vuot sau vai mau; vuot mot kenh thi danh dau ca cap
+static void test_deadband(void) {
+    sensor_sample_t s = sample(2500, 6000);
+    TEST_ASSERT_EQUAL(STATS_REPORT, sensor_stats_feed(&stats, &s, 0) & STATS_REPORT);
+
+    s = sample(2500 + STATS_TEMP_DEADBAND - 1, 6000 + STATS_HUMI_DEADBAND - 1);
+    TEST_ASSERT_EQUAL(0, sensor_stats_feed(&stats, &s, 5) & STATS_REPORT);
+    s = sample(2500 - STATS_TEMP_DEADBAND + 1, 6000 - STATS_HUMI_DEADBAND + 1);
+    TEST_ASSERT_EQUAL(0, sensor_stats_feed(&stats, &s, 10) & STATS_REPORT);
+
+    s = sample(2510, 6000);
+    TEST_ASSERT_EQUAL(0, sensor_stats_feed(&stats, &s, 15) & STATS_REPORT);
+    s = sample(2500 + STATS_TEMP_DEADBAND, 6000);
+    TEST_ASSERT_EQUAL(STATS_REPORT, sensor_stats_feed(&stats, &s, 20) & STATS_REPORT);
+    TEST_ASSERT_EQUAL_INT32(2520, stats.temperature.lastReported);
+    TEST_ASSERT_EQUAL_UINT32(20, stats.temperature.lastReportS);
+
+    // chi do am vuot -> nhiet do cung duoc cap nhat gia tri da gui
+    s = sample(2530, 6000 - STATS_HUMI_DEADBAND);
+    TEST_ASSERT_EQUAL(STATS_REPORT, sensor_stats_feed(&stats, &s, 25) & STATS_REPORT);
+    TEST_ASSERT_EQUAL_INT32(2530, stats.temperature.lastReported);
+    TEST_ASSERT_EQUAL_INT32(6000 - STATS_HUMI_DEADBAND, stats.humidity.lastReported);
+
+    // mau loi bi bo qua hoan toan
+    uint16_t n = stats.temperature.n;
+    s = sample(9000, 0, DHT20_ERROR_CHECKSUM);
+    TEST_ASSERT_EQUAL(0, sensor_stats_feed(&stats, &s, 30));
+    TEST_ASSERT_EQUAL_UINT16(n, stats.temperature.n);
+    TEST_ASSERT_EQUAL_INT32(2530, stats.temperature.max);
+}
+
+// Gia tri dung yen: van gui moi STATS_MAX_SILENCE_S giay, tinh tu lan gui truoc
+static void test_max_silence(void) {
+    sensor_sample_t s = sample(2500, 6000);
+    uint32_t t0 = 1000;
+
+    TEST_ASSERT_EQUAL(STATS_REPORT, sensor_stats_feed(&stats, &s, t0) & STATS_REPORT);
+    TEST_ASSERT_EQUAL(0, sensor_stats_feed(&stats, &s, t0 + STATS_MAX_SILENCE_S - 1) & STATS_REPORT);
+    TEST_ASSERT_EQUAL(STATS_REPORT, sensor_stats_feed(&stats, &s, t0 + STATS_MAX_SILENCE_S) & STATS_REPORT);
+    TEST_ASSERT_EQUAL_UINT32(t0 + STATS_MAX_SILENCE_S, stats.temperature.lastReportS);
+    TEST_ASSERT_EQUAL(0, sensor_stats_feed(&stats, &s, t0 + 2 * STATS_MAX_SILENCE_S - 1) & STATS_REPORT);
+    TEST_ASSERT_EQUAL(STATS_REPORT, sensor_stats_feed(&stats, &s, t0 + 2 * STATS_MAX_SILENCE_S) & STATS_REPORT);
+
+    // max_silence_s = 0 tat han: chi deadband
+    const stats_channel_cfg_t cfg = { 20, 0, 100, 0.2f };
+    stats_channel_t c;
+    stats_channel_init(&c, &cfg);
+    mark_reported(&c, 2500, 0);
+    TEST_ASSERT_EQUAL(0, stats_channel_update(&c, 2500, 100000, NULL) & STATS_REPORT);
+}
+
+// Cua so tumbling: dong dung mau thu STATS_WINDOW_SAMPLES, aggregate giu den cua so sau, snapshot la cua so dang mo
+static void test_window_rollover(void) {
+    char json[512];
+    uint8_t r = 0;
+
+    TEST_ASSERT_EQUAL(0, sensor_stats_format_json(&stats, json, sizeof(json)));
+    for (uint16_t i = 0; i < STATS_WINDOW_SAMPLES; i++) {
+        sensor_sample_t s = sample(2500 + i * 10, 6000 - i * 10);
+        r = sensor_stats_feed(&stats, &s, i * 5);
+        if (i + 1 < STATS_WINDOW_SAMPLES) TEST_ASSERT_EQUAL(0, r & STATS_WINDOW);
+    }
+    TEST_ASSERT_EQUAL(STATS_WINDOW, r & STATS_WINDOW);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.temperature.n);
+    TEST_ASSERT_EQUAL_UINT16(STATS_WINDOW_SAMPLES, stats.tempAgg.count);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 25.0f, stats.tempAgg.min);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 26.1f, stats.tempAgg.max);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 25.55f, stats.tempAgg.mean);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 58.9f, stats.humiAgg.min);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 60.0f, stats.humiAgg.max);
+
+    size_t n = sensor_stats_format_json(&stats, json, sizeof(json));
+    TEST_ASSERT_EQUAL(strlen(json), n);
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"temperature_min\":25.00,\"temperature_max\":26.10,\"temperature_mean\":25.55,"));
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"humidity_min\":58.90,\"humidity_max\":60.00,"));
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"window\":12}"));
+    TEST_ASSERT_EQUAL(0, sensor_stats_format_json(&stats, json, n));
+
+    // mau dau cua cua so moi: min/max lay lai tu dau, aggregate cu chua bi ghi de
+    sensor_sample_t s = sample(3000, 5000);
+    sensor_stats_feed(&stats, &s, 100);
+    stats_aggregate_t open;
+    stats_channel_snapshot(&stats.temperature, &open);
+    TEST_ASSERT_EQUAL_UINT16(1, open.count);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 30.0f, open.min);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 30.0f, open.max);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.0f, open.stddev);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 26.1f, stats.tempAgg.max);
+}
+
+// Microbenchmark tren host, chi in ket qua. So voi giu cua so roi tinh lai hai lan duyet:
+// feed lam them EWMA + deadband moi mau, cai loi la khong can buffer cua so (vua RTC_DATA_ATTR)
+static void test_bench(void) {
+    const uint32_t n = 1u << 20;
+    volatile uint32_t sink = 0;
+    char msg[128];
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++) {
+        sensor_sample_t s = sample(2500 + (i & 63), 6000 - (i & 127));
+        sink += sensor_stats_feed(&stats, &s, i * 5);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double feed = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+
+    int32_t window[2][STATS_WINDOW_SAMPLES];
+    double mean, stddev;
+    t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++) {
+        uint16_t k = i % STATS_WINDOW_SAMPLES;
+        window[0][k] = 2500 + (i & 63);
+        window[1][k] = 6000 - (i & 127);
+        if (k == STATS_WINDOW_SAMPLES - 1) {
+            ref_stats(window[0], STATS_WINDOW_SAMPLES, &mean, &stddev);
+            sink += (uint32_t)stddev;
+            ref_stats(window[1], STATS_WINDOW_SAMPLES, &mean, &stddev);
+            sink += (uint32_t)stddev;
+        }
+    }
+    t1 = std::chrono::steady_clock::now();
+    double twoPass = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+
+    snprintf(msg, sizeof(msg), "sensor_stats_feed %.1f ns/sample, buffered two-pass %.1f ns/sample",
+             feed, twoPass);
+    TEST_MESSAGE(msg);
+    (void)sink;
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_welford_matches_two_pass);
+    RUN_TEST(test_ewma);
+    RUN_TEST(test_deadband);
+    RUN_TEST(test_max_silence);
+    RUN_TEST(test_window_rollover);
+    RUN_TEST(test_bench);
+    return UNITY_END();
+}
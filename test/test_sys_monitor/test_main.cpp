@@ -0,0 +1,170 @@
+#include <unity.h>
+#include "../../src/sys_monitor.cpp"
+
+bool console_register(const console_cmd_t *cmd) { return true; }
+void console_prompt() {}
+
+static sysmon_report_t prev, cur;
+
+static void add_task(sysmon_report_t *r, const char *name, uint32_t number, uint32_t runtime,
+                     uint32_t stack_free) {
+    sysmon_task_t &t = r->tasks[r->task_count++];
+    strncpy(t.name, name, SYSMON_NAME_LEN - 1);
+    t.number = number;
+    t.runtime = runtime;
+    t.stack_free = stack_free;
+}
+
+void setUp(void) {
+    memset(&prev, 0, sizeof(prev));
+    memset(&cur, 0, sizeof(cur));
+}
+
+void tearDown(void) {}
+
+// 2 core, chu ky 1000 tick -> tong 2000 tick CPU
+static void test_aggregate_deltas(void) {
+    add_task(&prev, "IDLE0", 1, 5000, 900);
+    add_task(&prev, "IDLE1", 2, 7000, 900);
+    add_task(&prev, "Sensor", 5, 300, 1200);
+
+    add_task(&cur, "Sensor", 5, 500, 1200);     // thu tu khac lan truoc
+    add_task(&cur, "IDLE0", 1, 5900, 900);
+    add_task(&cur, "IDLE1", 2, 7700, 900);
+    sys_monitor_aggregate(&cur, &prev, 1000, 2);
+
+    TEST_ASSERT_EQUAL_UINT16(100, cur.tasks[0].cpu_permille);
+    TEST_ASSERT_EQUAL_UINT16(450, cur.tasks[1].cpu_permille);
+    TEST_ASSERT_EQUAL_UINT16(350, cur.tasks[2].cpu_permille);
+    TEST_ASSERT_EQUAL_UINT16(800, cur.idle_permille);
+}
+
+static void test_aggregate_new_task_and_first_sample(void) {
+    add_task(&prev, "IDLE0", 1, 100, 900);
+    add_task(&cur, "IDLE0", 1, 600, 900);
+    add_task(&cur, "Fresh", 9, 250, 400);       // chua co o lan truoc -> tinh tu 0
+    sys_monitor_aggregate(&cur, &prev, 1000, 1);
+    TEST_ASSERT_EQUAL_UINT16(500, cur.tasks[0].cpu_permille);
+    TEST_ASSERT_EQUAL_UINT16(250, cur.tasks[1].cpu_permille);
+
+    // lan dau: prev = NULL
+    sys_monitor_aggregate(&cur, NULL, 2000, 2);
+    TEST_ASSERT_EQUAL_UINT16(150, cur.tasks[0].cpu_permille);
+    TEST_ASSERT_EQUAL_UINT16(150, cur.idle_permille);
+}
+
+static void test_aggregate_clamps_and_zero_capacity(void) {
+    add_task(&prev, "IDLE0", 1, UINT32_MAX - 99, 900);
+    add_task(&cur, "IDLE0", 1, 400, 900);       // runtime counter tran 32 bit: delta 500
+    add_task(&cur, "Busy", 3, 5000, 900);       // vuot capacity -> kep 1000
+    sys_monitor_aggregate(&cur, &prev, 1000, 1);
+    TEST_ASSERT_EQUAL_UINT16(500, cur.tasks[0].cpu_permille);
+    TEST_ASSERT_EQUAL_UINT16(1000, cur.tasks[1].cpu_permille);
+
+    sys_monitor_aggregate(&cur, &prev, 0, 2);
+    TEST_ASSERT_EQUAL_UINT16(0, cur.tasks[0].cpu_permille);
+    TEST_ASSERT_EQUAL_UINT16(0, cur.idle_permille);
+}
+
+static void test_format_json(void) {
+    char json[256];
+    cur.heap_free = 201234;
+    cur.heap_min_free = 150000;
+    cur.heap_largest = 110592;
+    cur.idle_permille = 876;
+    add_task(&cur, "loopTask", 1, 0, 5000);
+    add_task(&cur, "DLogDrain", 2, 0, 420);
+    add_task(&cur, "IDLE0", 3, 0, 900);
+    size_t n = sys_monitor_format_json(&cur, json, sizeof(json));
+    TEST_ASSERT_EQUAL_STRING("{\"heap_free\":201234,\"heap_min\":150000,\"heap_blk\":110592,\"cpu_idle\":87,"
+                             "\"tasks\":3,\"stack_min\":420,\"stack_min_task\":\"DLogDrain\"}", json);
+    TEST_ASSERT_EQUAL(strlen(json), n);
+
+    // vua khit can them '\0'
+    TEST_ASSERT_EQUAL(0, sys_monitor_format_json(&cur, json, n));
+    TEST_ASSERT_EQUAL(n, sys_monitor_format_json(&cur, json, n + 1));
+}
+
+static void test_format_json_without_tasks(void) {
+    char json[160];
+    TEST_ASSERT_GREATER_THAN(0, sys_monitor_format_json(&cur, json, sizeof(json)));
+    TEST_ASSERT_TRUE(strstr(json, "\"tasks\":0,\"stack_min\":0,\"stack_min_task\":\"\"}") != NULL);
+}
+
+static void set_state(uint32_t total, uint32_t idleRt, uint32_t loopRt) {
+    static char idle[] = "IDLE0", loop[] = "loopTask";
+    sim::systemState = {
+        { NULL, idle, 1, eReady, 0, 0, idleRt, NULL, 600, 0 },
+        { NULL, loop, 2, eRunning, 1, 1, loopRt, NULL, 3000, tskNO_AFFINITY },
+    };
+    sim::totalRuntime = total;
+}
+
+// Lay mau 2 lan qua API FreeRTOS gia: lan 2 tinh theo delta so voi lan 1
+static void test_sample_now(void) {
+    sysmon_report_t r;
+    haveReport = false;
+    lastTotalRuntime = 0;
+    TEST_ASSERT_FALSE(sys_monitor_get(&r));
+
+    set_state(1000, 800, 200);
+    sys_monitor_sample_now();
+    set_state(3000, 1400, 1600);
+    sys_monitor_sample_now();
+    TEST_ASSERT_TRUE(sys_monitor_get(&r));
+    TEST_ASSERT_EQUAL(2, r.task_count);
+    TEST_ASSERT_EQUAL_UINT16(150, r.idle_permille);     // 600 / (2000 * 2 core)
+    TEST_ASSERT_EQUAL_UINT16(350, r.tasks[1].cpu_permille);
+    TEST_ASSERT_EQUAL(-1, r.tasks[1].core);
+    TEST_ASSERT_EQUAL_UINT32(150000, r.heap_min_free);
+
+    // bang day hon SYSMON_MAX_TASKS -> chi bao so task
+    sim::systemState.resize(SYSMON_MAX_TASKS + 1, sim::systemState[0]);
+    sys_monitor_sample_now();
+    TEST_ASSERT_TRUE(sys_monitor_get(&r));
+    TEST_ASSERT_EQUAL(0, r.task_count);
+    TEST_ASSERT_EQUAL(SYSMON_MAX_TASKS + 1, r.tasks_truncated);
+    sim::systemState.clear();
+}
+
+// Reader chi doc slot da publish: slot writer dang dung (rac) khong lot ra ngoai,
+// slot bi ghi do (seq le) khong duoc publish
+static void test_get_reads_published_slot(void) {
+    sysmon_report_t r;
+    haveReport = false;
+    lastTotalRuntime = 0;
+    set_state(1000, 800, 200);
+    sys_monitor_sample_now();
+    set_state(3000, 1400, 1600);
+    sys_monitor_sample_now();
+
+    uint8_t idx = published;
+    TEST_ASSERT_EQUAL_UINT32(0, slots[idx].seq.load() & 1);
+    memset(&slots[idx ^ 1].report, 0xFF, sizeof(sysmon_report_t));
+    slots[idx ^ 1].seq.fetch_add(1);
+    TEST_ASSERT_TRUE(sys_monitor_get(&r));
+    TEST_ASSERT_EQUAL(2, r.task_count);
+    TEST_ASSERT_EQUAL_UINT16(150, r.idle_permille);
+    slots[idx ^ 1].seq.fetch_add(1);
+
+    // lan lay mau sau ghi vao slot kia roi moi doi index
+    set_state(5000, 2000, 3000);
+    sys_monitor_sample_now();
+    TEST_ASSERT_EQUAL(idx ^ 1, published);
+    TEST_ASSERT_TRUE(sys_monitor_get(&r));
+    TEST_ASSERT_EQUAL(2, r.task_count);
+    TEST_ASSERT_EQUAL_UINT16(150, r.idle_permille);     // 600 / (2000 * 2 core)
+    sim::systemState.clear();
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_aggregate_deltas);
+    RUN_TEST(test_aggregate_new_task_and_first_sample);
+    RUN_TEST(test_aggregate_clamps_and_zero_capacity);
+    RUN_TEST(test_format_json);
+    RUN_TEST(test_format_json_without_tasks);
+    RUN_TEST(test_sample_now);
+    RUN_TEST(test_get_reads_published_slot);
+    return UNITY_END();
+}